@@ -0,0 +1,200 @@
+/**
+ * vim: set ts=4 sw=4 tw=99 noet :
+ * ======================================================
+ * Metamod:Source Tickrate
+ * Written by Wend4r (Vladimir Ezhikov).
+ * ======================================================
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Compares the multi-pattern scanner with per-signature scans.
+// Usage: tickrate_signature_scanner_benchmark [<image, e.g. a captured libengine2.so>] [<signature>...]
+
+#include <tickrate/signature_scanner.hpp>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+namespace
+{
+	// "linuxsteamrt64" engine2 signatures of the gamedata.
+	const char *s_pszDefaultSignatures[] =
+	{
+		"80 BF ? ? ? ? ? 66 0F EF C0 F3 0F 2A 87", // CNetworkGameClient::ComputeNextRenderTime
+		"55 66 0F 28 E1", // CEngineServiceMgr::SleepAfterMainLoop
+		"55 48 89 E5 41 55 41 54 53 48 89 FB 48 83 EC 18 F3 0F 10 BF", // CLoopTypeClientServer::UnkSubClientSimulateTick2
+		"55 48 89 E5 41 57 41 56 49 89 FE 41 55 41 54 49 89 F4 53 48 83 EC 28", // CServerSideClient::ProcessMove
+	};
+
+	bool ReadImage(const char *pszFilename, std::vector<uint8_t> &vecOutput)
+	{
+		FILE *pFile = fopen(pszFilename, "rb");
+
+		if(!pFile)
+		{
+			return false;
+		}
+
+		fseek(pFile, 0, SEEK_END);
+
+		long nSize = ftell(pFile);
+
+		fseek(pFile, 0, SEEK_SET);
+
+		vecOutput.resize(nSize > 0 ? (size_t)nSize : 0);
+
+		bool bResult = fread(vecOutput.data(), 1, vecOutput.size(), pFile) == vecOutput.size();
+
+		fclose(pFile);
+
+		return bResult;
+	}
+
+	// Code-like bytes with the patterns planted close to the end.
+	void MakeImage(const Tickrate::SignatureScanner &aScanner, size_t nSize, std::vector<uint8_t> &vecOutput)
+	{
+		const uint8_t aFrequent[] = {0x00, 0xFF, 0x48, 0x89, 0x8B, 0x0F, 0xE8, 0x24, 0x4C, 0x8D, 0x41, 0x83, 0x55, 0xE5, 0x66};
+
+		std::mt19937 aRandom(128);
+
+		vecOutput.resize(nSize);
+
+		for(auto &nByte : vecOutput)
+		{
+			uint32_t nValue = aRandom();
+
+			nByte = (nValue & 1) ? aFrequent[(nValue >> 1) % sizeof(aFrequent)] : (uint8_t)(nValue >> 8);
+		}
+
+		size_t nOffset = nSize - nSize / 10;
+
+		for(size_t n = 0; n < aScanner.GetCount(); n++)
+		{
+			const auto &aPattern = aScanner.GetPattern((int)n);
+
+			for(size_t i = 0; i < aPattern.m_vecBytes.size(); i++)
+			{
+				if(aPattern.m_vecMask[i])
+				{
+					vecOutput[nOffset + i] = aPattern.m_vecBytes[i];
+				}
+			}
+
+			nOffset += nSize / 100;
+		}
+	}
+
+	template<class T>
+	double Measure(int nRuns, T fnRun)
+	{
+		double dblBest = 1e100;
+
+		for(int n = 0; n < nRuns; n++)
+		{
+			auto aStart = std::chrono::steady_clock::now();
+
+			fnRun();
+
+			double dblElapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - aStart).count();
+
+			if(dblElapsed < dblBest)
+			{
+				dblBest = dblElapsed;
+			}
+		}
+
+		return dblBest;
+	}
+};
+
+int main(int argc, char *argv[])
+{
+	Tickrate::SignatureScanner aScanner;
+
+	for(int n = 2; n < argc; n++)
+	{
+		if(aScanner.Add(argv[n]) == -1)
+		{
+			fprintf(stderr, "Invalid signature: \"%s\"\n", argv[n]);
+
+			return EXIT_FAILURE;
+		}
+	}
+
+	if(!aScanner.GetCount())
+	{
+		for(const char *pszSignature : s_pszDefaultSignatures)
+		{
+			aScanner.Add(pszSignature);
+		}
+	}
+
+	std::vector<uint8_t> vecImage;
+
+	if(argc > 1)
+	{
+		if(!ReadImage(argv[1], vecImage))
+		{
+			fprintf(stderr, "Failed to read \"%s\"\n", argv[1]);
+
+			return EXIT_FAILURE;
+		}
+	}
+	else
+	{
+		MakeImage(aScanner, 64 << 20, vecImage);
+	}
+
+	const uint8_t *pBegin = vecImage.data();
+
+	size_t nSize = vecImage.size();
+
+	const int nRuns = 5;
+
+	std::vector<const uint8_t *> vecSingle(aScanner.GetCount()), vecMulti;
+
+	double dblSingle = Measure(nRuns, [&]()
+	{
+		for(size_t n = 0; n < aScanner.GetCount(); n++)
+		{
+			vecSingle[n] = Tickrate::SignatureScanner::ScanSingle(aScanner.GetPattern((int)n), pBegin, nSize);
+		}
+	});
+
+	double dblMulti = Measure(nRuns, [&]()
+	{
+		aScanner.Scan(pBegin, nSize, vecMulti);
+	});
+
+	bool bMatch = vecSingle == vecMulti;
+
+	printf("Image: %zu bytes, %zu signatures\n", nSize, aScanner.GetCount());
+
+	for(size_t n = 0; n < aScanner.GetCount(); n++)
+	{
+		printf("\t#%zu: %s\n", n, vecMulti[n] ? "found" : "not found");
+	}
+
+	printf("Per-signature: %.3f ms\n", dblSingle);
+	printf("Multi-pattern: %.3f ms (x%.2f)\n", dblMulti, dblSingle / dblMulti);
+	printf("Results %s\n", bMatch ? "match" : "DIFFER");
+
+	return bMatch ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,295 @@
+/**
+ * vim: set ts=4 sw=4 tw=99 noet :
+ * ======================================================
+ * Metamod:Source Tickrate
+ * Written by Wend4r (Vladimir Ezhikov).
+ * ======================================================
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Compares the string xref index with a per-string pass over the code.
+// Usage: tickrate_string_xref_benchmark <an ELF module image, e.g. libengine2.so> [<string>...]
+
+#include <tickrate/string_xref.hpp>
+
+#include <elf.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace
+{
+	// "linuxsteamrt64" used strings of the gamedata.
+	const char *s_pszDefaultStrings[] =
+	{
+		"%g: FilterTime took target %g as time base instead of actual %g, diff %g\n",
+		"CQ disabled, re-syncing usercmd and simulation clock remainders\n",
+		"CQ enabled, using client-controlled JIT async send mode\n",
+		"%5.2f %5.2f %5.2f %7i %5i %7.2f %7i",
+	};
+
+	// Maps PT_LOAD segments of a file as the loader would, without relocations.
+	bool LoadImage(const char *pszFilename, std::vector<uint8_t> &vecImage, Tickrate::ModuleIdentity &aOutput)
+	{
+		FILE *pFile = fopen(pszFilename, "rb");
+
+		if(!pFile)
+		{
+			return false;
+		}
+
+		std::vector<uint8_t> vecFile;
+
+		uint8_t sBuffer[65536];
+
+		size_t nRead;
+
+		while((nRead = fread(sBuffer, 1, sizeof(sBuffer), pFile)) > 0)
+		{
+			vecFile.insert(vecFile.end(), sBuffer, sBuffer + nRead);
+		}
+
+		fclose(pFile);
+
+		if(vecFile.size() < sizeof(Elf64_Ehdr) || memcmp(vecFile.data(), ELFMAG, SELFMAG) || vecFile[EI_CLASS] != ELFCLASS64)
+		{
+			return false;
+		}
+
+		const auto *pHeader = reinterpret_cast<const Elf64_Ehdr *>(vecFile.data());
+		const auto *pProgramHeaders = reinterpret_cast<const Elf64_Phdr *>(vecFile.data() + pHeader->e_phoff);
+
+		uint64_t nImageSize = 0;
+
+		for(int n = 0; n < pHeader->e_phnum; n++)
+		{
+			if(pProgramHeaders[n].p_type == PT_LOAD)
+			{
+				nImageSize = std::max<uint64_t>(nImageSize, pProgramHeaders[n].p_vaddr + pProgramHeaders[n].p_memsz);
+			}
+		}
+
+		vecImage.assign((size_t)nImageSize, 0);
+
+		uintptr_t nBase = reinterpret_cast<uintptr_t>(vecImage.data());
+
+		aOutput = {};
+		aOutput.m_nBase = nBase;
+		aOutput.m_nSize = vecImage.size();
+
+		for(int n = 0; n < pHeader->e_phnum; n++)
+		{
+			const auto &aProgramHeader = pProgramHeaders[n];
+
+			if(aProgramHeader.p_type == PT_LOAD && aOutput.m_nSegmentCount < TICKRATE_MODULE_IDENTITY_MAX_SEGMENTS)
+			{
+				memcpy(&vecImage[aProgramHeader.p_vaddr], &vecFile[aProgramHeader.p_offset], aProgramHeader.p_filesz);
+				aOutput.m_aSegments[aOutput.m_nSegmentCount++] = {nBase + aProgramHeader.p_vaddr, aProgramHeader.p_memsz, (aProgramHeader.p_flags & PF_X) != 0, (aProgramHeader.p_flags & PF_W) != 0};
+			}
+			else if(aProgramHeader.p_type == PT_GNU_EH_FRAME)
+			{
+				aOutput.m_nUnwindTable = nBase + aProgramHeader.p_vaddr;
+				aOutput.m_nUnwindTableSize = aProgramHeader.p_memsz;
+			}
+		}
+
+		return true;
+	}
+
+	// Referenced printable strings of the read-only data, to query by when none are given.
+	void SampleStrings(const Tickrate::ModuleIdentity &aModule, const Tickrate::StringXref &aXref, size_t nMaxCount, std::vector<std::string> &vecOutput)
+	{
+		std::vector<const uint8_t *> vecReferences;
+
+		for(int n = 0; n < aModule.m_nSegmentCount && vecOutput.size() < nMaxCount; n++)
+		{
+			const auto &aSegment = aModule.m_aSegments[n];
+
+			if(aSegment.m_bWritable)
+			{
+				continue;
+			}
+
+			const char *pszBegin = reinterpret_cast<const char *>(aSegment.m_nBase), 
+			           *pszEnd = pszBegin + aSegment.m_nSize;
+
+			for(const char *psz = pszBegin + 1; psz < pszEnd && vecOutput.size() < nMaxCount; psz++)
+			{
+				if(psz[-1] != '\0')
+				{
+					continue;
+				}
+
+				const char *pszAt = psz;
+
+				while(pszAt < pszEnd && *pszAt >= 0x20 && *pszAt < 0x7F)
+				{
+					pszAt++;
+				}
+
+				if(pszAt < pszEnd && *pszAt == '\0' && pszAt - psz >= 24 && aXref.FindReferences(reinterpret_cast<const uint8_t *>(psz), vecReferences))
+				{
+					vecOutput.emplace_back(psz, pszAt);
+				}
+
+				psz = pszAt;
+			}
+		}
+	}
+
+	// A reference: one pass over the code per string.
+	const uint8_t *FindFunctionNaive(const Tickrate::ModuleIdentity &aModule, const Tickrate::StringXref &aXref, const char *pszString)
+	{
+		const uint8_t *pString = aXref.FindString(pszString);
+
+		if(!pString)
+		{
+			return nullptr;
+		}
+
+		for(int n = 0; n < aModule.m_nSegmentCount; n++)
+		{
+			const auto &aSegment = aModule.m_aSegments[n];
+
+			if(!aSegment.m_bExecutable)
+			{
+				continue;
+			}
+
+			const uint8_t *pBegin = reinterpret_cast<const uint8_t *>(aSegment.m_nBase);
+
+			for(size_t i = 1; i + 6 <= aSegment.m_nSize; i++)
+			{
+				if(pBegin[i] != 0x8D || (pBegin[i - 1] & 0xF8) != 0x48 || (pBegin[i + 1] & 0xC7) != 0x05)
+				{
+					continue;
+				}
+
+				int32_t nDisplacement;
+
+				memcpy(&nDisplacement, &pBegin[i + 2], sizeof(nDisplacement));
+
+				if(&pBegin[i + 6] + nDisplacement == pString)
+				{
+					return aXref.FindFunctionStart(&pBegin[i - 1]);
+				}
+			}
+		}
+
+		return nullptr;
+	}
+
+	double GetMilliseconds(std::chrono::steady_clock::time_point aStart)
+	{
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - aStart).count();
+	}
+};
+
+int main(int argc, char *argv[])
+{
+	if(argc < 2)
+	{
+		fprintf(stderr, "Usage: %s <ELF module image> [<string>...]\n", argv[0]);
+
+		return EXIT_FAILURE;
+	}
+
+	std::vector<uint8_t> vecImage;
+
+	Tickrate::ModuleIdentity aModule;
+
+	if(!LoadImage(argv[1], vecImage, aModule))
+	{
+		fprintf(stderr, "Failed to load \"%s\"\n", argv[1]);
+
+		return EXIT_FAILURE;
+	}
+
+	std::vector<std::string> vecStrings;
+
+	for(int i = 2; i < argc; i++)
+	{
+		vecStrings.emplace_back(argv[i]);
+	}
+
+	Tickrate::StringXref aXref;
+
+	auto aStart = std::chrono::steady_clock::now();
+
+	if(!aXref.Build(aModule))
+	{
+		fprintf(stderr, "Failed to build the index\n");
+
+		return EXIT_FAILURE;
+	}
+
+	double dblBuild = GetMilliseconds(aStart);
+
+	if(vecStrings.empty())
+	{
+		for(const char *pszString : s_pszDefaultStrings)
+		{
+			vecStrings.emplace_back(pszString);
+		}
+
+		SampleStrings(aModule, aXref, 64, vecStrings);
+	}
+
+	aStart = std::chrono::steady_clock::now();
+
+	std::vector<const uint8_t *> vecFunctions;
+
+	for(const auto &sString : vecStrings)
+	{
+		const char *pszString = sString.c_str();
+
+		vecFunctions.push_back(aXref.FindFunction(&pszString, 1));
+	}
+
+	double dblIndexed = GetMilliseconds(aStart);
+
+	aStart = std::chrono::steady_clock::now();
+
+	size_t nFound = 0, nMismatches = 0;
+
+	for(size_t n = 0; n < vecStrings.size(); n++)
+	{
+		const uint8_t *pFunction = FindFunctionNaive(aModule, aXref, vecStrings[n].c_str());
+
+		if(vecFunctions[n])
+		{
+			nFound++;
+
+			// The naive one takes a first reference only.
+			if(pFunction != vecFunctions[n])
+			{
+				nMismatches++;
+			}
+		}
+	}
+
+	double dblNaive = GetMilliseconds(aStart);
+
+	printf("Image: %zu KiB, %zu references, %zu functions\n", vecImage.size() / 1024, aXref.GetReferenceCount(), aXref.GetFunctionCount());
+	printf("Strings: %zu, found functions: %zu (%zu differ from a first reference)\n", vecStrings.size(), nFound, nMismatches);
+	printf("Index: %.3f ms to build + %.3f ms to query\n", dblBuild, dblIndexed);
+	printf("Naive: %.3f ms\n", dblNaive);
+
+	return EXIT_SUCCESS;
+}
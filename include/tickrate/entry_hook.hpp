@@ -0,0 +1,69 @@
+/**
+ * vim: set ts=4 sw=4 tw=99 noet :
+ * ======================================================
+ * Metamod:Source Tickrate
+ * Written by Wend4r (Vladimir Ezhikov).
+ * ======================================================
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef _INCLUDE_METAMOD_SOURCE_TICKRATE_ENTRY_HOOK_HPP_
+#	define _INCLUDE_METAMOD_SOURCE_TICKRATE_ENTRY_HOOK_HPP_
+
+#	pragma once
+
+#	include <tickrate/patch_manager.hpp>
+
+#	include <stddef.h>
+#	include <stdint.h>
+
+#	define TICKRATE_ENTRY_HOOK_JUMP_SIZE 5 // "jmp rel32".
+#	define TICKRATE_ENTRY_HOOK_MAX_PROLOGUE 16
+#	define TICKRATE_ENTRY_HOOK_STUB_SIZE 256
+
+namespace Tickrate
+{
+	/**
+	 * @brief Calls a callback on entry of a native function, then runs the function as is.
+	 * The prologue is replaced by a jump to a near stub: it keeps the argument registers around the callback,
+	 * runs the moved prologue and jumps back. The prologue must be of whole position-independent instructions,
+	 * it's compared to the expected bytes before.
+	**/
+	class EntryHook
+	{
+	public:
+		using Callback_t = void (*)(void *pContext);
+
+		EntryHook();
+		~EntryHook();
+
+	public:
+		// The mask is 0xFF to compare a byte, 0x00 for a wildcard, otherwise every byte is compared.
+		bool Install(void *pFunction, const uint8_t *pExpected, const uint8_t *pMask, size_t nPrologueSize, Callback_t pfnCallback, void *pContext);
+		void Remove(); // Main thread only, the hooked function must not be running.
+		bool IsInstalled() const;
+
+	protected:
+		// Returns a size of the stub code.
+		static size_t BuildStub(uint8_t *pStub, const uint8_t *pFunction, size_t nPrologueSize, Callback_t pfnCallback, void *pContext);
+		static void WriteJump(uint8_t *pFrom, const uint8_t *pTo);
+
+	private:
+		PatchManager m_aPatches; // Of the prologue and the stub memory.
+		uint8_t *m_pFunction;
+	}; // EntryHook
+}; // Tickrate
+
+#endif // _INCLUDE_METAMOD_SOURCE_TICKRATE_ENTRY_HOOK_HPP_
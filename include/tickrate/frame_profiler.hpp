@@ -0,0 +1,110 @@
+/**
+ * vim: set ts=4 sw=4 tw=99 noet :
+ * ======================================================
+ * Metamod:Source Tickrate
+ * Written by Wend4r (Vladimir Ezhikov).
+ * ======================================================
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef _INCLUDE_METAMOD_SOURCE_TICKRATE_FRAME_PROFILER_HPP_
+#	define _INCLUDE_METAMOD_SOURCE_TICKRATE_FRAME_PROFILER_HPP_
+
+#	pragma once
+
+#	include <stddef.h>
+#	include <stdint.h>
+
+#	include <atomic>
+#	include <vector>
+
+#	define TICKRATE_FRAME_PROFILER_SAMPLE_BITS 13 // 8192 frames, 64 seconds at 128 tick.
+#	define TICKRATE_FRAME_PROFILER_SAMPLE_COUNT (1 << TICKRATE_FRAME_PROFILER_SAMPLE_BITS)
+
+namespace Tickrate
+{
+	/**
+	 * @brief A per-frame timing ring of the frame boundary events.
+	 * Single producer (the main loop thread), lock-free readers.
+	**/
+	class FrameProfiler
+	{
+	public:
+		FrameProfiler();
+
+	public:
+		struct Sample_t
+		{
+			uint32_t m_nWallTime; // Microseconds between two frame boundaries.
+			uint32_t m_nComputeTime; // Microseconds of the engine frame computation.
+		};
+
+		struct Percentiles_t
+		{
+			uint32_t m_nP50;
+			uint32_t m_nP95;
+			uint32_t m_nP99;
+			uint32_t m_nMax;
+		};
+
+		struct Stats_t
+		{
+			int m_nSamples;
+			int m_nComputeSamples; // Frames with a known compute time.
+			uint32_t m_nBudget; // Microseconds of a tick, "1 / sv_tickrate".
+
+			Percentiles_t m_aWallTime;
+			Percentiles_t m_aComputeTime;
+
+			uint32_t m_nMeanJitter; // Mean of |wall time - budget|.
+			int m_nOverruns; // Frames whose wall time exceeds the budget with a tolerance.
+		};
+
+	public:
+		void Reset();
+
+		// Producer. Pass a negative compute time when it's unknown.
+		void OnFrameBoundary(double dblNow, double dblComputeTime);
+
+	public:
+		uint32_t GetFrameCount() const;
+
+		// Copies the last (up to nMaxCount) samples, oldest first. Returns a copied count.
+		int Collect(Sample_t *pOutput, int nMaxCount) const;
+
+		// Of a reader, kept to not allocate on each compute.
+		struct Buffers_t
+		{
+			std::vector<Sample_t> m_vecSamples;
+			std::vector<uint32_t> m_vecWallTimes;
+			std::vector<uint32_t> m_vecComputeTimes;
+		};
+
+		// Computes the stats of the last (up to nMaxCount) samples.
+		bool Compute(Stats_t &aOutput, double dblBudget, double dblOverrunTolerance, int nMaxCount = TICKRATE_FRAME_PROFILER_SAMPLE_COUNT) const;
+		bool Compute(Stats_t &aOutput, double dblBudget, double dblOverrunTolerance, int nMaxCount, Buffers_t &aBuffers) const;
+
+	public:
+		static void ComputePercentiles(uint32_t *pValues, int nCount, Percentiles_t &aOutput);
+
+	private:
+		double m_dblLastBoundary;
+
+		std::atomic<uint32_t> m_nHead;
+		Sample_t m_aSamples[TICKRATE_FRAME_PROFILER_SAMPLE_COUNT];
+	}; // FrameProfiler
+}; // Tickrate
+
+#endif // _INCLUDE_METAMOD_SOURCE_TICKRATE_FRAME_PROFILER_HPP_
@@ -0,0 +1,223 @@
+/**
+ * vim: set ts=4 sw=4 tw=99 noet :
+ * ======================================================
+ * Metamod:Source Tickrate
+ * Written by Wend4r (Vladimir Ezhikov).
+ * ======================================================
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef _INCLUDE_METAMOD_SOURCE_TICKRATE_GAMEDATA_BLOB_HPP_
+#	define _INCLUDE_METAMOD_SOURCE_TICKRATE_GAMEDATA_BLOB_HPP_
+
+#	pragma once
+
+#	include <stddef.h>
+#	include <stdint.h>
+
+#	define TICKRATE_GAMEDATA_BLOB_MAGIC 0x44475254 // "TRGD"
+#	define TICKRATE_GAMEDATA_BLOB_VERSION 2
+#	define TICKRATE_GAMEDATA_BLOB_PLATFORM_LENGTH 32
+#	define TICKRATE_GAMEDATA_BLOB_INVALID_INDEX UINT32_MAX
+
+#	ifdef _WIN32
+#		define TICKRATE_GAMEDATA_BLOB_PLATFORM "win64"
+#	else
+#		define TICKRATE_GAMEDATA_BLOB_PLATFORM "linuxsteamrt64"
+#	endif
+
+namespace Tickrate
+{
+	/**
+	 * @brief A precompiled gamedata: the "*.games.json" trees of one platform,
+	 * with interned strings. Mapped read-only and read in place.
+	 * The signatures (parsed to bytes and masks), addresses, offsets and prologues
+	 * of a source are indexed, the tree is only for a source out of the index.
+	 * 
+	 * Layout: Header_t, Source_t[], Node_t[] (children of a node are contiguous),
+	 * Signature_t[], Address_t[], Offset_t[], Prologue_t[], pattern bytes, strings.
+	**/
+	class GameDataBlob
+	{
+	public:
+		GameDataBlob();
+		~GameDataBlob();
+
+	public:
+		enum NodeType_t : uint32_t
+		{
+			NODE_NULL = 0,
+			NODE_BOOL,
+			NODE_INT,
+			NODE_DOUBLE,
+			NODE_STRING,
+			NODE_ARRAY,
+			NODE_TABLE,
+		};
+
+		struct Header_t
+		{
+			uint32_t m_nMagic;
+			uint32_t m_nVersion;
+			char m_sPlatform[TICKRATE_GAMEDATA_BLOB_PLATFORM_LENGTH];
+
+			uint32_t m_nSourceCount;
+			uint32_t m_nSourcesOffset;
+			uint32_t m_nNodeCount;
+			uint32_t m_nNodesOffset;
+			uint32_t m_nSignatureCount;
+			uint32_t m_nSignaturesOffset;
+			uint32_t m_nAddressCount;
+			uint32_t m_nAddressesOffset;
+			uint32_t m_nOffsetCount;
+			uint32_t m_nOffsetsOffset;
+			uint32_t m_nPrologueCount;
+			uint32_t m_nProloguesOffset;
+			uint32_t m_nBytesOffset;
+			uint32_t m_nBytesSize;
+			uint32_t m_nStringsOffset;
+			uint32_t m_nStringsSize;
+		};
+
+		enum SourceFlags_t : uint32_t
+		{
+			SOURCE_NONE = 0,
+			SOURCE_INDEXED = (1 << 0), // Every member of the source is in the index.
+		};
+
+		struct Range_t
+		{
+			uint32_t m_nFirst;
+			uint32_t m_nCount;
+		};
+
+		// A compiled config file.
+		struct Source_t
+		{
+			uint32_t m_nName; // A string of the filename, like "tick.games.json".
+			uint32_t m_nRoot; // A node.
+			uint32_t m_nFlags;
+			uint32_t m_nReserved;
+
+			Range_t m_aSignatures;
+			Range_t m_aAddresses;
+			Range_t m_aOffsets;
+			Range_t m_aPrologues;
+
+			uint64_t m_nSize; // Of the source file, to check on stale.
+			int64_t m_nModificationTime;
+			uint64_t m_nHash; // FNV-1a of the source file.
+		};
+
+		struct Node_t
+		{
+			uint32_t m_nType;
+			uint32_t m_nName; // A string of the member name, otherwise the invalid index.
+
+			uint32_t m_nFirst; // A first child node, or a string of the value.
+			uint32_t m_nCount; // Children.
+
+			union
+			{
+				int64_t m_nInt;
+				double m_dblDouble;
+			};
+		};
+
+		// Of the platform.
+		struct Signature_t
+		{
+			uint32_t m_nName;
+			uint32_t m_nLibrary;
+			uint32_t m_nBytes; // Of the pattern bytes: the bytes, then the mask of the same length.
+			uint32_t m_nLength;
+		};
+
+		enum AddressAction_t : uint32_t
+		{
+			ADDRESS_OFFSET = 0,
+			ADDRESS_READ_OFFS32,
+
+			ADDRESS_ACTION_MAX
+		};
+
+		struct Address_t
+		{
+			uint32_t m_nName;
+			uint32_t m_nSignature; // A string of the name.
+			uint32_t m_nAction;
+			int32_t m_nValue;
+		};
+
+		struct Offset_t
+		{
+			uint32_t m_nName;
+			int32_t m_nValue;
+		};
+
+		struct Prologue_t
+		{
+			uint32_t m_nName; // Of the function.
+			uint32_t m_nBytes;
+			uint32_t m_nLength;
+		};
+
+	public:
+		bool Open(const char *pszFilename, const char *pszPlatform, char *error = nullptr, size_t maxlen = 0);
+		void Close();
+		bool IsOpen() const;
+
+		// Fresh when the source file is absent (deployed without) or the same.
+		static bool IsFresh(const Source_t &aSource, const char *pszSourceFile);
+
+		static uint64_t Hash(const void *pData, size_t nSize, uint64_t nHash = 0xCBF29CE484222325ull);
+
+	public:
+		int GetSourceCount() const;
+		const Source_t &GetSource(int iIndex) const;
+		int FindSource(const char *pszName) const; // Supports a trailing "*" wildcard.
+
+		const Node_t &GetNode(uint32_t nIndex) const;
+		const char *GetString(uint32_t nOffset) const;
+
+	public: // The index, ranges of a source are validated on open.
+		const Signature_t &GetSignature(uint32_t nIndex) const;
+		const Address_t &GetAddress(uint32_t nIndex) const;
+		const Offset_t &GetOffset(uint32_t nIndex) const;
+		const Prologue_t &GetPrologue(uint32_t nIndex) const;
+		const uint8_t *GetBytes(uint32_t nOffset) const;
+
+	private:
+		const uint8_t *m_pData;
+		size_t m_nSize;
+
+		const Header_t *m_pHeader;
+		const Source_t *m_pSources;
+		const Node_t *m_pNodes;
+		const Signature_t *m_pSignatures;
+		const Address_t *m_pAddresses;
+		const Offset_t *m_pOffsets;
+		const Prologue_t *m_pPrologues;
+		const uint8_t *m_pBytes;
+		const char *m_pStrings;
+
+#	ifdef _WIN32
+		void *m_hFile;
+		void *m_hMapping;
+#	endif
+	}; // GameDataBlob
+}; // Tickrate
+
+#endif // _INCLUDE_METAMOD_SOURCE_TICKRATE_GAMEDATA_BLOB_HPP_
@@ -0,0 +1,84 @@
+/**
+ * vim: set ts=4 sw=4 tw=99 noet :
+ * ======================================================
+ * Metamod:Source Tickrate
+ * Written by Wend4r (Vladimir Ezhikov).
+ * ======================================================
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef _INCLUDE_METAMOD_SOURCE_TICKRATE_GOVERNOR_HPP_
+#	define _INCLUDE_METAMOD_SOURCE_TICKRATE_GOVERNOR_HPP_
+
+#	pragma once
+
+#	include <tickrate/frame_profiler.hpp>
+
+#	include <vector>
+
+namespace Tickrate
+{
+	/**
+	 * @brief Steps the tickrate through a ladder by the measured frame time.
+	**/
+	class Governor
+	{
+	public:
+		Governor();
+
+	public:
+		struct Settings_t
+		{
+			std::vector<int> m_vecLadder; // Descending tickrates.
+
+			double m_dblWindow; // Seconds of frames to exceed the budget to step down.
+			double m_dblOverrunRatio; // p95 of frame time relative to the budget to step down.
+
+			double m_dblRecoverWindow; // Seconds of frames to stay under a higher budget to step up.
+			double m_dblRecoverRatio; // p95 of frame time relative to a higher budget to step up.
+		};
+
+		const Settings_t &GetSettings() const;
+		void SetSettings(const Settings_t &aSettings);
+
+	public:
+		void Reset();
+
+		// Returns a tickrate to change to, otherwise 0.
+		int Think(double dblNow, int nCurrent, int nCeiling, const FrameProfiler &aProfiler);
+
+		// Seconds of the profiler ring at a tickrate, the windows are clamped to.
+		static double GetMaxWindow(int nTickrate);
+
+	public:
+		int GetLower(int nCurrent) const;
+		int GetHigher(int nCurrent, int nCeiling) const;
+
+		int GetLastDecision() const;
+
+	public:
+		static uint32_t GetPercentile95(const FrameProfiler::Stats_t &aStats);
+
+	private:
+		Settings_t m_aSettings;
+
+		double m_dblNextThink;
+		int m_nLastDecision;
+
+		FrameProfiler::Buffers_t m_aBuffers;
+	}; // Governor
+}; // Tickrate
+
+#endif // _INCLUDE_METAMOD_SOURCE_TICKRATE_GOVERNOR_HPP_
@@ -0,0 +1,121 @@
+/**
+ * vim: set ts=4 sw=4 tw=99 noet :
+ * ======================================================
+ * Metamod:Source Tickrate
+ * Written by Wend4r (Vladimir Ezhikov).
+ * ======================================================
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef _INCLUDE_METAMOD_SOURCE_TICKRATE_HOST_ARBITER_HPP_
+#	define _INCLUDE_METAMOD_SOURCE_TICKRATE_HOST_ARBITER_HPP_
+
+#	pragma once
+
+#	include <stddef.h>
+#	include <stdint.h>
+
+#	define TICKRATE_HOST_ARBITER_SLOT_COUNT 64
+#	define TICKRATE_HOST_ARBITER_MAGIC 0x32525254 // "TRR2", a version of the layout.
+
+namespace Tickrate
+{
+	/**
+	 * @brief Instances of one host publish to seqlock slots of a shared memory segment,
+	 * and step their tickrates by turns while the host CPU usage is out of a budget.
+	 * An instance owns its slot by a random token, not a pid: PID namespaces of containers repeat them.
+	 * A slot of a crashed instance expires by its heartbeat. The main thread only.
+	**/
+	class HostArbiter
+	{
+	public:
+		HostArbiter();
+		~HostArbiter();
+
+	public:
+		struct Settings_t
+		{
+			double m_dblCpuBudget; // A part of the host CPU time to lower over.
+			double m_dblHysteresis; // Below the budget to raise.
+			double m_dblCooldown; // Seconds after a decision, for the host usage to settle.
+			double m_dblExpiry; // Seconds without a heartbeat to drop a slot.
+		};
+
+		const Settings_t &GetSettings() const;
+		void SetSettings(const Settings_t &aSettings);
+
+		enum InstanceFlags_t : uint32_t
+		{
+			INSTANCE_NONE = 0,
+			INSTANCE_CAN_LOWER = (1 << 0),
+			INSTANCE_CAN_RAISE = (1 << 1), // Lowered by the arbiter before.
+		};
+
+		struct Instance_t
+		{
+			uint64_t m_nToken; // Filled by the arbiter for itself.
+			int32_t m_nTickrate;
+			int32_t m_nHumans;
+			uint32_t m_nTickCost; // Microseconds, p95.
+			uint32_t m_nFlags;
+		};
+
+	public:
+		bool Open(const char *pszName, char *error = nullptr, size_t maxlen = 0);
+		void Close();
+		bool IsOpen() const;
+		int GetSlot() const;
+
+		bool ShouldThink(double dblNow) const;
+
+		// Publishes the instance, returns a step to take: -1 to lower, 1 to raise, otherwise 0.
+		int Think(double dblNow, const Instance_t &aSelf);
+
+	public:
+		// The live ones, itself included.
+		int Collect(Instance_t *pOutput, int nMaxCount) const;
+
+		double GetCpuUsage() const; // The last sampled, otherwise negative.
+
+	protected:
+		struct Slot_t;
+		struct Segment_t;
+
+		bool Claim();
+		bool Publish(const Instance_t &aSelf); // Reclaims a slot taken over while stalled.
+		bool Read(const Slot_t &aSlot, Instance_t &aOutput, int64_t &nHeartbeat) const;
+		bool IsExpired(const Slot_t &aSlot, int64_t nNow) const;
+		double SampleCpuUsage();
+
+		static int64_t Now(); // Nanoseconds of a monotonic clock, host-wide.
+		static uint64_t MakeToken(); // Random, nonzero.
+
+	private:
+		Segment_t *m_pSegment;
+		int m_iSlot;
+		uint64_t m_nToken;
+
+		Settings_t m_aSettings;
+
+		double m_dblNextThink;
+		double m_dblCooldownUntil;
+
+		uint64_t m_nLastCpuBusy;
+		uint64_t m_nLastCpuTotal;
+		double m_dblCpuUsage;
+	}; // HostArbiter
+}; // Tickrate
+
+#endif // _INCLUDE_METAMOD_SOURCE_TICKRATE_HOST_ARBITER_HPP_
@@ -0,0 +1,67 @@
+/**
+ * vim: set ts=4 sw=4 tw=99 noet :
+ * ======================================================
+ * Metamod:Source Tickrate
+ * Written by Wend4r (Vladimir Ezhikov).
+ * ======================================================
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef _INCLUDE_METAMOD_SOURCE_TICKRATE_MAP_PROFILES_HPP_
+#	define _INCLUDE_METAMOD_SOURCE_TICKRATE_MAP_PROFILES_HPP_
+
+#	pragma once
+
+#	include <tickrate/network_profile.hpp>
+
+#	include <string>
+#	include <vector>
+
+namespace Tickrate
+{
+	/**
+	 * @brief Tickrates (and client network settings) by a map, a workshop addon or a game mode.
+	**/
+	class MapProfiles
+	{
+	public:
+		struct Profile_t
+		{
+			// Wildcard ("*", "?") patterns, case insensitive. An empty one matches any.
+			std::string m_sMap;
+			std::string m_sWorkshop;
+			std::string m_sGameMode;
+
+			int m_nTickrate;
+
+			bool m_bHasNetwork; // Otherwise of the network tiers.
+			NetworkProfile::Tier_t m_aNetwork;
+		};
+
+		const std::vector<Profile_t> &GetProfiles() const;
+		void SetProfiles(const std::vector<Profile_t> &vecProfiles);
+
+	public:
+		// Returns the first matching profile, otherwise nullptr.
+		const Profile_t *Find(const char *pszMap, const char *pszWorkshop, const char *pszGameMode) const;
+
+		static bool Match(const char *pszPattern, const char *pszText);
+
+	private:
+		std::vector<Profile_t> m_vecProfiles; // In order of the config.
+	}; // MapProfiles
+}; // Tickrate
+
+#endif // _INCLUDE_METAMOD_SOURCE_TICKRATE_MAP_PROFILES_HPP_
@@ -0,0 +1,115 @@
+/**
+ * vim: set ts=4 sw=4 tw=99 noet :
+ * ======================================================
+ * Metamod:Source Tickrate
+ * Written by Wend4r (Vladimir Ezhikov).
+ * ======================================================
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef _INCLUDE_METAMOD_SOURCE_TICKRATE_MESSAGE_POOL_HPP_
+#	define _INCLUDE_METAMOD_SOURCE_TICKRATE_MESSAGE_POOL_HPP_
+
+#	pragma once
+
+#	include <networksystem/inetworkmessages.h>
+#	include <networksystem/netmessage.h>
+#	include <tier1/utlvector.h>
+
+namespace Tickrate
+{
+	/**
+	 * @brief Reuses allocated protobuf messages of a network message.
+	 * Messages are serialized while posting, so a released one is free to reuse.
+	**/
+	template<class T>
+	class MessagePool
+	{
+	public:
+		using Message_t = CNetMessagePB<T>;
+
+		MessagePool()
+		 :  m_pMessage(nullptr)
+		{
+		}
+
+		~MessagePool()
+		{
+			Destroy();
+		}
+
+	public:
+		void Init(INetworkMessageInternal *pMessage, int nPreallocate = 1)
+		{
+			if(m_pMessage != pMessage)
+			{
+				Destroy();
+			}
+
+			m_pMessage = pMessage;
+
+			while(m_vecFree.Count() < nPreallocate)
+			{
+				m_vecFree.AddToTail(pMessage->AllocateMessage()->template ToPB<T>());
+			}
+		}
+
+		void Destroy()
+		{
+			for(auto *pMessage : m_vecFree)
+			{
+				delete pMessage;
+			}
+
+			m_vecFree.Purge();
+			m_pMessage = nullptr;
+		}
+
+	public:
+		INetworkMessageInternal *GetMessage() const
+		{
+			return m_pMessage;
+		}
+
+		// Returns a clean message.
+		Message_t *Acquire()
+		{
+			if(m_vecFree.Count())
+			{
+				int iLast = m_vecFree.Count() - 1;
+
+				Message_t *pMessage = m_vecFree[iLast];
+
+				m_vecFree.FastRemove(iLast);
+
+				return pMessage;
+			}
+
+			return m_pMessage->AllocateMessage()->template ToPB<T>();
+		}
+
+		void Release(Message_t *pMessage)
+		{
+			pMessage->Clear();
+			m_vecFree.AddToTail(pMessage);
+		}
+
+	private:
+		INetworkMessageInternal *m_pMessage;
+		CUtlVector<Message_t *> m_vecFree;
+	}; // MessagePool
+}; // Tickrate
+
+#endif // _INCLUDE_METAMOD_SOURCE_TICKRATE_MESSAGE_POOL_HPP_
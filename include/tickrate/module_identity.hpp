@@ -0,0 +1,69 @@
+/**
+ * vim: set ts=4 sw=4 tw=99 noet :
+ * ======================================================
+ * Metamod:Source Tickrate
+ * Written by Wend4r (Vladimir Ezhikov).
+ * ======================================================
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef _INCLUDE_METAMOD_SOURCE_TICKRATE_MODULE_IDENTITY_HPP_
+#	define _INCLUDE_METAMOD_SOURCE_TICKRATE_MODULE_IDENTITY_HPP_
+
+#	pragma once
+
+#	include <stddef.h>
+#	include <stdint.h>
+
+#	define TICKRATE_MODULE_IDENTITY_MAX_LENGTH 64 // Hex of a build ID (up to 20 bytes of SHA-1) or of a PE stamp.
+#	define TICKRATE_MODULE_IDENTITY_MAX_SEGMENTS 16
+
+namespace Tickrate
+{
+	/**
+	 * @brief A loaded module range and its build identity.
+	 * Linux: "NT_GNU_BUILD_ID" note. Windows: "TimeDateStamp" and "SizeOfImage" of the PE header.
+	**/
+	struct ModuleIdentity
+	{
+		uintptr_t m_nBase = 0;
+		size_t m_nSize = 0;
+		char m_sBuildID[TICKRATE_MODULE_IDENTITY_MAX_LENGTH + 1] = {};
+
+		struct Segment_t
+		{
+			uintptr_t m_nBase;
+			size_t m_nSize;
+
+			bool m_bExecutable;
+			bool m_bWritable;
+		};
+
+		Segment_t m_aSegments[TICKRATE_MODULE_IDENTITY_MAX_SEGMENTS] = {};
+		int m_nSegmentCount = 0;
+
+		// Function bounds: ".eh_frame_hdr" on Linux, the exception directory (".pdata") on Windows.
+		uintptr_t m_nUnwindTable = 0;
+		size_t m_nUnwindTableSize = 0;
+
+		// Resolves by any address inside of the module.
+		bool Resolve(const void *pAddressInside);
+
+		bool IsValid() const;
+		bool Contains(const void *pAddress) const;
+	}; // ModuleIdentity
+}; // Tickrate
+
+#endif // _INCLUDE_METAMOD_SOURCE_TICKRATE_MODULE_IDENTITY_HPP_
@@ -0,0 +1,62 @@
+/**
+ * vim: set ts=4 sw=4 tw=99 noet :
+ * ======================================================
+ * Metamod:Source Tickrate
+ * Written by Wend4r (Vladimir Ezhikov).
+ * ======================================================
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef _INCLUDE_METAMOD_SOURCE_TICKRATE_NETWORK_PROFILE_HPP_
+#	define _INCLUDE_METAMOD_SOURCE_TICKRATE_NETWORK_PROFILE_HPP_
+
+#	pragma once
+
+#	include <vector>
+
+namespace Tickrate
+{
+	/**
+	 * @brief Client network settings by tickrate tiers.
+	**/
+	class NetworkProfile
+	{
+	public:
+		NetworkProfile();
+
+	public:
+		struct Tier_t
+		{
+			int m_nTickrate; // The lowest tickrate of the tier.
+
+			int m_nRate; // "rate", bytes per second.
+			int m_nUpdateRate; // "cl_updaterate", 0 is the tickrate.
+			float m_flInterpRatio; // "cl_interp_ratio".
+			float m_flInterp; // "cl_interp", 0 is the interp ratio of the tick interval.
+		};
+
+		const std::vector<Tier_t> &GetTiers() const;
+		void SetTiers(const std::vector<Tier_t> &vecTiers);
+
+	public:
+		// Finds the highest tier not above the tickrate (else the lowest) and derives the zero values.
+		bool Resolve(int nTickrate, Tier_t &aOutput) const;
+
+	private:
+		std::vector<Tier_t> m_vecTiers; // Ascending.
+	}; // NetworkProfile
+}; // Tickrate
+
+#endif // _INCLUDE_METAMOD_SOURCE_TICKRATE_NETWORK_PROFILE_HPP_
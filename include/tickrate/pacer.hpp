@@ -0,0 +1,88 @@
+/**
+ * vim: set ts=4 sw=4 tw=99 noet :
+ * ======================================================
+ * Metamod:Source Tickrate
+ * Written by Wend4r (Vladimir Ezhikov).
+ * ======================================================
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef _INCLUDE_METAMOD_SOURCE_TICKRATE_PACER_HPP_
+#	define _INCLUDE_METAMOD_SOURCE_TICKRATE_PACER_HPP_
+
+#	pragma once
+
+#	include <tickrate/frame_profiler.hpp>
+
+#	include <stddef.h>
+#	include <stdint.h>
+
+#	define TICKRATE_PACER_JITTER_BITS 12 // 4096 frames, 32 seconds at 128 tick.
+#	define TICKRATE_PACER_JITTER_COUNT (1 << TICKRATE_PACER_JITTER_BITS)
+
+namespace Tickrate
+{
+	/**
+	 * @brief Paces frame starts on a grid of the tick interval.
+	 * Sleeps until a calibrated margin before the deadline, then spins the rest.
+	 * The main thread only.
+	**/
+	class Pacer
+	{
+	public:
+		Pacer();
+
+	public:
+		struct Stats_t
+		{
+			int m_nFrames;
+			uint32_t m_nLateFrames; // Missed a whole interval, the grid is resynced.
+			uint32_t m_nOversleep; // Nanoseconds, the calibrated one.
+
+			double m_dblMeanJitter; // Nanoseconds of |frame start - deadline|.
+			FrameProfiler::Percentiles_t m_aJitter;
+		};
+
+	public:
+		void Reset();
+
+		void SetSpinBudget(uint32_t nMicroseconds);
+		uint32_t GetSpinBudget() const; // Microseconds.
+
+		// Returns at the next frame start, or false of an invalid interval without waiting.
+		bool Wait(double dblInterval);
+
+	public:
+		uint32_t GetFrameCount() const;
+		bool Compute(Stats_t &aOutput) const;
+
+	public:
+		static int64_t Now(); // Nanoseconds of a monotonic clock.
+
+	protected:
+		static void SleepUntil(int64_t nDeadline);
+
+	private:
+		int64_t m_nDeadline; // Of the next frame start, otherwise 0.
+		int64_t m_nSpinBudget;
+		int64_t m_nOversleep; // A moving average of the sleep overshoot.
+
+		uint32_t m_nLateFrames;
+		uint32_t m_nHead;
+		uint32_t m_aJitter[TICKRATE_PACER_JITTER_COUNT];
+	}; // Pacer
+}; // Tickrate
+
+#endif // _INCLUDE_METAMOD_SOURCE_TICKRATE_PACER_HPP_
@@ -0,0 +1,104 @@
+/**
+ * vim: set ts=4 sw=4 tw=99 noet :
+ * ======================================================
+ * Metamod:Source Tickrate
+ * Written by Wend4r (Vladimir Ezhikov).
+ * ======================================================
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef _INCLUDE_METAMOD_SOURCE_TICKRATE_PATCH_MANAGER_HPP_
+#	define _INCLUDE_METAMOD_SOURCE_TICKRATE_PATCH_MANAGER_HPP_
+
+#	pragma once
+
+#	include <stddef.h>
+#	include <stdint.h>
+
+#	include <vector>
+
+namespace Tickrate
+{
+	/**
+	 * @brief Write windows over the protected engine memory, grouped by pages.
+	 * Opening changes the protection once per run of pages, closing restores it,
+	 * so no page stays writable between changes. Keeps the original bytes to restore exactly.
+	**/
+	class PatchManager
+	{
+	public:
+		PatchManager();
+		~PatchManager();
+
+	public:
+		// Records the original bytes and the page protections. Returns an index of the patch, otherwise -1.
+		int Add(void *pTarget, size_t nSize);
+		void Clear();
+
+		int GetCount() const;
+		int GetPageRunCount() const;
+
+	public:
+		// Makes the pages of every patch writable. Nothing is left open on fail.
+		bool Open();
+		void Close();
+		bool IsOpen() const;
+
+		// Writes the original bytes back, in its own window when not open.
+		bool Restore();
+
+	public:
+		// Plugin-owned memory within a 32-bit displacement of an address, e.g. for a redirected "[rip+disp]" operand.
+		// Freed on clear, so restore the operands before.
+		void *AllocateNear(const void *pNear, size_t nSize);
+
+	protected:
+		struct PageRun_t
+		{
+			uintptr_t m_nBase;
+			size_t m_nSize;
+			int m_iAccess; // "SH_MEM_*" of the original protection.
+		};
+
+		bool AddPages(uintptr_t nBegin, uintptr_t nEnd);
+		static size_t GetPageSize();
+
+		struct NearBlock_t
+		{
+			uint8_t *m_pBase;
+			size_t m_nSize;
+			size_t m_nUsed;
+		};
+
+		static bool IsNear(uintptr_t nAddress, uintptr_t nNear);
+		static void *MapNear(uintptr_t nNear, size_t nSize);
+		static void UnmapNear(void *pBase, size_t nSize);
+
+	private:
+		struct Patch_t
+		{
+			uint8_t *m_pTarget;
+			std::vector<uint8_t> m_vecOriginal;
+		};
+
+		std::vector<Patch_t> m_vecPatches;
+		std::vector<PageRun_t> m_vecPageRuns; // Sorted, merged when adjacent with the same protection.
+		std::vector<NearBlock_t> m_vecNearBlocks;
+
+		bool m_bOpen;
+	}; // PatchManager
+}; // Tickrate
+
+#endif // _INCLUDE_METAMOD_SOURCE_TICKRATE_PATCH_MANAGER_HPP_
@@ -0,0 +1,127 @@
+/**
+ * vim: set ts=4 sw=4 tw=99 noet :
+ * ======================================================
+ * Metamod:Source Tickrate
+ * Written by Wend4r (Vladimir Ezhikov).
+ * ======================================================
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef _INCLUDE_METAMOD_SOURCE_TICKRATE_PHASE_RECORDER_HPP_
+#	define _INCLUDE_METAMOD_SOURCE_TICKRATE_PHASE_RECORDER_HPP_
+
+#	pragma once
+
+#	include <tickrate/frame_profiler.hpp>
+
+#	include <stddef.h>
+#	include <stdint.h>
+
+#	define TICKRATE_PHASE_RECORDER_RECORD_BITS 12 // 4096 frames, 32 seconds at 128 tick.
+#	define TICKRATE_PHASE_RECORDER_RECORD_COUNT (1 << TICKRATE_PHASE_RECORDER_RECORD_BITS)
+
+#	define TICKRATE_PHASE_RECORDER_FILE_MAGIC 0x48505254 // "TRPH".
+#	define TICKRATE_PHASE_RECORDER_FILE_VERSION 1
+
+namespace Tickrate
+{
+	/**
+	 * @brief Splits each frame into simulate, network send and idle (sleep) portions.
+	 * The main thread only.
+	**/
+	class PhaseRecorder
+	{
+	public:
+		PhaseRecorder();
+
+	public:
+#	pragma pack(push, 1)
+		struct Record_t // Microseconds.
+		{
+			uint32_t m_nWallTime; // Between two frame boundaries.
+			uint32_t m_nSimulateTime; // From the tick advance to the game post simulate, of all ticks.
+			uint32_t m_nSendTime; // From the client update to the end of the frame computation.
+			uint32_t m_nIdleTime; // Out of the frame computation.
+			uint8_t m_nTicks; // Simulated ones of the frame.
+			uint8_t m_nFlags;
+		};
+
+		struct FileHeader_t
+		{
+			uint32_t m_nMagic;
+			uint16_t m_nVersion;
+			uint16_t m_nRecordSize;
+			uint32_t m_nTickrate;
+			uint32_t m_nRecords; // Follow the header, oldest first.
+		};
+#	pragma pack(pop)
+
+		enum RecordFlags_t : uint8_t
+		{
+			RECORD_NONE = 0,
+			RECORD_COMPUTE_UNKNOWN = (1 << 0), // The send and idle ones are unknown.
+		};
+
+		struct Portion_t
+		{
+			double m_dblMean; // Microseconds.
+			FrameProfiler::Percentiles_t m_aPercentiles;
+		};
+
+		struct Stats_t
+		{
+			int m_nRecords;
+			double m_dblTicksPerFrame;
+
+			Portion_t m_aWall;
+			Portion_t m_aSimulate;
+			Portion_t m_aSend;
+			Portion_t m_aIdle;
+		};
+
+	public:
+		void Reset();
+
+		void OnSimulateBegin(double dblNow);
+		void OnSimulateEnd(double dblNow);
+		void OnSendBegin(double dblNow);
+
+		// Closes the frame. Pass a negative compute time when it's unknown.
+		void OnFrameBoundary(double dblNow, double dblComputeTime);
+
+	public:
+		uint32_t GetRecordCount() const;
+
+		// Copies the last (up to nMaxCount) records, oldest first. Returns a copied count.
+		int Collect(Record_t *pOutput, int nMaxCount) const;
+
+		bool Compute(Stats_t &aOutput, int nMaxCount = TICKRATE_PHASE_RECORDER_RECORD_COUNT) const;
+
+	protected:
+		static uint32_t ToMicroseconds(double dblSeconds);
+
+	private:
+		double m_dblFrameStart;
+		double m_dblSimulateBegin; // Of the current tick, otherwise 0.
+		double m_dblSimulateTime;
+		double m_dblSendBegin; // Otherwise 0.
+		int m_nTicks;
+
+		uint32_t m_nHead;
+		Record_t m_aRecords[TICKRATE_PHASE_RECORDER_RECORD_COUNT];
+	}; // PhaseRecorder
+}; // Tickrate
+
+#endif // _INCLUDE_METAMOD_SOURCE_TICKRATE_PHASE_RECORDER_HPP_
@@ -27,6 +27,10 @@
 #	include <stddef.h>
 #	include <stdint.h>
 
+#	include <functional>
+#	include <mutex>
+#	include <vector>
+
 #	include <tier0/dbg.h>
 #	include <tier0/platform.h>
 #	include <tier0/utlscratchmemory.h>
@@ -36,12 +40,29 @@
 
 #	include <gamedata.hpp> // GameData
 
+#	include <tickrate/gamedata_blob.hpp>
+#	include <tickrate/module_identity.hpp>
+#	include <tickrate/signature_scanner.hpp>
+#	include <tickrate/string_xref.hpp>
+
 #	define TICKRATE_GAMECONFIG_FOLDER_DIR "gamedata"
+#	define TICKRATE_GAMECONFIG_PLATFORM TICKRATE_GAMEDATA_BLOB_PLATFORM
 #	define TICKRATE_GAMECONFIG_GAMERESOURCE_FILENAME "gameresource.games.*"
 #	define TICKRATE_GAMECONFIG_GAMESYSTEM_FILENAME "gamesystem.games.*"
 #	define TICKRATE_GAMECONFIG_HOSTFRAME_FILENAME "hostframe.games.*"
+#	define TICKRATE_GAMECONFIG_PATCHES_FILENAME "patches.games.*"
 #	define TICKRATE_GAMECONFIG_SOURCE2SERVER_FILENAME "source2server.games.*"
 #	define TICKRATE_GAMECONFIG_TICK_FILENAME "tick.games.*"
+#	define TICKRATE_GAMECONFIG_FILES "*.games.*"
+#	define TICKRATE_GAMECONFIG_BLOB_FILENAME "gamedata." TICKRATE_GAMEDATA_BLOB_PLATFORM ".bin"
+#	define TICKRATE_GAMECONFIG_PRELOAD_FILENAME "preload.*"
+
+#	define TICKRATE_GAMECONFIG_CACHE_FILENAME "cache.txt"
+#	define TICKRATE_GAMECONFIG_CACHE_HEADER "tickrate_gamedata_cache"
+#	define TICKRATE_GAMECONFIG_CACHE_VERSION 2
+
+#	define TICKRATE_GAMECONFIG_REPAIRED_TICKRATE_MIN 16 // A plausible range of the tick values of a repaired signature.
+#	define TICKRATE_GAMECONFIG_REPAIRED_TICKRATE_MAX 1024
 
 class CBaseGameSystemFactory;
 class CGameEventManager;
@@ -65,23 +86,219 @@ namespace Tickrate
 	public: // IGameData
 		const DynLibUtils::CModule *FindLibrary(const char *pszName) const;
 
+	public:
+		const ModuleIdentity *FindLibraryIdentity(const char *pszName) const;
+
+		// Scans the executable (or read-only data) segments of a library at once. Returns a found count.
+		size_t ScanLibrary(const char *pszName, const SignatureScanner &aScanner, std::vector<const uint8_t *> &vecOutput, bool bExecutable = true) const;
+
+		// Builds the string references index of a library on first use. Thread-safe.
+		const StringXref *FindLibraryStringXref(const char *pszName) const;
+
+		// A segment of the libraries with the whole range, otherwise nullptr.
+		const ModuleIdentity::Segment_t *FindLibrarySegment(const void *pAddress, size_t nSize) const;
+
+		// Replaces the broken signatures of a game config by the functions of their "used_strings", outputs the names of the repaired ones.
+		int RepairSignatures(KeyValues3 *pGameConfig, CUtlVector<CUtlString> &vecRepaired, GameData::CBufferStringVector &vecMessages) const;
+
+	protected:
+		// A shortest signature of the function bytes, first matched at the function.
+		bool MakeSignature(const char *pszLibrary, const uint8_t *pFunction, CBufferString &sOutput) const;
+
 	protected:
 		bool LoadGameData(const char *pszBaseDir, const char *pszPathID, GameData::CBufferStringVector &vecMessages);
 
+	protected: // Cache of the resolved gamedata, keyed by the module builds and the config files.
+		bool GetGameDataCache(const char *pszBaseConfigDir, const char *pszPathID, char *pszCacheFile, size_t nCacheFileLength, CBufferString &sKey);
+		bool LoadGameDataCache(const char *pszCacheFile, const char *pszKey);
+		bool SaveGameDataCache(const char *pszCacheFile, const char *pszKey, GameData::CBufferStringVector &vecMessages);
+		virtual void OnGameDataCacheSaved(const char *pszCacheFile) {} // A notice, its failures are of the messages.
+
+		// Of a lazy resolve by a getter, without a caller to return them.
+		virtual void OnGameDataMessages(const GameData::CBufferStringVector &vecMessages) = 0;
+
+		struct ModuleIdentityEntry_t
+		{
+			const char *m_pszName;
+			const ModuleIdentity *m_pIdentity;
+		};
+
+		int GetModuleIdentities(ModuleIdentityEntry_t (&aOutput)[3]) const;
+
 	public:
 		class GameDataStorage
 		{
 		public:
-			bool Load(IGameData *pRoot, const char *pszBaseConfigDir, const char *pszPathID, GameData::CBufferStringVector &vecMessages);
+			GameDataStorage();
+
+		public:
+			enum Config_t : int
+			{
+				CONFIG_GAMERESOURCE = 0,
+				CONFIG_GAMESYSTEM,
+				CONFIG_HOSTFRAME,
+				CONFIG_PATCHES,
+				CONFIG_SOURCE2SERVER,
+				CONFIG_TICK,
+
+				CONFIG_MAX
+			};
+
+			// Resolves the preloaded configs, the rest on first access of their getters.
+			bool Load(Provider *pRoot, const char *pszBaseConfigDir, const char *pszPathID, GameData::CBufferStringVector &vecMessages);
+			void Reset();
+
+			// A cacheable config is loaded in other way (e.g. of the cache).
+			void SetResolved(Config_t eConfig);
+			bool IsResolved(Config_t eConfig) const;
+			bool IsFailed(Config_t eConfig) const; // Not retried until the next load.
+			bool IsRepaired(Config_t eConfig) const; // Of a repaired signature, never cached.
+
+			static bool IsCacheable(Config_t eConfig);
+			static const char *GetConfigName(Config_t eConfig);
+			static Config_t FindConfig(const char *pszName); // Otherwise CONFIG_MAX.
+
+			// Called each time cacheable configs have been resolved, the lazy ones may never be. Adds to the messages of the resolve.
+			void SetResolvedCallback(std::function<void (GameData::CBufferStringVector &)> funcCallback);
+
+		protected:
+			bool ParsePreload(const char *pszBaseConfigDir, const char *pszPathID, bool (&aOutput)[CONFIG_MAX], GameData::CBufferStringVector &vecMessages);
+			void Resolve(const bool (&aConfigs)[CONFIG_MAX], GameData::CBufferStringVector &vecMessages);
+			void Require(Config_t eConfig) const; // Blocks to resolve, the messages go to the root.
+
+		public:
+			struct CacheEntry_t
+			{
+				const char *m_pszName;
+				void **m_ppAddress; // An address,
+				ptrdiff_t *m_pnOffset; // an offset,
+				SignatureScanner::Pattern_t *m_pPattern = nullptr; // or a pattern.
+			};
+
+			void GetCacheEntries(Config_t eConfig, CUtlVector<CacheEntry_t> &vecOutput);
+
+			// Of the entries in the order.
+			struct CacheValue_t
+			{
+				void *m_pAddress = nullptr;
+				ptrdiff_t m_nOffset = 0;
+				SignatureScanner::Pattern_t m_aPattern;
+				bool m_bFound = false;
+			};
+
+			void WriteCacheValues(Config_t eConfig, const std::vector<CacheValue_t> &vecValues); // The found ones.
+
+		protected:
+			// The addresses of repaired signatures: the offsets to them are of the old function, so each one must be in a library segment and the tick values plausible.
+			bool ValidateRepaired(Config_t eConfig, const CUtlVector<CUtlString> &vecAddresses, GameData::CBufferStringVector &vecMessages);
+			void ResetConfig(Config_t eConfig);
 
 		protected:
 			bool LoadGameResource(IGameData *pRoot, KeyValues3 *pGameConfig, GameData::CBufferStringVector &vecMessages);
 			bool LoadGameSystem(IGameData *pRoot, KeyValues3 *pGameConfig, GameData::CBufferStringVector &vecMessages);
 			bool LoadHostFrame(IGameData *pRoot, KeyValues3 *pGameConfig, GameData::CBufferStringVector &vecMessages);
+			bool LoadPatches(IGameData *pRoot, KeyValues3 *pGameConfig, GameData::CBufferStringVector &vecMessages);
 			bool LoadSource2Server(IGameData *pRoot, KeyValues3 *pGameConfig, GameData::CBufferStringVector &vecMessages);
 			bool LoadTick(IGameData *pRoot, KeyValues3 *pGameConfig, GameData::CBufferStringVector &vecMessages);
 
+			void CommitGameResource();
+			void CommitGameSystem();
+			void CommitHostFrame();
+			void CommitPatches();
+			void CommitSource2Server();
+			void CommitTick();
+
+			struct ConfigEntry_t
+			{
+				const char *m_pszName; // Of the preload list.
+				const char *m_pszFilename;
+				bool (GameDataStorage::*m_pfnLoad)(IGameData *, KeyValues3 *, GameData::CBufferStringVector &);
+				void (GameDataStorage::*m_pfnCommit)();
+				bool m_bCacheable; // The entries are known before loading.
+			};
+
+			static const ConfigEntry_t sm_aConfigs[CONFIG_MAX];
+
+			// Rebuilds a config tree of the precompiled gamedata.
+			static void LoadBlobNode(const GameDataBlob &aBlob, uint32_t nNode, KeyValues3 *pOutput);
+
+		protected: // Fast path of a cacheable config: the signatures of every config are scanned in one pass per library, then its cache entries are evaluated.
+			struct Index_t
+			{
+				enum Action_t : int
+				{
+					ACTION_OFFSET = 0, // The address of the signature plus an offset.
+					ACTION_READ_OFFS32 // Of "[rip+disp32]" at an offset.
+				};
+
+				// Parsed bytes and a mask, of the blob in place.
+				struct Pattern_t
+				{
+					const uint8_t *m_pBytes;
+					const uint8_t *m_pMask;
+					size_t m_nLength;
+				};
+
+				struct Signature_t
+				{
+					const char *m_pszName;
+					const char *m_pszLibrary;
+					Pattern_t m_aPattern;
+					const uint8_t *m_pFound;
+				};
+
+				struct Address_t
+				{
+					const char *m_pszName;
+					const char *m_pszSignature;
+					Action_t m_eAction;
+					ptrdiff_t m_nValue;
+				};
+
+				struct Offset_t
+				{
+					const char *m_pszName;
+					ptrdiff_t m_nValue;
+				};
+
+				struct Prologue_t
+				{
+					const char *m_pszName; // Of a function, the cache entry is "<name>::prologue".
+					Pattern_t m_aPattern;
+				};
+
+				std::vector<SignatureScanner::Pattern_t> m_vecPatterns; // Parsed of a game config, reserved before. Empty of the blob.
+
+				std::vector<Signature_t> m_vecSignatures;
+				std::vector<Address_t> m_vecAddresses;
+				std::vector<Offset_t> m_vecOffsets;
+				std::vector<Prologue_t> m_vecPrologues;
+
+				bool m_bValid = false; // Every member of the game config is known, otherwise by GameData.
+			};
+
+			// Strings of the index are of the game config.
+			static bool BuildIndex(KeyValues3 *pGameConfig, Index_t &aOutput);
+
+			// Read in place: strings and patterns are of the mapping. A source out of the index is loaded by its tree.
+			static bool BuildIndex(const GameDataBlob &aBlob, int iSource, Index_t &aOutput);
+
+			// Every signature must be found, the reads are bounds-checked.
+			bool EvaluateIndex(Config_t eConfig, const Index_t &aIndex, std::vector<CacheValue_t> &vecOutput);
+
 		public:
+			// Queues the listener callbacks of a load worker to run them on the main thread.
+			class CDeferredCallbacks
+			{
+			public:
+				void Add(std::function<void ()> funcCallback);
+				void Run();
+				void Clear();
+
+			private:
+				std::vector<std::function<void ()>> m_vecCallbacks;
+			}; // CDeferredCallbacks
+
 			class CGameResource
 			{
 			public:
@@ -89,7 +306,9 @@ namespace Tickrate
 
 			public:
 				bool Load(IGameData *pRoot, KeyValues3 *pGameConfig, GameData::CBufferStringVector &vecMessages);
+				void Commit();
 				void Reset();
+				void GetCacheEntries(CUtlVector<CacheEntry_t> &vecOutput);
 
 			public:
 				ptrdiff_t GetEntitySystemOffset() const;
@@ -97,6 +316,7 @@ namespace Tickrate
 			private:
 				GameData::Config::Offsets::ListenerCallbacksCollector m_aOffsetCallbacks;
 				GameData::Config m_aGameConfig;
+				CDeferredCallbacks m_aDeferred;
 
 			private: // Offsets.
 				ptrdiff_t m_nEntitySystemOffset = -1;
@@ -109,7 +329,9 @@ namespace Tickrate
 
 			public:
 				bool Load(IGameData *pRoot, KeyValues3 *pGameConfig, GameData::CBufferStringVector &vecMessages);
+				void Commit();
 				void Reset();
+				void GetCacheEntries(CUtlVector<CacheEntry_t> &vecOutput);
 
 			public:
 				CBaseGameSystemFactory **GetFirstPointer() const;
@@ -117,6 +339,7 @@ namespace Tickrate
 			private:
 				GameData::Config::Addresses::ListenerCallbacksCollector m_aAddressCallbacks;
 				GameData::Config m_aGameConfig;
+				CDeferredCallbacks m_aDeferred;
 
 			private: // Addresses.
 				CBaseGameSystemFactory **m_ppFirst = nullptr;
@@ -129,7 +352,10 @@ namespace Tickrate
 
 			public:
 				bool Load(IGameData *pRoot, KeyValues3 *pGameConfig, GameData::CBufferStringVector &vecMessages);
+				void Commit();
 				void Reset();
+				void GetCacheEntries(CUtlVector<CacheEntry_t> &vecOutput);
+				void Derive(); // The frame of the address, resolved or cached.
 
 			public:
 				CFrame *GetPointer() const;
@@ -137,11 +363,74 @@ namespace Tickrate
 			private:
 				GameData::Config::Addresses::ListenerCallbacksCollector m_aAddressCallbacks;
 				GameData::Config m_aGameConfig;
+				CDeferredCallbacks m_aDeferred;
 
 			private: // Addresses.
+				void *m_pAddress = nullptr; // Of the gamedata.
 				CFrame *m_p = nullptr;
 			}; // CHostFrame
 
+			class CPatches
+			{
+			public:
+				CPatches();
+
+			public:
+				bool Load(IGameData *pRoot, KeyValues3 *pGameConfig, GameData::CBufferStringVector &vecMessages);
+				void Commit();
+				void Reset();
+
+			public:
+				enum Kind_t : int
+				{
+					KIND_IMMEDIATE = 0, // The address is of an instruction with the value.
+					KIND_RIP_RELATIVE // The address is of an instruction with "[rip+disp32]" to the value.
+				};
+
+				enum Type_t : int
+				{
+					TYPE_FLOAT = 0,
+					TYPE_DOUBLE,
+					TYPE_INT32
+				};
+
+				enum Value_t : int
+				{
+					VALUE_INTERVAL = 0,
+					VALUE_TICKS_PER_SECOND
+				};
+
+				// A hardcoded tick constant of an instruction operand.
+				struct Operand_t
+				{
+					CUtlString m_sName;
+					uint8_t *m_pInstruction = nullptr;
+
+					Kind_t m_eKind;
+					int m_iOffset; // Of the immediate or the displacement in the instruction.
+					int m_iInstructionSize; // To the next instruction, RIP-relative only.
+
+					Type_t m_eType;
+					Value_t m_eValue;
+					double m_dblExpected; // Checked before the first write.
+				};
+
+				const CUtlVector<Operand_t> &GetOperands() const;
+
+				static size_t GetTypeSize(Type_t eType);
+
+			protected:
+				bool ParseOperand(const char *pszName, KeyValues3 *pOperand, GameData::CBufferStringVector &vecMessages);
+
+			private:
+				GameData::Config::Addresses::ListenerCallbacksCollector m_aAddressCallbacks;
+				GameData::Config m_aGameConfig;
+				CDeferredCallbacks m_aDeferred;
+
+			private: // Addresses.
+				CUtlVector<Operand_t> m_vecOperands;
+			}; // CPatches
+
 			class CSource2Server
 			{
 			public:
@@ -149,7 +438,9 @@ namespace Tickrate
 
 			public:
 				bool Load(IGameData *pRoot, KeyValues3 *pGameConfig, GameData::CBufferStringVector &vecMessages);
+				void Commit();
 				void Reset();
+				void GetCacheEntries(CUtlVector<CacheEntry_t> &vecOutput);
 
 			public:
 				CGameEventManager **GetGameEventManagerPointer() const;
@@ -157,6 +448,7 @@ namespace Tickrate
 			private:
 				GameData::Config::Addresses::ListenerCallbacksCollector m_aAddressCallbacks;
 				GameData::Config m_aGameConfig;
+				CDeferredCallbacks m_aDeferred;
 
 			private: // Addresses.
 				CGameEventManager **m_ppGameEventManager = nullptr;
@@ -169,7 +461,9 @@ namespace Tickrate
 
 			public:
 				bool Load(IGameData *pRoot, KeyValues3 *pGameConfig, GameData::CBufferStringVector &vecMessages);
+				void Commit();
 				void Reset();
+				void GetCacheEntries(CUtlVector<CacheEntry_t> &vecOutput);
 
 			public:
 				float *GetIntervalPointer() const;
@@ -179,9 +473,16 @@ namespace Tickrate
 
 				float *GetPerSecond() const;
 
+				void *GetSleepAfterMainLoop() const;
+				const SignatureScanner::Pattern_t &GetSleepAfterMainLoopPrologue() const; // Expected whole position-independent instructions, otherwise empty.
+
+			protected:
+				bool ParsePrologues(KeyValues3 *pGameConfig, GameData::CBufferStringVector &vecMessages);
+
 			private:
 				GameData::Config::Addresses::ListenerCallbacksCollector m_aAddressCallbacks;
 				GameData::Config m_aGameConfig;
+				CDeferredCallbacks m_aDeferred;
 
 			private: // Addresses.
 				float *m_pInterval = nullptr;
@@ -190,11 +491,19 @@ namespace Tickrate
 				float *m_pInterval3 = nullptr;
 
 				float *m_pPerSecond = nullptr;
+
+				void *m_pSleepAfterMainLoop = nullptr;
+
+			private: // Prologues.
+				SignatureScanner::Pattern_t m_aSleepAfterMainLoopPrologue;
 			}; // CTick
 
+			// The first call of a lazy config blocks to read and scan its gamedata,
+			// a failed config stays empty (its getters return nullptr or -1).
 			const CGameResource &GetGameResource() const;
 			const CGameSystem &GetGameSystem() const;
 			const CHostFrame &GetHostFrame() const;
+			const CPatches &GetPatches() const;
 			const CSource2Server &GetSource2Server() const;
 			const CTick &GetTick() const;
 
@@ -202,13 +511,26 @@ namespace Tickrate
 			CGameResource m_aGameResource;
 			CGameSystem m_aGameSystem;
 			CHostFrame m_aHostFrame;
+			CPatches m_aPatches;
 			CSource2Server m_aSource2Server;
 			CTick m_aTick;
+
+		private: // Lazy resolution.
+			Provider *m_pRoot;
+			CUtlString m_sBaseConfigDir;
+			CUtlString m_sPathID;
+			GameDataBlob m_aBlob;
+
+			bool m_aResolved[CONFIG_MAX];
+			bool m_aFailed[CONFIG_MAX];
+			bool m_aRepaired[CONFIG_MAX];
+			std::function<void (GameData::CBufferStringVector &)> m_funcResolvedCallback;
 		}; // GameDataStorage
 
 		const GameDataStorage &GetGameDataStorage() const;
 
 	private:
+		mutable std::mutex m_mtxSymbols;
 		CUtlSymbolTableLarge_CI m_aSymbolTable;
 		CUtlMap<CUtlSymbolLarge, DynLibUtils::CModule *> m_mapLibraries;
 
@@ -219,6 +541,15 @@ namespace Tickrate
 		DynLibUtils::CModule m_aEngine2Library, 
 		                     m_aFileSystemSTDIOLibrary, 
 		                     m_aServerLibrary;
+
+		ModuleIdentity m_aEngine2Identity, 
+		               m_aFileSystemSTDIOIdentity, 
+		               m_aServerIdentity;
+
+		mutable std::mutex m_mtxStringXrefs;
+		mutable StringXref m_aEngine2StringXref, 
+		                   m_aFileSystemSTDIOStringXref, 
+		                   m_aServerStringXref;
 	}; // Provider
 }; // Tickrate
 
@@ -0,0 +1,90 @@
+/**
+ * vim: set ts=4 sw=4 tw=99 noet :
+ * ======================================================
+ * Metamod:Source Tickrate
+ * Written by Wend4r (Vladimir Ezhikov).
+ * ======================================================
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef _INCLUDE_METAMOD_SOURCE_TICKRATE_SIGNATURE_SCANNER_HPP_
+#	define _INCLUDE_METAMOD_SOURCE_TICKRATE_SIGNATURE_SCANNER_HPP_
+
+#	pragma once
+
+#	include <stddef.h>
+#	include <stdint.h>
+
+#	include <vector>
+
+namespace Tickrate
+{
+	/**
+	 * @brief Finds many byte signatures ("48 8B ? ? 89") in one pass over a memory range.
+	 * Every pattern gets a rare anchor byte, a SIMD (AVX2 or SSE2) prefilter finds
+	 * the positions of any anchor, then candidates are verified by the wildcard masks.
+	**/
+	class SignatureScanner
+	{
+	public:
+		SignatureScanner();
+
+	public:
+		struct Pattern_t
+		{
+			std::vector<uint8_t> m_vecBytes;
+			std::vector<uint8_t> m_vecMask; // 0xFF to match, 0x00 for a wildcard.
+
+			size_t m_nAnchor; // An index of the prefilter byte.
+		};
+
+		// Parses a hex string with "?" (or "??") wildcards.
+		static bool Parse(const char *pszSignature, Pattern_t &aOutput);
+
+		// Returns an index of the pattern, otherwise -1.
+		int Add(const char *pszSignature);
+		int Add(const Pattern_t &aPattern);
+		int Add(const uint8_t *pBytes, const uint8_t *pMask, size_t nLength); // Of parsed bytes and a mask.
+
+		void Clear();
+		size_t GetCount() const;
+		const Pattern_t &GetPattern(int iIndex) const;
+
+	public:
+		// Fills a first match (or nullptr) of every pattern. Returns a found count.
+		size_t Scan(const uint8_t *pBegin, size_t nSize, std::vector<const uint8_t *> &vecOutput) const;
+
+		// Scans to the previous results, only the patterns without a match yet. Returns a found count.
+		size_t ScanMore(const uint8_t *pBegin, size_t nSize, std::vector<const uint8_t *> &vecOutput) const;
+
+	public:
+		// A plain single-pattern search, a reference.
+		static const uint8_t *ScanSingle(const Pattern_t &aPattern, const uint8_t *pBegin, size_t nSize);
+
+		static bool Compare(const Pattern_t &aPattern, const uint8_t *pAt);
+
+	protected:
+		static size_t ChooseAnchor(const Pattern_t &aPattern);
+		void Build();
+
+	private:
+		std::vector<Pattern_t> m_vecPatterns;
+
+		std::vector<uint8_t> m_vecAnchors; // Distinct anchor bytes.
+		std::vector<int> m_aBuckets[256]; // Patterns by an anchor byte.
+	}; // SignatureScanner
+}; // Tickrate
+
+#endif // _INCLUDE_METAMOD_SOURCE_TICKRATE_SIGNATURE_SCANNER_HPP_
@@ -0,0 +1,106 @@
+/**
+ * vim: set ts=4 sw=4 tw=99 noet :
+ * ======================================================
+ * Metamod:Source Tickrate
+ * Written by Wend4r (Vladimir Ezhikov).
+ * ======================================================
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef _INCLUDE_METAMOD_SOURCE_TICKRATE_STRING_XREF_HPP_
+#	define _INCLUDE_METAMOD_SOURCE_TICKRATE_STRING_XREF_HPP_
+
+#	pragma once
+
+#	include <tickrate/module_identity.hpp>
+
+#	include <stddef.h>
+#	include <stdint.h>
+
+#	include <string_view>
+#	include <unordered_map>
+#	include <vector>
+
+namespace Tickrate
+{
+	/**
+	 * @brief An index of the code references to the read-only data of a module,
+	 * to find functions by their strings ("used_strings" of gamedata) when a signature has broken.
+	 * 
+	 * Built once by one linear pass over the executable segments: every RIP-relative "lea"
+	 * into the data is hashed by its target, and the targets by their strings.
+	 * Functions are bounded by the unwind table.
+	**/
+	class StringXref
+	{
+	public:
+		StringXref();
+
+	public:
+		bool Build(const ModuleIdentity &aModule);
+		void Clear();
+		bool IsBuilt() const;
+
+		size_t GetReferenceCount() const;
+		size_t GetFunctionCount() const;
+
+	public:
+		// Finds a whole C string in the read-only data, referenced ones first.
+		const uint8_t *FindString(const char *pszString) const;
+
+		// Returns a count of the instructions referencing the address.
+		size_t FindReferences(const uint8_t *pTarget, std::vector<const uint8_t *> &vecOutput) const;
+
+		const uint8_t *FindFunctionStart(const uint8_t *pInside) const;
+
+		// A function referencing the most of the strings, otherwise nullptr (none or ambiguous).
+		const uint8_t *FindFunction(const char *const *ppStrings, size_t nCount, size_t *pnMatched = nullptr) const;
+
+	protected:
+		bool IsData(uintptr_t nAddress) const;
+		void IndexStrings();
+
+		bool ParseEHFrameHeader(const ModuleIdentity &aModule);
+		bool ParseExceptionDirectory(const ModuleIdentity &aModule);
+
+	private:
+		struct Reference_t
+		{
+			uintptr_t m_nAt; // An instruction.
+			uint32_t m_nNext; // Of the same target.
+		};
+
+		struct Function_t
+		{
+			uintptr_t m_nBegin;
+			uintptr_t m_nEnd; // 0 when unknown, up to the next one.
+			uintptr_t m_nEntry; // A primary function of a chained fragment.
+		};
+
+		bool m_bBuilt;
+
+		std::vector<ModuleIdentity::Segment_t> m_vecCode;
+		std::vector<ModuleIdentity::Segment_t> m_vecData;
+		uintptr_t m_nDataBegin, m_nDataEnd;
+
+		std::unordered_map<uintptr_t, uint32_t> m_mapFirstReferences; // By a target.
+		std::vector<Reference_t> m_vecReferences;
+		std::unordered_map<std::string_view, uintptr_t> m_mapStrings; // Of the referenced targets.
+
+		std::vector<Function_t> m_vecFunctions; // Sorted by the begin.
+	}; // StringXref
+}; // Tickrate
+
+#endif // _INCLUDE_METAMOD_SOURCE_TICKRATE_STRING_XREF_HPP_
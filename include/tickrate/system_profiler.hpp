@@ -0,0 +1,113 @@
+/**
+ * vim: set ts=4 sw=4 tw=99 noet :
+ * ======================================================
+ * Metamod:Source Tickrate
+ * Written by Wend4r (Vladimir Ezhikov).
+ * ======================================================
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef _INCLUDE_METAMOD_SOURCE_TICKRATE_SYSTEM_PROFILER_HPP_
+#	define _INCLUDE_METAMOD_SOURCE_TICKRATE_SYSTEM_PROFILER_HPP_
+
+#	pragma once
+
+#	include <tickrate/frame_profiler.hpp>
+
+#	include <stddef.h>
+#	include <stdint.h>
+
+#	include <chrono>
+#	include <string>
+#	include <vector>
+
+#	define TICKRATE_SYSTEM_PROFILER_TICK_BITS 10 // 1024 ticks, 8 seconds at 128 tick.
+#	define TICKRATE_SYSTEM_PROFILER_TICK_COUNT (1 << TICKRATE_SYSTEM_PROFILER_TICK_BITS)
+
+namespace Tickrate
+{
+	/**
+	 * @brief Per-tick time of every game system, summed over its events of the tick.
+	 * The main thread only.
+	**/
+	class SystemProfiler
+	{
+	public:
+		SystemProfiler();
+
+	public:
+		// Returns an index of the system.
+		int Add(const char *pszName);
+		void Clear();
+
+		int GetCount() const;
+		const char *GetName(int iSystem) const;
+
+	public:
+		inline void Begin(int iSystem)
+		{
+			m_vecSystems[iSystem].m_nBegin = Now();
+		}
+
+		inline void End(int iSystem)
+		{
+			auto &aSystem = m_vecSystems[iSystem];
+
+			if(aSystem.m_nBegin)
+			{
+				aSystem.m_nAccumulated += Now() - aSystem.m_nBegin;
+				aSystem.m_nBegin = 0;
+			}
+		}
+
+		// Closes the tick: pushes the accumulated times. On a start of the next one.
+		void OnTick();
+		void Reset();
+
+		uint32_t GetTickCount() const;
+
+	public:
+		struct Stats_t
+		{
+			int m_nSamples;
+			double m_dblMean; // Microseconds per tick.
+			FrameProfiler::Percentiles_t m_aPercentiles; // Nanoseconds per tick.
+		};
+
+		bool Compute(int iSystem, Stats_t &aOutput) const;
+
+	public:
+		static inline uint64_t Now()
+		{
+			return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
+
+	private:
+		struct System_t
+		{
+			std::string m_sName;
+
+			uint64_t m_nBegin;
+			uint64_t m_nAccumulated;
+
+			std::vector<uint32_t> m_vecSamples; // A ring of nanoseconds per tick.
+		};
+
+		std::vector<System_t> m_vecSystems;
+		uint32_t m_nHead;
+	}; // SystemProfiler
+}; // Tickrate
+
+#endif // _INCLUDE_METAMOD_SOURCE_TICKRATE_SYSTEM_PROFILER_HPP_
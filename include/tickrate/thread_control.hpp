@@ -0,0 +1,107 @@
+/**
+ * vim: set ts=4 sw=4 tw=99 noet :
+ * ======================================================
+ * Metamod:Source Tickrate
+ * Written by Wend4r (Vladimir Ezhikov).
+ * ======================================================
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef _INCLUDE_METAMOD_SOURCE_TICKRATE_THREAD_CONTROL_HPP_
+#	define _INCLUDE_METAMOD_SOURCE_TICKRATE_THREAD_CONTROL_HPP_
+
+#	pragma once
+
+#	include <stddef.h>
+#	include <stdint.h>
+
+#	include <vector>
+
+#	ifndef _WIN32
+#		include <sched.h>
+#		include <sys/types.h>
+#	endif
+
+namespace Tickrate
+{
+	/**
+	 * @brief CPU affinity and scheduling of a captured thread, the originals are restored.
+	**/
+	class ThreadControl
+	{
+	public:
+		ThreadControl();
+		~ThreadControl();
+
+	public:
+		enum Policy_t : int
+		{
+			POLICY_KEEP = 0,
+			POLICY_OTHER,
+			POLICY_FIFO,
+			POLICY_RR,
+		};
+
+		struct Settings_t
+		{
+			std::vector<int> m_vecCpus; // Empty to keep.
+			Policy_t m_ePolicy;
+			int m_iPriority; // Of the real-time policies.
+			int m_iNice; // 0 to keep.
+		};
+
+	public:
+		// The calling thread, remembering its current affinity and scheduling.
+		bool Capture(char *error = nullptr, size_t maxlen = 0);
+		bool IsCaptured() const;
+
+		// Applies all it can, the error is of the last fail.
+		bool Apply(const Settings_t &aSettings, char *error = nullptr, size_t maxlen = 0);
+		bool IsApplied() const;
+
+		bool Restore(char *error = nullptr, size_t maxlen = 0);
+
+	public:
+		bool GetCpus(std::vector<int> &vecOutput) const; // Achieved ones.
+		Policy_t GetPolicy() const;
+		int GetPriority() const;
+		int GetNice() const;
+
+	public:
+		// "2-3,8" to the sorted CPUs.
+		static bool ParseCpus(const char *pszList, std::vector<int> &vecOutput);
+		static void FormatCpus(const std::vector<int> &vecCpus, char *pszOutput, size_t nMaxLength);
+
+		static const char *GetPolicyName(Policy_t ePolicy);
+
+	private:
+#	ifdef _WIN32
+		void *m_hThread; // "HANDLE".
+		uintptr_t m_nOriginalMask;
+		int m_iOriginalPriority;
+#	else
+		pid_t m_nThread;
+		cpu_set_t m_aOriginalCpus;
+		int m_iOriginalPolicy;
+		struct sched_param m_aOriginalParam;
+		int m_iOriginalNice;
+#	endif
+
+		bool m_bCaptured;
+		bool m_bApplied;
+	}; // ThreadControl
+}; // Tickrate
+
+#endif // _INCLUDE_METAMOD_SOURCE_TICKRATE_THREAD_CONTROL_HPP_
@@ -0,0 +1,80 @@
+/**
+ * vim: set ts=4 sw=4 tw=99 noet :
+ * ======================================================
+ * Metamod:Source Tickrate
+ * Written by Wend4r (Vladimir Ezhikov).
+ * ======================================================
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef _INCLUDE_METAMOD_SOURCE_TICKRATE_TIERS_HPP_
+#	define _INCLUDE_METAMOD_SOURCE_TICKRATE_TIERS_HPP_
+
+#	pragma once
+
+#	include <vector>
+
+namespace Tickrate
+{
+	/**
+	 * @brief Picks the tickrate by a count of humans.
+	**/
+	class Tiers
+	{
+	public:
+		Tiers();
+
+	public:
+		struct Tier_t
+		{
+			int m_nMinHumans;
+			int m_nMaxHumans; // 0 - unbounded.
+			int m_nTickrate;
+		};
+
+		struct Settings_t
+		{
+			std::vector<Tier_t> m_vecTiers; // Ascending by humans.
+
+			int m_nHysteresis; // Humans past a bound of the current tier to leave it.
+			double m_dblMinDwell; // Seconds in a tier before the next switch.
+		};
+
+		const Settings_t &GetSettings() const;
+		void SetSettings(const Settings_t &aSettings);
+
+	public:
+		void Reset();
+
+		// Returns a tickrate to change to, otherwise 0.
+		int Think(double dblNow, int nHumans);
+
+	public:
+		int Find(int nHumans) const; // Returns an index of the tier, otherwise -1.
+		bool Contains(int iTier, int nHumans, int nMargin) const;
+
+		int GetCurrent() const; // Returns an index of the tier, otherwise -1.
+		int GetCurrentTickrate() const; // Otherwise 0.
+
+	private:
+		Settings_t m_aSettings;
+
+		double m_dblNextThink;
+		double m_dblLastSwitch;
+		int m_iCurrent;
+	}; // Tiers
+}; // Tickrate
+
+#endif // _INCLUDE_METAMOD_SOURCE_TICKRATE_TIERS_HPP_
@@ -0,0 +1,88 @@
+/**
+ * vim: set ts=4 sw=4 tw=99 noet :
+ * ======================================================
+ * Metamod:Source Tickrate
+ * Written by Wend4r (Vladimir Ezhikov).
+ * ======================================================
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef _INCLUDE_METAMOD_SOURCE_TICKRATE_WATCHDOG_HPP_
+#	define _INCLUDE_METAMOD_SOURCE_TICKRATE_WATCHDOG_HPP_
+
+#	pragma once
+
+#	include <stddef.h>
+#	include <stdint.h>
+
+#	define TICKRATE_WATCHDOG_LANE_COUNT 8 // 32-bit lanes, two SSE2 registers.
+
+namespace Tickrate
+{
+	/**
+	 * @brief Verifies the written values against their last writes,
+	 * with one vector compare of every lane per check.
+	**/
+	class Watchdog
+	{
+	public:
+		Watchdog();
+
+	public:
+		// Watches a value of 32-bit lanes. Returns false when the lanes are over.
+		bool Add(void *pTarget, size_t nSize);
+		void Clear();
+
+		int GetLaneCount() const;
+
+	public:
+		// Takes the current values as expected.
+		void Arm();
+		void Disarm();
+		bool IsArmed() const;
+
+		// Returns true when a value has drifted, compares once per nInterval calls.
+		inline bool Think(int nInterval)
+		{
+			if(!m_bArmed || nInterval <= 0 || --m_nCountdown > 0)
+			{
+				return false;
+			}
+
+			m_nCountdown = nInterval;
+
+			return IsDrifted();
+		}
+
+		// Writes the expected values back, counted as a drift.
+		void Restore();
+
+		uint32_t GetDriftCount() const;
+
+	protected:
+		bool IsDrifted() const;
+
+	private:
+		uint32_t *m_apTargets[TICKRATE_WATCHDOG_LANE_COUNT];
+		alignas(16) uint32_t m_aExpected[TICKRATE_WATCHDOG_LANE_COUNT];
+
+		int m_nLanes;
+		bool m_bArmed;
+		int m_nCountdown;
+		uint32_t m_nDrifts;
+	}; // Watchdog
+}; // Tickrate
+
+#endif // _INCLUDE_METAMOD_SOURCE_TICKRATE_WATCHDOG_HPP_
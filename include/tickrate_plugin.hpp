@@ -26,7 +26,21 @@
 
 #	include <itickrate.hpp>
 #	include <tickrate/chat_command_system.hpp>
+#	include <tickrate/entry_hook.hpp>
+#	include <tickrate/frame_profiler.hpp>
+#	include <tickrate/governor.hpp>
+#	include <tickrate/host_arbiter.hpp>
+#	include <tickrate/map_profiles.hpp>
+#	include <tickrate/message_pool.hpp>
+#	include <tickrate/network_profile.hpp>
+#	include <tickrate/pacer.hpp>
+#	include <tickrate/patch_manager.hpp>
+#	include <tickrate/phase_recorder.hpp>
 #	include <tickrate/provider.hpp>
+#	include <tickrate/system_profiler.hpp>
+#	include <tickrate/thread_control.hpp>
+#	include <tickrate/tiers.hpp>
+#	include <tickrate/watchdog.hpp>
 #	include <concat.hpp>
 
 #	include <logger.hpp>
@@ -47,8 +61,13 @@
 #	include <tier0/strtools.h>
 #	include <tier1/convar.h>
 #	include <tier1/utlvector.h>
+#	include <usermessages.pb.h>
+
+#	include <atomic>
+#	include <vector>
 
 #	define TICKRATE_DEFAULT 64
+#	define TICKRATE_FRAME_BOUNDARY_REPEAT_TIME 0.0005 // Seconds, two boundaries of one frame come closer than a frame of any tickrate.
 
 #	define TICKRATE_LOGGINING_COLOR {255, 222, 145, 255}
 
@@ -58,6 +77,16 @@
 #	define TICKRATE_GAME_TRANSLATIONS_PATH_FILES TICKRATE_BASE_DIR CORRECT_PATH_SEPARATOR_S TICKRATE_GAME_TRANSLATIONS_FILES
 #	define TICKRATE_GAME_LANGUAGES_FILES "configs" CORRECT_PATH_SEPARATOR_S "languages.*"
 #	define TICKRATE_GAME_LANGUAGES_PATH_FILES TICKRATE_BASE_DIR CORRECT_PATH_SEPARATOR_S TICKRATE_GAME_LANGUAGES_FILES
+#	define TICKRATE_GAME_GOVERNOR_FILES "configs" CORRECT_PATH_SEPARATOR_S "governor.*"
+#	define TICKRATE_GAME_GOVERNOR_PATH_FILES TICKRATE_BASE_DIR CORRECT_PATH_SEPARATOR_S TICKRATE_GAME_GOVERNOR_FILES
+#	define TICKRATE_GAME_HANDSHAKE_FILES "configs" CORRECT_PATH_SEPARATOR_S "handshake.*"
+#	define TICKRATE_GAME_HANDSHAKE_PATH_FILES TICKRATE_BASE_DIR CORRECT_PATH_SEPARATOR_S TICKRATE_GAME_HANDSHAKE_FILES
+#	define TICKRATE_GAME_NETWORK_FILES "configs" CORRECT_PATH_SEPARATOR_S "network.*"
+#	define TICKRATE_GAME_NETWORK_PATH_FILES TICKRATE_BASE_DIR CORRECT_PATH_SEPARATOR_S TICKRATE_GAME_NETWORK_FILES
+#	define TICKRATE_GAME_MAPS_FILES "configs" CORRECT_PATH_SEPARATOR_S "maps.*"
+#	define TICKRATE_GAME_MAPS_PATH_FILES TICKRATE_BASE_DIR CORRECT_PATH_SEPARATOR_S TICKRATE_GAME_MAPS_FILES
+#	define TICKRATE_GAME_TIERS_FILES "configs" CORRECT_PATH_SEPARATOR_S "tiers.*"
+#	define TICKRATE_GAME_TIERS_PATH_FILES TICKRATE_BASE_DIR CORRECT_PATH_SEPARATOR_S TICKRATE_GAME_TIERS_FILES
 #	define TICKRATE_BASE_PATHID "GAME"
 
 #	define TICKRATE_EXAMPLE_CHAT_COMMAND "example"
@@ -65,6 +94,13 @@
 #	define TICKRATE_CLIENT_CVAR_NAME_CLOCK_CORRECTION "cl_clock_correction"
 
 #	define TICKRATE_CLIENT_CVAR_NAME_LANGUAGE "cl_language"
+#	define TICKRATE_CLIENT_CVAR_NAME_RATE "rate"
+#	define TICKRATE_CLIENT_CVAR_NAME_UPDATE_RATE "cl_updaterate"
+#	define TICKRATE_CLIENT_CVAR_NAME_INTERP_RATIO "cl_interp_ratio"
+#	define TICKRATE_CLIENT_CVAR_NAME_INTERP "cl_interp"
+#	define TICKRATE_CLIENT_NETWORK_CVARS_COUNT 4
+
+#	define TICKRATE_SYSTEM_PROFILER_DUMP_COUNT 16 // The most expensive game systems in the stats.
 
 class CBasePlayerController;
 class INetworkMessageInternal;
@@ -169,7 +205,7 @@ public: // Tickrate.
 	class CChangedData
 	{
 	public:
-		CChangedData(int nInitOld, int nInitNew);
+		CChangedData(int nInitOld = TICKRATE_DEFAULT, int nInitNew = TICKRATE_DEFAULT, bool bInitNotify = false);
 
 	public:
 		int GetOld() const;
@@ -178,8 +214,11 @@ public: // Tickrate.
 		int GetNew() const;
 		float GetNewInterval() const;
 		double GetNewInterval2() const;
+		float GetNewTicksPerSecond() const;
+
+		double GetTickMultiple() const; // Of a tick count, new to old.
 
-		float GetMultiple() const;
+		bool IsNotify() const; // Of "Change", "Set" is silent.
 
 	private:
 		int m_nOld;
@@ -188,14 +227,23 @@ public: // Tickrate.
 		int m_nNew;
 		float m_flNewInterval;
 		double m_dblNewInterval;
+		float m_flNewTicksPerSecond;
 
-		float m_flMultiple;
+		double m_dblTickMultiple;
+
+		bool m_bNotify;
 	};
 
 	int Get() override;
+	int GetTarget(); // A staged tickrate if is, otherwise the current.
 	int Set(int nNew) override;
+	int Stage(int nNew, bool bNotify);
+	bool CommitChange();
 	int Change(int nNew) override;
+	void QueueChange(int nNew); // Applies at the next frame boundary.
+	bool ApplyPendingChange();
 	int ChangeInternal(int nNew);
+	void NotifyChange(int nOld, int nNew); // After the commit.
 	void ChangeHostFrame(CFrame *pHostFrame, const CChangedData &aData);
 	void ChangeGlobals(CGlobalVars *pGlobals, const CChangedData &aData);
 
@@ -206,12 +254,102 @@ public: // CBaseGameSystem
 
 	GS_EVENT(GameFrameBoundary);
 	GS_EVENT(OutOfGameFrameBoundary);
+	GS_EVENT(ServerAdvanceTick);
+	GS_EVENT(ServerGamePostSimulate);
+	GS_EVENT(ServerPreClientUpdate);
+
+protected: // Frame boundary.
+	void OnFrameBoundary(const EventFrameBoundary_t &msg);
+
+public: // Frame profiler.
+	double GetTickBudget();
+	void DumpFrameStats(const ConcatLineString &aConcat, CBufferString &sOutput);
+
+public: // Phase recorder.
+	void DumpPhases(const ConcatLineString &aConcat, CBufferString &sOutput);
+	bool WritePhases(const char *pszFilename, char *error = nullptr, size_t maxlen = 0);
+
+public: // Game system profiler.
+	int RegisterSystemProfiler(); // Returns a count of the hooked game systems.
+	void UnregisterSystemProfiler();
+	void BeginSystemEvent(const IGameSystem *pSystem);
+	void EndSystemEvent(const IGameSystem *pSystem);
+	void DumpSystemProfiler(const ConcatLineString &aConcat, CBufferString &sOutput);
+
+public: // Governor.
+	bool ParseGovernor(char *error = nullptr, size_t maxlen = 0);
+	bool ParseGovernor(KeyValues3 *pRoot, CUtlVector<CUtlString> &vecMessages);
+	void ThinkGovernor();
+	void DumpGovernor(const ConcatLineString &aConcat, CBufferString &sOutput);
+
+public: // Map profiles.
+	bool ParseMapProfiles(char *error = nullptr, size_t maxlen = 0);
+	bool ParseMapProfiles(KeyValues3 *pRoot, CUtlVector<CUtlString> &vecMessages);
+	void ApplyMapProfile(CNetworkGameServerBase *pNetServer, const GameSessionConfiguration_t &config);
+
+	int GetServerTickrate(); // A tickrate of the current map profile if is, otherwise "sv_tickrate".
+
+public: // Tiers.
+	bool ParseTiers(char *error = nullptr, size_t maxlen = 0);
+	bool ParseTiers(KeyValues3 *pRoot, CUtlVector<CUtlString> &vecMessages);
+	void ThinkTiers();
+	void DumpTiers(const ConcatLineString &aConcat, CBufferString &sOutput);
+
+	int GetBaseCeiling(); // A tickrate of the current tier if is, otherwise the server one.
+	int GetCeiling(); // The base one, limited by the host arbiter.
+	int GetHumanCount() const;
+	static int CountHumans(CNetworkGameServerBase *pNetServer); // To resync the incremental count.
+
+public: // Hibernation.
+	void ThinkHibernation();
+	bool WakeUp(); // Restores "sv_tickrate" when hibernating.
+	void DumpHibernation(const ConcatLineString &aConcat, CBufferString &sOutput);
+
+public: // Host arbiter.
+	bool OpenArbiter(char *error = nullptr, size_t maxlen = 0);
+	void CloseArbiter(); // Lifts the limit.
+	void ThinkArbiter();
+	void DumpArbiter(const ConcatLineString &aConcat, CBufferString &sOutput);
+
+public: // Pacer.
+	bool RegisterPacer(char *error = nullptr, size_t maxlen = 0);
+	void UnregisterPacer();
+	void DumpPacer(const ConcatLineString &aConcat, CBufferString &sOutput);
+
+protected:
+	static void OnSleepAfterMainLoop(void *pContext); // Before the engine sleep while paced.
+
+public: // Main thread.
+	bool CaptureMainThread(char *error = nullptr, size_t maxlen = 0);
+	bool ApplyMainThread(char *error = nullptr, size_t maxlen = 0); // Of the current settings, over the restored originals.
+	void RestoreMainThread();
+	void DumpMainThread(const ConcatLineString &aConcat, CBufferString &sOutput);
+
+public: // Watchdog.
+	void RepairTick(); // Writes the last tick values back.
+	void DumpWatchdog(const ConcatLineString &aConcat, CBufferString &sOutput);
+
+public: // Handshake.
+	bool ParseHandshake(char *error = nullptr, size_t maxlen = 0);
+	bool ParseHandshake(KeyValues3 *pRoot, CUtlVector<CUtlString> &vecMessages);
+	void InvalidateHandshake();
+	bool BuildHandshake();
+	void ClearHandshakeMessages();
+	void SendHandshake(IRecipientFilter *pFilter);
 
 public: // Utils.
+	using ParseConfig_t = bool (TickratePlugin::*)(KeyValues3 *pRoot, CUtlVector<CUtlString> &vecMessages);
+
+	int LoadConfigFiles(const char *pszPathFiles, ParseConfig_t pfnParse); // Returns a count of the found files.
+
 	bool InitProvider(char *error = nullptr, size_t maxlen = 0);
 	bool LoadProvider(char *error = nullptr, size_t maxlen = 0);
 	bool UnloadProvider(char *error = nullptr, size_t maxlen = 0);
 
+protected: // Tickrate::Provider
+	void OnGameDataCacheSaved(const char *pszCacheFile) override;
+	void OnGameDataMessages(const GameData::CBufferStringVector &vecMessages) override;
+
 public: // Game Resource.
 	bool RegisterGameResource(char *error = nullptr, size_t maxlen = 0);
 	bool UnregisterGameResource(char *error = nullptr, size_t maxlen = 0);
@@ -228,6 +366,15 @@ public: // Tick.
 	bool RegisterTick(char *error = nullptr, size_t maxlen = 0);
 	bool UnregisterTick(char *error = nullptr, size_t maxlen = 0);
 
+protected: // Operand patches.
+	using CPatches = Tickrate::Provider::GameDataStorage::CPatches;
+
+	// Checks the expected values, then redirects the RIP-relative ones. Nothing fatal, a mismatching patch is skipped.
+	int RegisterOperandPatches();
+	void ChangeOperandPatches(const CChangedData &aData);
+
+	static void EncodeOperandValue(uint8_t *pOutput, CPatches::Type_t eType, double dblValue);
+
 public: // Network Messages.
 	bool RegisterNetMessages(char *error = nullptr, size_t maxlen = 0);
 	bool UnregisterNetMessages(char *error = nullptr, size_t maxlen = 0);
@@ -243,11 +390,30 @@ public: // Translations.
 
 private: // Commands.
 	CON_COMMAND_MEMBER_F(TickratePlugin, "mm_" META_PLUGIN_PREFIX "_reload_gamedata", OnReloadGameDataCommand, "Reload gamedata configs", FCVAR_LINKED_CONCOMMAND);
+	CON_COMMAND_MEMBER_F(TickratePlugin, "mm_" META_PLUGIN_PREFIX "_stats", OnStatsCommand, "Print tick timing statistics", FCVAR_LINKED_CONCOMMAND);
+	CON_COMMAND_MEMBER_F(TickratePlugin, "mm_" META_PLUGIN_PREFIX "_write_phases", OnWritePhasesCommand, "Write the per-frame phase records to a binary file", FCVAR_LINKED_CONCOMMAND);
 
 private: // ConVars. See the constructor
 	ConVar<int> m_aSVTickrateConVar;
 	ConVar<bool> m_aSVToClientClockCorrection;
 	ConVar<bool> m_aEnableFrameDetailsConVar;
+	ConVar<bool> m_aEnableProfilerConVar;
+	ConVar<bool> m_aEnableSystemProfilerConVar;
+	ConVar<float> m_aOverrunToleranceConVar;
+	ConVar<bool> m_aEnableGovernorConVar;
+	ConVar<bool> m_aEnableTiersConVar;
+	ConVar<bool> m_aEnableMapProfilesConVar;
+	ConVar<int> m_aWatchdogIntervalConVar;
+	ConVar<int> m_aHibernationTickrateConVar;
+	ConVar<float> m_aHibernationDelayConVar;
+	ConVar<bool> m_aPacerConVar;
+	ConVar<int> m_aPacerSpinConVar;
+	ConVar<CUtlString> m_aMainThreadCpusConVar;
+	ConVar<int> m_aMainThreadPolicyConVar;
+	ConVar<int> m_aMainThreadPriorityConVar;
+	ConVar<int> m_aMainThreadNiceConVar;
+	ConVar<bool> m_aArbiterConVar;
+	ConVar<float> m_aArbiterCpuBudgetConVar;
 
 public: // SourceHooks.
 	void OnStartupServerHook(const GameSessionConfiguration_t &config, ISource2WorldSession *pWorldSession, const char *);
@@ -257,6 +423,15 @@ public: // SourceHooks.
 	bool OnProcessRespondCvarValueHook(const CCLCMsg_RespondCvarValue_t &aMessage);
 	void OnDisconectClientHook(ENetworkDisconnectionReason eReason);
 
+	void OnServerPreEntityThinkPreHook(const EventServerPreEntityThink_t &msg);
+	void OnServerPreEntityThinkPostHook(const EventServerPreEntityThink_t &msg);
+	void OnServerPostEntityThinkPreHook(const EventServerPostEntityThink_t &msg);
+	void OnServerPostEntityThinkPostHook(const EventServerPostEntityThink_t &msg);
+	void OnServerGamePostSimulatePreHook(const EventServerGamePostSimulate_t &msg);
+	void OnServerGamePostSimulatePostHook(const EventServerGamePostSimulate_t &msg);
+	void OnServerPreClientUpdatePreHook(const EventServerPreClientUpdate_t &msg);
+	void OnServerPreClientUpdatePostHook(const EventServerPreClientUpdate_t &msg);
+
 public: // Dump ones.
 	static void DumpProtobufMessage(const ConcatLineString &aConcat, CBufferString &sOutput, const google::protobuf::Message &aMessage);
 	static void DumpGlobalVars(const ConcatLineString &aConcat, CBufferString &sOutput, const CGlobalVarsBase *pGlobals);
@@ -281,6 +456,12 @@ public: // Utils.
 	void SendChatMessage(IRecipientFilter *pFilter, int iEntityIndex, bool bIsChat, const char *pszChatMessageFormat, const char *pszParam1 = "", const char *pszParam2 = "", const char *pszParam3 = "", const char *pszParam4 = "");
 	void SendTextMessage(IRecipientFilter *pFilter, int iDestination, size_t nParamCount, const char *pszParam, ...);
 
+public: // Network profile.
+	bool ParseNetwork(char *error = nullptr, size_t maxlen = 0);
+	bool ParseNetwork(KeyValues3 *pRoot, CUtlVector<CUtlString> &vecMessages);
+	bool ParseNetworkTier(const KeyValues3 *pTier, int nDefaultTickrate, Tickrate::NetworkProfile::Tier_t &aOutput);
+	bool GetNetworkConVars(int nTickrate, CUtlVector<CVar_t> &vecOutput, CUtlString (&aValues)[TICKRATE_CLIENT_NETWORK_CVARS_COUNT]);
+
 protected: // Handlers.
 	void OnStartupServer(CNetworkGameServerBase *pNetServer, const GameSessionConfiguration_t &config, ISource2WorldSession *pWorldSession);
 	void OnFillServerInfo(CNetworkGameServerBase *pNetServer, CSVCMsg_ServerInfo_t *pServerInfo);
@@ -307,21 +488,86 @@ private: // Language (hash)map.
 private: // Fields.
 	IGameSystemFactory *m_pFactory = NULL;
 
-	int m_iTickIntervalPageBits = 0;
-	int m_iTickInterval2PageBits = 0;
-	int m_iTickInterval3DefaultPageBits = 0;
-	int m_iTickInterval3PageBits = 0;
-	int m_iTicksPerSecondPageBits = 0;
+	Tickrate::PatchManager m_aTickPatches; // Opened around a change only.
+	Tickrate::Watchdog m_aTickWatchdog; // Of the values of the last change.
+
+	Tickrate::EntryHook m_aSleepHook; // "CEngineServiceMgr::SleepAfterMainLoop".
+	Tickrate::Pacer m_aPacer;
+
+	int m_nLastBoundaryFrame = -1; // "framecount" of the globals at the last taken frame boundary.
+	double m_dblLastBoundaryTime = 0.0;
+
+	Tickrate::ThreadControl m_aMainThread; // Captured at the first frame boundary.
+	Tickrate::FrameProfiler::Stats_t m_aMainThreadBaseline; // Before the last apply.
+	bool m_bHasMainThreadBaseline = false;
+
+	Tickrate::Tiers m_aTiers;
+	int m_nHumans = 0; // Connected non-fake clients, counted on connect & disconnect.
+
+	Tickrate::HostArbiter m_aArbiter;
+	int m_nArbiterTickrate = 0; // A limit of the arbiter lowering, otherwise 0.
+
+	bool m_bHibernating = false;
+	double m_dblNextHibernationThink = 0.0;
+	double m_dblNoHumansSince = 0.0; // Otherwise 0.
+
+	struct OperandPatch_t
+	{
+		CPatches::Operand_t m_aOperand; // A copy, the gamedata can be reloaded.
+		uint8_t *m_pValue; // The immediate, or the redirected constant.
+		uint8_t m_aLast[sizeof(double)]; // Written or checked before, otherwise the value has been changed outside.
+	};
+
+	std::vector<OperandPatch_t> m_vecOperandPatches;
 
 	INetworkMessageInternal *m_pSetConVarMessage = NULL;
 	INetworkMessageInternal *m_pGetCvarValueMessage = NULL;
 	INetworkMessageInternal *m_pSayText2Message = NULL;
 	INetworkMessageInternal *m_pTextMsgMessage = NULL;
 
+	Tickrate::MessagePool<CNETMsg_SetConVar> m_aSetConVarPool;
+	Tickrate::MessagePool<CSVCMsg_GetCvarValue> m_aGetCvarValuePool;
+	Tickrate::MessagePool<CUserMessageSayText2> m_aSayText2Pool;
+	Tickrate::MessagePool<CUserMessageTextMsg> m_aTextMsgPool;
+
+	struct HandshakeCVar_t
+	{
+		CUtlString m_sName;
+		CUtlString m_sValue;
+	};
+
+	CUtlVector<HandshakeCVar_t> m_vecHandshakeReplicates;
+	CUtlVector<CUtlString> m_vecHandshakeQueries;
+
+	bool m_bHandshakeDirty = true;
+	int m_nHandshakeTickrate = 0;
+	Tickrate::MessagePool<CNETMsg_SetConVar>::Message_t *m_pHandshakeSetConVarMessage = nullptr;
+	CUtlVector<Tickrate::MessagePool<CSVCMsg_GetCvarValue>::Message_t *> m_vecHandshakeQueryMessages;
+
 	CLanguage m_aServerLanguage;
 	CUtlVector<CLanguage> m_vecLanguages;
 
 	CPlayerData m_aPlayers[ABSOLUTE_PLAYER_LIMIT];
+
+	std::atomic<int> m_nPendingTickrate = 0;
+
+	CChangedData m_aChangedData;
+	bool m_bHasChangedData = false;
+
+	Tickrate::FrameProfiler m_aFrameProfiler;
+	Tickrate::PhaseRecorder m_aPhaseRecorder;
+
+	Tickrate::SystemProfiler m_aSystemProfiler;
+	CUtlMap<const IGameSystem *, int> m_mapProfiledSystems; // To an index of the system profiler.
+	CUtlVector<CUtlString> m_vecSkippedSystems; // Names of the reallocating factories, no instance to hook.
+
+	Tickrate::Governor m_aGovernor;
+	Tickrate::NetworkProfile m_aNetworkProfile;
+
+	Tickrate::MapProfiles m_aMapProfiles;
+	Tickrate::NetworkProfile m_aMapNetworkProfile; // Of the current map profile.
+	bool m_bHasMapNetwork = false;
+	int m_nMapProfileTickrate = 0; // Of the current map profile, until an operator change. Otherwise 0.
 }; // TickratePlugin
 
 extern TickratePlugin *g_pTickratePlugin;
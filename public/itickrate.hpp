@@ -41,6 +41,8 @@ class IGameEventManager2;
 /**
  * @brief A tickrate interface.
  * Note: gets with "ismm->MetaFactory(TICKRATE_INTERFACE_NAME, NULL, NULL);"
+ * Note: a first call of a pointer getter may block to read and scan its gamedata (lazy one),
+ *       a gamedata failed to resolve returns nullptr and is not retried until a reload.
 **/
 class ITickrate
 {
@@ -205,6 +207,8 @@ public: // Player ones.
 
 	/**
 	 * @brief Set a tickrate silently.
+	 *        While a game server is running, tick globals 
+	 *        are committed at the next frame boundary.
 	 * 
 	 * @param nNew          A new tickrate value.
 	 * 
@@ -214,6 +218,8 @@ public: // Player ones.
 
 	/**
 	 * @brief Changes a tickrate with notify messages.
+	 *        While a game server is running, it applies 
+	 *        at the next frame boundary.
 	 * 
 	 * @param nNew          A new tickrate value.
 	 * 
@@ -0,0 +1,202 @@
+/**
+ * vim: set ts=4 sw=4 tw=99 noet :
+ * ======================================================
+ * Metamod:Source Tickrate
+ * Written by Wend4r (Vladimir Ezhikov).
+ * ======================================================
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <tickrate/entry_hook.hpp>
+
+#include <string.h>
+
+#include <initializer_list>
+
+#include <sourcehook/sh_memory.h>
+
+Tickrate::EntryHook::EntryHook()
+ :  m_pFunction(nullptr)
+{
+}
+
+Tickrate::EntryHook::~EntryHook()
+{
+	Remove();
+}
+
+bool Tickrate::EntryHook::Install(void *pFunction, const uint8_t *pExpected, const uint8_t *pMask, size_t nPrologueSize, Callback_t pfnCallback, void *pContext)
+{
+	Remove();
+
+	if(!pFunction || !pExpected || !pfnCallback || nPrologueSize < TICKRATE_ENTRY_HOOK_JUMP_SIZE || nPrologueSize > TICKRATE_ENTRY_HOOK_MAX_PROLOGUE)
+	{
+		return false;
+	}
+
+	auto *pBytes = reinterpret_cast<uint8_t *>(pFunction);
+
+	// The moved bytes must be the known instructions, not of a game update or a hook of another plugin.
+	for(size_t n = 0; n < nPrologueSize; n++)
+	{
+		uint8_t nMask = pMask ? pMask[n] : 0xFF;
+
+		if((pBytes[n] & nMask) != (pExpected[n] & nMask))
+		{
+			return false;
+		}
+	}
+
+	// Within "jmp rel32" of the function, both ways.
+	auto *pStub = reinterpret_cast<uint8_t *>(m_aPatches.AllocateNear(pFunction, TICKRATE_ENTRY_HOOK_STUB_SIZE));
+
+	if(!pStub || m_aPatches.Add(pFunction, nPrologueSize) == -1)
+	{
+		m_aPatches.Clear();
+
+		return false;
+	}
+
+	size_t nStubSize = BuildStub(pStub, pBytes, nPrologueSize, pfnCallback, pContext);
+
+	if(!SourceHook::SetMemAccess(pStub, nStubSize, SH_MEM_READ | SH_MEM_EXEC) || !m_aPatches.Open())
+	{
+		m_aPatches.Clear();
+
+		return false;
+	}
+
+	WriteJump(pBytes, pStub);
+	memset(pBytes + TICKRATE_ENTRY_HOOK_JUMP_SIZE, 0x90, nPrologueSize - TICKRATE_ENTRY_HOOK_JUMP_SIZE); // "nop".
+
+	m_aPatches.Close();
+	m_pFunction = pBytes;
+
+	return true;
+}
+
+void Tickrate::EntryHook::Remove()
+{
+	if(m_pFunction)
+	{
+		m_aPatches.Restore();
+		m_pFunction = nullptr;
+	}
+
+	m_aPatches.Clear(); // Frees the stub.
+}
+
+bool Tickrate::EntryHook::IsInstalled() const
+{
+	return m_pFunction != nullptr;
+}
+
+size_t Tickrate::EntryHook::BuildStub(uint8_t *pStub, const uint8_t *pFunction, size_t nPrologueSize, Callback_t pfnCallback, void *pContext)
+{
+	uint8_t *pOut = pStub;
+
+	auto Emit = [&pOut](std::initializer_list<uint8_t> aBytes)
+	{
+		for(uint8_t nByte : aBytes)
+		{
+			*pOut++ = nByte;
+		}
+	};
+
+	auto EmitImmediate64 = [&pOut](const void *pValue)
+	{
+		uint64_t nValue = reinterpret_cast<uintptr_t>(pValue);
+
+		memcpy(pOut, &nValue, sizeof(nValue));
+		pOut += sizeof(nValue);
+	};
+
+	// "movdqu [rsp+disp8], xmmN" or "movdqu xmmN, [rsp+disp8]".
+	auto EmitVector = [&Emit](bool bStore, int iRegister, uint8_t nDisplacement)
+	{
+		Emit({0xF3, 0x0F, (uint8_t)(bStore ? 0x7F : 0x6F), (uint8_t)(0x44 | (iRegister << 3)), 0x24, nDisplacement});
+	};
+
+#ifdef _WIN32
+	// Arguments: rcx, rdx, r8, r9, xmm0-3. The stack stays 16-byte aligned with the shadow space under the vectors.
+	Emit({0x55}); // push rbp
+	Emit({0x48, 0x89, 0xE5}); // mov rbp, rsp
+	Emit({0x50, 0x51, 0x52, 0x41, 0x50, 0x41, 0x51}); // push rax, rcx, rdx, r8, r9
+	Emit({0x48, 0x83, 0xEC, 0x68}); // sub rsp, 0x68
+
+	for(int i = 0; i < 4; i++)
+	{
+		EmitVector(true, i, (uint8_t)(0x20 + i * 0x10));
+	}
+
+	Emit({0x48, 0xB9}); // mov rcx, imm64
+	EmitImmediate64(pContext);
+	Emit({0x48, 0xB8}); // mov rax, imm64
+	EmitImmediate64(reinterpret_cast<const void *>(pfnCallback));
+	Emit({0xFF, 0xD0}); // call rax
+
+	for(int i = 0; i < 4; i++)
+	{
+		EmitVector(false, i, (uint8_t)(0x20 + i * 0x10));
+	}
+
+	Emit({0x48, 0x83, 0xC4, 0x68}); // add rsp, 0x68
+	Emit({0x41, 0x59, 0x41, 0x58, 0x5A, 0x59, 0x58}); // pop r9, r8, rdx, rcx, rax
+	Emit({0x5D}); // pop rbp
+#else
+	// Arguments: rdi, rsi, rdx, rcx, r8, r9, xmm0-7, al of variadic ones.
+	Emit({0x55}); // push rbp
+	Emit({0x48, 0x89, 0xE5}); // mov rbp, rsp
+	Emit({0x50, 0x57, 0x56, 0x52, 0x51, 0x41, 0x50, 0x41, 0x51}); // push rax, rdi, rsi, rdx, rcx, r8, r9
+	Emit({0x48, 0x81, 0xEC, 0x88, 0x00, 0x00, 0x00}); // sub rsp, 0x88
+
+	for(int i = 0; i < 8; i++)
+	{
+		EmitVector(true, i, (uint8_t)(i * 0x10));
+	}
+
+	Emit({0x48, 0xBF}); // mov rdi, imm64
+	EmitImmediate64(pContext);
+	Emit({0x48, 0xB8}); // mov rax, imm64
+	EmitImmediate64(reinterpret_cast<const void *>(pfnCallback));
+	Emit({0xFF, 0xD0}); // call rax
+
+	for(int i = 0; i < 8; i++)
+	{
+		EmitVector(false, i, (uint8_t)(i * 0x10));
+	}
+
+	Emit({0x48, 0x81, 0xC4, 0x88, 0x00, 0x00, 0x00}); // add rsp, 0x88
+	Emit({0x41, 0x59, 0x41, 0x58, 0x59, 0x5A, 0x5E, 0x5F, 0x58}); // pop r9, r8, rcx, rdx, rsi, rdi, rax
+	Emit({0x5D}); // pop rbp
+#endif
+
+	// The moved prologue, then back to the rest of the function.
+	memcpy(pOut, pFunction, nPrologueSize);
+	pOut += nPrologueSize;
+
+	WriteJump(pOut, pFunction + nPrologueSize);
+	pOut += TICKRATE_ENTRY_HOOK_JUMP_SIZE;
+
+	return (size_t)(pOut - pStub);
+}
+
+void Tickrate::EntryHook::WriteJump(uint8_t *pFrom, const uint8_t *pTo)
+{
+	int32_t nDisplacement = (int32_t)(reinterpret_cast<intptr_t>(pTo) - (reinterpret_cast<intptr_t>(pFrom) + TICKRATE_ENTRY_HOOK_JUMP_SIZE));
+
+	pFrom[0] = 0xE9; // jmp rel32
+	memcpy(pFrom + 1, &nDisplacement, sizeof(nDisplacement));
+}
@@ -0,0 +1,214 @@
+/**
+ * vim: set ts=4 sw=4 tw=99 noet :
+ * ======================================================
+ * Metamod:Source Tickrate
+ * Written by Wend4r (Vladimir Ezhikov).
+ * ======================================================
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <tickrate/frame_profiler.hpp>
+
+#include <algorithm>
+
+Tickrate::FrameProfiler::FrameProfiler()
+ :  m_dblLastBoundary(0.0),
+    m_nHead(0)
+{
+}
+
+void Tickrate::FrameProfiler::Reset()
+{
+	m_dblLastBoundary = 0.0;
+	m_nHead.store(0, std::memory_order_release);
+}
+
+void Tickrate::FrameProfiler::OnFrameBoundary(double dblNow, double dblComputeTime)
+{
+	double dblLast = m_dblLastBoundary;
+
+	m_dblLastBoundary = dblNow;
+
+	if(dblLast <= 0.0 || dblNow < dblLast) // The first boundary after reset.
+	{
+		return;
+	}
+
+	uint32_t nHead = m_nHead.load(std::memory_order_relaxed);
+
+	auto &aSample = m_aSamples[nHead & (TICKRATE_FRAME_PROFILER_SAMPLE_COUNT - 1)];
+
+	aSample.m_nWallTime = (uint32_t)((dblNow - dblLast) * 1000000.0);
+	aSample.m_nComputeTime = dblComputeTime < 0.0 ? UINT32_MAX : (uint32_t)(dblComputeTime * 1000000.0);
+
+	m_nHead.store(nHead + 1, std::memory_order_release);
+}
+
+uint32_t Tickrate::FrameProfiler::GetFrameCount() const
+{
+	return m_nHead.load(std::memory_order_acquire);
+}
+
+int Tickrate::FrameProfiler::Collect(Sample_t *pOutput, int nMaxCount) const
+{
+	uint32_t nHead = m_nHead.load(std::memory_order_acquire);
+
+	uint32_t nCount = std::min<uint32_t>({nHead, (uint32_t)nMaxCount, (uint32_t)TICKRATE_FRAME_PROFILER_SAMPLE_COUNT});
+
+	uint32_t nFirst = nHead - nCount;
+
+	for(uint32_t n = 0; n < nCount; n++)
+	{
+		pOutput[n] = m_aSamples[(nFirst + n) & (TICKRATE_FRAME_PROFILER_SAMPLE_COUNT - 1)];
+	}
+
+	// Drop the oldest samples the producer could overwrite while copying (including the one in progress).
+	uint32_t nNewHead = m_nHead.load(std::memory_order_acquire);
+
+	if(nNewHead < nHead) // Has reset.
+	{
+		return 0;
+	}
+
+	uint32_t nTouched = nNewHead - nHead + 1,
+	         nLimit = TICKRATE_FRAME_PROFILER_SAMPLE_COUNT - nCount;
+
+	if(nTouched > nLimit)
+	{
+		uint32_t nSkip = nTouched - nLimit;
+
+		if(nSkip >= nCount)
+		{
+			return 0;
+		}
+
+		nCount -= nSkip;
+		std::copy(pOutput + nSkip, pOutput + nSkip + nCount, pOutput);
+	}
+
+	return (int)nCount;
+}
+
+bool Tickrate::FrameProfiler::Compute(Stats_t &aOutput, double dblBudget, double dblOverrunTolerance, int nMaxCount) const
+{
+	Buffers_t aBuffers;
+
+	return Compute(aOutput, dblBudget, dblOverrunTolerance, nMaxCount, aBuffers);
+}
+
+bool Tickrate::FrameProfiler::Compute(Stats_t &aOutput, double dblBudget, double dblOverrunTolerance, int nMaxCount, Buffers_t &aBuffers) const
+{
+	auto &vecSamples = aBuffers.m_vecSamples;
+
+	vecSamples.resize(std::max(std::min(nMaxCount, TICKRATE_FRAME_PROFILER_SAMPLE_COUNT), 0));
+
+	int nCount = Collect(vecSamples.data(), (int)vecSamples.size());
+
+	aOutput = {};
+	aOutput.m_nSamples = nCount;
+	aOutput.m_nBudget = (uint32_t)(dblBudget * 1000000.0);
+
+	if(!nCount)
+	{
+		return false;
+	}
+
+	auto &vecWallTimes = aBuffers.m_vecWallTimes,
+	     &vecComputeTimes = aBuffers.m_vecComputeTimes;
+
+	vecWallTimes.clear();
+	vecComputeTimes.clear();
+	vecWallTimes.reserve(nCount);
+	vecComputeTimes.reserve(nCount);
+
+	uint32_t nOverrunAfter = (uint32_t)(dblBudget * (1.0 + dblOverrunTolerance) * 1000000.0);
+
+	uint64_t nJitterSum = 0;
+
+	for(int n = 0; n < nCount; n++)
+	{
+		const auto &aSample = vecSamples[n];
+
+		uint32_t nWallTime = aSample.m_nWallTime;
+
+		vecWallTimes.push_back(nWallTime);
+
+		if(aSample.m_nComputeTime != UINT32_MAX)
+		{
+			vecComputeTimes.push_back(aSample.m_nComputeTime);
+		}
+
+		nJitterSum += nWallTime > aOutput.m_nBudget ? nWallTime - aOutput.m_nBudget : aOutput.m_nBudget - nWallTime;
+
+		if(nWallTime > nOverrunAfter)
+		{
+			aOutput.m_nOverruns++;
+		}
+	}
+
+	aOutput.m_nComputeSamples = (int)vecComputeTimes.size();
+	aOutput.m_nMeanJitter = (uint32_t)(nJitterSum / nCount);
+
+	ComputePercentiles(vecWallTimes.data(), (int)vecWallTimes.size(), aOutput.m_aWallTime);
+	ComputePercentiles(vecComputeTimes.data(), (int)vecComputeTimes.size(), aOutput.m_aComputeTime);
+
+	return true;
+}
+
+void Tickrate::FrameProfiler::ComputePercentiles(uint32_t *pValues, int nCount, Percentiles_t &aOutput)
+{
+	aOutput = {};
+
+	if(nCount <= 0)
+	{
+		return;
+	}
+
+	uint32_t *pEnd = pValues + nCount;
+
+	// Ascending ranks, so each "nth_element" works on the rest only.
+	const struct
+	{
+		int nPercent;
+		uint32_t *pnValue;
+	} aRanks[] =
+	{
+		{
+			50,
+			&aOutput.m_nP50
+		},
+		{
+			95,
+			&aOutput.m_nP95
+		},
+		{
+			99,
+			&aOutput.m_nP99
+		},
+	};
+
+	uint32_t *pBegin = pValues;
+
+	for(const auto &aRank : aRanks)
+	{
+		uint32_t *pNth = pValues + (int)(((int64_t)(nCount - 1) * aRank.nPercent + 50) / 100);
+
+		std::nth_element(pBegin, pNth, pEnd);
+		*aRank.pnValue = *pNth;
+		pBegin = pNth;
+	}
+
+	aOutput.m_nMax = *std::max_element(pBegin, pEnd);
+}
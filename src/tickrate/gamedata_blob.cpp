@@ -0,0 +1,439 @@
+/**
+ * vim: set ts=4 sw=4 tw=99 noet :
+ * ======================================================
+ * Metamod:Source Tickrate
+ * Written by Wend4r (Vladimir Ezhikov).
+ * ======================================================
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <tickrate/gamedata_blob.hpp>
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include <vector>
+
+#ifdef _WIN32
+#	include <windows.h>
+#else
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <unistd.h>
+#endif
+
+Tickrate::GameDataBlob::GameDataBlob()
+ :  m_pData(nullptr),
+    m_nSize(0),
+    m_pHeader(nullptr),
+    m_pSources(nullptr),
+    m_pNodes(nullptr),
+    m_pSignatures(nullptr),
+    m_pAddresses(nullptr),
+    m_pOffsets(nullptr),
+    m_pPrologues(nullptr),
+    m_pBytes(nullptr),
+    m_pStrings(nullptr)
+#ifdef _WIN32
+    ,
+    m_hFile(INVALID_HANDLE_VALUE),
+    m_hMapping(NULL)
+#endif
+{
+}
+
+Tickrate::GameDataBlob::~GameDataBlob()
+{
+	Close();
+}
+
+bool Tickrate::GameDataBlob::Open(const char *pszFilename, const char *pszPlatform, char *error, size_t maxlen)
+{
+	Close();
+
+#ifdef _WIN32
+	HANDLE hFile = CreateFileA(pszFilename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+	if(hFile == INVALID_HANDLE_VALUE)
+	{
+		if(error && maxlen)
+		{
+			snprintf(error, maxlen, "Failed to open \"%s\"", pszFilename);
+		}
+
+		return false;
+	}
+
+	LARGE_INTEGER aSize;
+
+	if(!GetFileSizeEx(hFile, &aSize) || !aSize.QuadPart)
+	{
+		CloseHandle(hFile);
+
+		if(error && maxlen)
+		{
+			snprintf(error, maxlen, "Failed to get a size of \"%s\"", pszFilename);
+		}
+
+		return false;
+	}
+
+	HANDLE hMapping = CreateFileMappingA(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+
+	void *pView = hMapping ? MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+
+	if(!pView)
+	{
+		if(hMapping)
+		{
+			CloseHandle(hMapping);
+		}
+
+		CloseHandle(hFile);
+
+		if(error && maxlen)
+		{
+			snprintf(error, maxlen, "Failed to map \"%s\"", pszFilename);
+		}
+
+		return false;
+	}
+
+	m_hFile = hFile;
+	m_hMapping = hMapping;
+	m_pData = reinterpret_cast<const uint8_t *>(pView);
+	m_nSize = (size_t)aSize.QuadPart;
+#else
+	int iFile = open(pszFilename, O_RDONLY);
+
+	if(iFile < 0)
+	{
+		if(error && maxlen)
+		{
+			snprintf(error, maxlen, "Failed to open \"%s\"", pszFilename);
+		}
+
+		return false;
+	}
+
+	struct stat aStat;
+
+	if(fstat(iFile, &aStat) || aStat.st_size <= 0)
+	{
+		close(iFile);
+
+		if(error && maxlen)
+		{
+			snprintf(error, maxlen, "Failed to get a size of \"%s\"", pszFilename);
+		}
+
+		return false;
+	}
+
+	void *pView = mmap(nullptr, (size_t)aStat.st_size, PROT_READ, MAP_PRIVATE, iFile, 0);
+
+	close(iFile); // The mapping keeps a reference.
+
+	if(pView == MAP_FAILED)
+	{
+		if(error && maxlen)
+		{
+			snprintf(error, maxlen, "Failed to map \"%s\"", pszFilename);
+		}
+
+		return false;
+	}
+
+	m_pData = reinterpret_cast<const uint8_t *>(pView);
+	m_nSize = (size_t)aStat.st_size;
+#endif
+
+	// Validate.
+	{
+		const char *pszError = nullptr;
+
+		const auto *pHeader = reinterpret_cast<const Header_t *>(m_pData);
+
+		if(m_nSize < sizeof(Header_t) || pHeader->m_nMagic != TICKRATE_GAMEDATA_BLOB_MAGIC)
+		{
+			pszError = "not a gamedata blob";
+		}
+		else if(pHeader->m_nVersion != TICKRATE_GAMEDATA_BLOB_VERSION)
+		{
+			pszError = "version mismatch";
+		}
+		else if(strncmp(pHeader->m_sPlatform, pszPlatform, sizeof(pHeader->m_sPlatform)))
+		{
+			pszError = "platform mismatch";
+		}
+		else if((uint64_t)pHeader->m_nSourcesOffset + (uint64_t)pHeader->m_nSourceCount * sizeof(Source_t) > m_nSize || 
+		        (uint64_t)pHeader->m_nNodesOffset + (uint64_t)pHeader->m_nNodeCount * sizeof(Node_t) > m_nSize || 
+		        (uint64_t)pHeader->m_nSignaturesOffset + (uint64_t)pHeader->m_nSignatureCount * sizeof(Signature_t) > m_nSize || 
+		        (uint64_t)pHeader->m_nAddressesOffset + (uint64_t)pHeader->m_nAddressCount * sizeof(Address_t) > m_nSize || 
+		        (uint64_t)pHeader->m_nOffsetsOffset + (uint64_t)pHeader->m_nOffsetCount * sizeof(Offset_t) > m_nSize || 
+		        (uint64_t)pHeader->m_nProloguesOffset + (uint64_t)pHeader->m_nPrologueCount * sizeof(Prologue_t) > m_nSize || 
+		        (uint64_t)pHeader->m_nBytesOffset + pHeader->m_nBytesSize > m_nSize || 
+		        (uint64_t)pHeader->m_nStringsOffset + pHeader->m_nStringsSize > m_nSize || 
+		        !pHeader->m_nStringsSize || m_pData[pHeader->m_nStringsOffset + pHeader->m_nStringsSize - 1] != '\0')
+		{
+			pszError = "truncated";
+		}
+		else
+		{
+			const auto *pSources = reinterpret_cast<const Source_t *>(m_pData + pHeader->m_nSourcesOffset);
+			const auto *pNodes = reinterpret_cast<const Node_t *>(m_pData + pHeader->m_nNodesOffset);
+			const auto *pSignatures = reinterpret_cast<const Signature_t *>(m_pData + pHeader->m_nSignaturesOffset);
+			const auto *pPrologues = reinterpret_cast<const Prologue_t *>(m_pData + pHeader->m_nProloguesOffset);
+
+			auto funcIsInRange = [](const Range_t &aRange, uint32_t nCount)
+			{
+				return (uint64_t)aRange.m_nFirst + aRange.m_nCount <= nCount;
+			};
+
+			auto funcIsInBytes = [pHeader](uint32_t nBytes, uint32_t nLength)
+			{
+				return nLength && (uint64_t)nBytes + 2 * (uint64_t)nLength <= pHeader->m_nBytesSize;
+			};
+
+			for(uint32_t n = 0; n < pHeader->m_nSourceCount; n++)
+			{
+				const auto &aSource = pSources[n];
+
+				if(aSource.m_nRoot >= pHeader->m_nNodeCount)
+				{
+					pszError = "a source root out of the nodes";
+
+					break;
+				}
+
+				if(!funcIsInRange(aSource.m_aSignatures, pHeader->m_nSignatureCount) || 
+				   !funcIsInRange(aSource.m_aAddresses, pHeader->m_nAddressCount) || 
+				   !funcIsInRange(aSource.m_aOffsets, pHeader->m_nOffsetCount) || 
+				   !funcIsInRange(aSource.m_aPrologues, pHeader->m_nPrologueCount))
+				{
+					pszError = "a source index out of the range";
+
+					break;
+				}
+			}
+
+			for(uint32_t n = 0; !pszError && n < pHeader->m_nSignatureCount; n++)
+			{
+				if(!funcIsInBytes(pSignatures[n].m_nBytes, pSignatures[n].m_nLength))
+				{
+					pszError = "a signature out of the bytes";
+				}
+			}
+
+			for(uint32_t n = 0; !pszError && n < pHeader->m_nPrologueCount; n++)
+			{
+				if(!funcIsInBytes(pPrologues[n].m_nBytes, pPrologues[n].m_nLength))
+				{
+					pszError = "a prologue out of the bytes";
+				}
+			}
+
+			// Children follow their parent (breadth-first), so a walk can't recurse into itself.
+			for(uint32_t n = 0; !pszError && n < pHeader->m_nNodeCount; n++)
+			{
+				const auto &aNode = pNodes[n];
+
+				if(aNode.m_nType != NODE_ARRAY && aNode.m_nType != NODE_TABLE)
+				{
+					continue;
+				}
+
+				if(aNode.m_nFirst <= n || (uint64_t)aNode.m_nFirst + aNode.m_nCount > pHeader->m_nNodeCount)
+				{
+					pszError = "children of a node out of the range";
+				}
+			}
+		}
+
+		if(pszError)
+		{
+			if(error && maxlen)
+			{
+				snprintf(error, maxlen, "\"%s\": %s", pszFilename, pszError);
+			}
+
+			Close();
+
+			return false;
+		}
+
+		m_pHeader = pHeader;
+		m_pSources = reinterpret_cast<const Source_t *>(m_pData + pHeader->m_nSourcesOffset);
+		m_pNodes = reinterpret_cast<const Node_t *>(m_pData + pHeader->m_nNodesOffset);
+		m_pSignatures = reinterpret_cast<const Signature_t *>(m_pData + pHeader->m_nSignaturesOffset);
+		m_pAddresses = reinterpret_cast<const Address_t *>(m_pData + pHeader->m_nAddressesOffset);
+		m_pOffsets = reinterpret_cast<const Offset_t *>(m_pData + pHeader->m_nOffsetsOffset);
+		m_pPrologues = reinterpret_cast<const Prologue_t *>(m_pData + pHeader->m_nProloguesOffset);
+		m_pBytes = m_pData + pHeader->m_nBytesOffset;
+		m_pStrings = reinterpret_cast<const char *>(m_pData + pHeader->m_nStringsOffset);
+	}
+
+	return true;
+}
+
+void Tickrate::GameDataBlob::Close()
+{
+	if(m_pData)
+	{
+#ifdef _WIN32
+		UnmapViewOfFile(m_pData);
+		CloseHandle(m_hMapping);
+		CloseHandle(m_hFile);
+
+		m_hMapping = NULL;
+		m_hFile = INVALID_HANDLE_VALUE;
+#else
+		munmap(const_cast<uint8_t *>(m_pData), m_nSize);
+#endif
+	}
+
+	m_pData = nullptr;
+	m_nSize = 0;
+	m_pHeader = nullptr;
+	m_pSources = nullptr;
+	m_pNodes = nullptr;
+	m_pSignatures = nullptr;
+	m_pAddresses = nullptr;
+	m_pOffsets = nullptr;
+	m_pPrologues = nullptr;
+	m_pBytes = nullptr;
+	m_pStrings = nullptr;
+}
+
+bool Tickrate::GameDataBlob::IsOpen() const
+{
+	return m_pHeader != nullptr;
+}
+
+bool Tickrate::GameDataBlob::IsFresh(const Source_t &aSource, const char *pszSourceFile)
+{
+	struct stat aStat;
+
+	if(stat(pszSourceFile, &aStat))
+	{
+		return true;
+	}
+
+	if((uint64_t)aStat.st_size != aSource.m_nSize)
+	{
+		return false;
+	}
+
+	if((int64_t)aStat.st_mtime == aSource.m_nModificationTime)
+	{
+		return true;
+	}
+
+	// Touched (e.g. by a deploy), compare the content.
+	FILE *pFile = fopen(pszSourceFile, "rb");
+
+	if(!pFile)
+	{
+		return false;
+	}
+
+	std::vector<uint8_t> vecContent((size_t)aStat.st_size);
+
+	bool bRead = fread(vecContent.data(), 1, vecContent.size(), pFile) == vecContent.size();
+
+	fclose(pFile);
+
+	return bRead && Hash(vecContent.data(), vecContent.size()) == aSource.m_nHash;
+}
+
+uint64_t Tickrate::GameDataBlob::Hash(const void *pData, size_t nSize, uint64_t nHash)
+{
+	const auto *pBytes = reinterpret_cast<const uint8_t *>(pData);
+
+	for(size_t n = 0; n < nSize; n++)
+	{
+		nHash ^= pBytes[n];
+		nHash *= 0x100000001B3ull;
+	}
+
+	return nHash;
+}
+
+int Tickrate::GameDataBlob::GetSourceCount() const
+{
+	return m_pHeader ? (int)m_pHeader->m_nSourceCount : 0;
+}
+
+const Tickrate::GameDataBlob::Source_t &Tickrate::GameDataBlob::GetSource(int iIndex) const
+{
+	return m_pSources[iIndex];
+}
+
+int Tickrate::GameDataBlob::FindSource(const char *pszName) const
+{
+	size_t nLength = strlen(pszName);
+
+	bool bWildcard = nLength && pszName[nLength - 1] == '*';
+
+	for(int i = 0, iCount = GetSourceCount(); i < iCount; i++)
+	{
+		const char *pszSourceName = GetString(m_pSources[i].m_nName);
+
+		if(bWildcard ? !strncmp(pszSourceName, pszName, nLength - 1) : !strcmp(pszSourceName, pszName))
+		{
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+const Tickrate::GameDataBlob::Node_t &Tickrate::GameDataBlob::GetNode(uint32_t nIndex) const
+{
+	static const Node_t s_aNullNode = {NODE_NULL, TICKRATE_GAMEDATA_BLOB_INVALID_INDEX, TICKRATE_GAMEDATA_BLOB_INVALID_INDEX, 0, {}};
+
+	return m_pHeader && nIndex < m_pHeader->m_nNodeCount ? m_pNodes[nIndex] : s_aNullNode;
+}
+
+const char *Tickrate::GameDataBlob::GetString(uint32_t nOffset) const
+{
+	return nOffset < m_pHeader->m_nStringsSize ? &m_pStrings[nOffset] : "";
+}
+
+const Tickrate::GameDataBlob::Signature_t &Tickrate::GameDataBlob::GetSignature(uint32_t nIndex) const
+{
+	return m_pSignatures[nIndex];
+}
+
+const Tickrate::GameDataBlob::Address_t &Tickrate::GameDataBlob::GetAddress(uint32_t nIndex) const
+{
+	return m_pAddresses[nIndex];
+}
+
+const Tickrate::GameDataBlob::Offset_t &Tickrate::GameDataBlob::GetOffset(uint32_t nIndex) const
+{
+	return m_pOffsets[nIndex];
+}
+
+const Tickrate::GameDataBlob::Prologue_t &Tickrate::GameDataBlob::GetPrologue(uint32_t nIndex) const
+{
+	return m_pPrologues[nIndex];
+}
+
+const uint8_t *Tickrate::GameDataBlob::GetBytes(uint32_t nOffset) const
+{
+	return &m_pBytes[nOffset];
+}
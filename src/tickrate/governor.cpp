@@ -0,0 +1,153 @@
+/**
+ * vim: set ts=4 sw=4 tw=99 noet :
+ * ======================================================
+ * Metamod:Source Tickrate
+ * Written by Wend4r (Vladimir Ezhikov).
+ * ======================================================
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <tickrate/governor.hpp>
+
+#include <algorithm>
+#include <functional>
+
+Tickrate::Governor::Governor()
+ :  m_aSettings({{128, 102, 85, 64}, 30.0, 1.0, 60.0, 0.75}),
+    m_dblNextThink(0.0),
+    m_nLastDecision(0)
+{
+}
+
+const Tickrate::Governor::Settings_t &Tickrate::Governor::GetSettings() const
+{
+	return m_aSettings;
+}
+
+void Tickrate::Governor::SetSettings(const Settings_t &aSettings)
+{
+	m_aSettings = aSettings;
+
+	auto &vecLadder = m_aSettings.m_vecLadder;
+
+	std::sort(vecLadder.begin(), vecLadder.end(), std::greater<int>());
+	vecLadder.erase(std::unique(vecLadder.begin(), vecLadder.end()), vecLadder.end());
+
+	Reset();
+}
+
+void Tickrate::Governor::Reset()
+{
+	m_dblNextThink = 0.0;
+	m_nLastDecision = 0;
+}
+
+int Tickrate::Governor::Think(double dblNow, int nCurrent, int nCeiling, const FrameProfiler &aProfiler)
+{
+	if(dblNow < m_dblNextThink || nCurrent <= 0)
+	{
+		return 0;
+	}
+
+	m_dblNextThink = dblNow + 1.0;
+
+	// The profiler resets on every change, so this is also a dwell time.
+	uint32_t nFrames = aProfiler.GetFrameCount();
+
+	int nWindowFrames = std::min((int)(m_aSettings.m_dblWindow * nCurrent), TICKRATE_FRAME_PROFILER_SAMPLE_COUNT);
+
+	if(nFrames < (uint32_t)nWindowFrames)
+	{
+		return 0;
+	}
+
+	FrameProfiler::Stats_t aStats;
+
+	int nLower = GetLower(nCurrent);
+
+	if(nLower && aProfiler.Compute(aStats, 1.0 / nCurrent, 0.0, nWindowFrames, m_aBuffers))
+	{
+		if(GetPercentile95(aStats) > aStats.m_nBudget * m_aSettings.m_dblOverrunRatio)
+		{
+			return m_nLastDecision = nLower;
+		}
+	}
+
+	int nHigher = GetHigher(nCurrent, nCeiling);
+
+	int nRecoverFrames = std::min((int)(m_aSettings.m_dblRecoverWindow * nCurrent), TICKRATE_FRAME_PROFILER_SAMPLE_COUNT);
+
+	if(nHigher && nFrames >= (uint32_t)nRecoverFrames && aProfiler.Compute(aStats, 1.0 / nCurrent, 0.0, nRecoverFrames, m_aBuffers))
+	{
+		// Hysteresis: the frame time must fit a budget of the higher tickrate with a margin.
+		if(GetPercentile95(aStats) < 1000000.0 / nHigher * m_aSettings.m_dblRecoverRatio)
+		{
+			return m_nLastDecision = nHigher;
+		}
+	}
+
+	return 0;
+}
+
+double Tickrate::Governor::GetMaxWindow(int nTickrate)
+{
+	return nTickrate > 0 ? (double)TICKRATE_FRAME_PROFILER_SAMPLE_COUNT / nTickrate : 0.0;
+}
+
+int Tickrate::Governor::GetLower(int nCurrent) const
+{
+	for(int nStep : m_aSettings.m_vecLadder)
+	{
+		if(nStep < nCurrent)
+		{
+			return nStep;
+		}
+	}
+
+	return 0;
+}
+
+int Tickrate::Governor::GetHigher(int nCurrent, int nCeiling) const
+{
+	if(nCurrent >= nCeiling)
+	{
+		return 0;
+	}
+
+	const auto &vecLadder = m_aSettings.m_vecLadder;
+
+	for(auto it = vecLadder.crbegin(); it != vecLadder.crend(); it++)
+	{
+		int nStep = *it;
+
+		if(nStep > nCurrent)
+		{
+			return std::min(nStep, nCeiling);
+		}
+	}
+
+	return nCeiling;
+}
+
+int Tickrate::Governor::GetLastDecision() const
+{
+	return m_nLastDecision;
+}
+
+uint32_t Tickrate::Governor::GetPercentile95(const FrameProfiler::Stats_t &aStats)
+{
+	// Prefer the compute time: the wall time is paced to the budget by the engine sleep.
+	return aStats.m_nComputeSamples ? aStats.m_aComputeTime.m_nP95 : aStats.m_aWallTime.m_nP95;
+}
@@ -0,0 +1,488 @@
+/**
+ * vim: set ts=4 sw=4 tw=99 noet :
+ * ======================================================
+ * Metamod:Source Tickrate
+ * Written by Wend4r (Vladimir Ezhikov).
+ * ======================================================
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <tickrate/host_arbiter.hpp>
+
+#include <stdio.h>
+#include <string.h>
+
+#include <atomic>
+#include <chrono>
+#include <random>
+
+#ifndef _WIN32
+#	include <errno.h>
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <time.h>
+#	include <unistd.h>
+#endif
+
+#define TICKRATE_HOST_ARBITER_READ_RETRIES 16
+
+// Relaxed payload, ordered by the sequence: odd while writing.
+struct alignas(64) Tickrate::HostArbiter::Slot_t
+{
+	std::atomic<uint64_t> m_nOwner; // A token, otherwise 0.
+	std::atomic<uint32_t> m_nSequence;
+
+	std::atomic<int64_t> m_nHeartbeat;
+	std::atomic<int32_t> m_nTickrate;
+	std::atomic<int32_t> m_nHumans;
+	std::atomic<uint32_t> m_nTickCost;
+	std::atomic<uint32_t> m_nFlags;
+};
+
+struct Tickrate::HostArbiter::Segment_t
+{
+	std::atomic<uint32_t> m_nMagic; // 0 of a new one, it's zero-filled.
+	Slot_t m_aSlots[TICKRATE_HOST_ARBITER_SLOT_COUNT];
+};
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free && std::atomic<uint64_t>::is_always_lock_free && std::atomic<int64_t>::is_always_lock_free, "Shared between processes");
+
+Tickrate::HostArbiter::HostArbiter()
+ :  m_pSegment(nullptr),
+    m_iSlot(-1),
+    m_nToken(MakeToken()),
+    m_aSettings({0.85, 0.15, 10.0, 5.0}),
+    m_dblNextThink(0.0),
+    m_dblCooldownUntil(0.0),
+    m_nLastCpuBusy(0),
+    m_nLastCpuTotal(0),
+    m_dblCpuUsage(-1.0)
+{
+}
+
+Tickrate::HostArbiter::~HostArbiter()
+{
+	Close();
+}
+
+const Tickrate::HostArbiter::Settings_t &Tickrate::HostArbiter::GetSettings() const
+{
+	return m_aSettings;
+}
+
+void Tickrate::HostArbiter::SetSettings(const Settings_t &aSettings)
+{
+	m_aSettings = aSettings;
+}
+
+bool Tickrate::HostArbiter::Open(const char *pszName, char *error, size_t maxlen)
+{
+	Close();
+
+#ifdef _WIN32
+	if(error && maxlen)
+	{
+		strncpy(error, "The host arbiter is not supported on this platform", maxlen);
+	}
+
+	return false;
+#else
+	int iFile = shm_open(pszName, O_CREAT | O_RDWR, 0660);
+
+	if(iFile == -1)
+	{
+		if(error && maxlen)
+		{
+			snprintf(error, maxlen, "Failed to open \"%s\" shared memory: %s", pszName, strerror(errno));
+		}
+
+		return false;
+	}
+
+	struct stat aStat;
+
+	// A new one is sized by the first instance, growing is zero-filled.
+	if(fstat(iFile, &aStat) || ((size_t)aStat.st_size < sizeof(Segment_t) && ftruncate(iFile, sizeof(Segment_t))))
+	{
+		if(error && maxlen)
+		{
+			snprintf(error, maxlen, "Failed to size \"%s\" shared memory: %s", pszName, strerror(errno));
+		}
+
+		close(iFile);
+
+		return false;
+	}
+
+	void *pBase = mmap(nullptr, sizeof(Segment_t), PROT_READ | PROT_WRITE, MAP_SHARED, iFile, 0);
+
+	close(iFile); // The mapping keeps it.
+
+	if(pBase == MAP_FAILED)
+	{
+		if(error && maxlen)
+		{
+			snprintf(error, maxlen, "Failed to map \"%s\" shared memory: %s", pszName, strerror(errno));
+		}
+
+		return false;
+	}
+
+	m_pSegment = reinterpret_cast<Segment_t *>(pBase);
+
+	uint32_t nMagic = 0;
+
+	if(!m_pSegment->m_nMagic.compare_exchange_strong(nMagic, TICKRATE_HOST_ARBITER_MAGIC) && nMagic != TICKRATE_HOST_ARBITER_MAGIC)
+	{
+		if(error && maxlen)
+		{
+			snprintf(error, maxlen, "\"%s\" shared memory is of another layout (%08X)", pszName, nMagic);
+		}
+
+		Close();
+
+		return false;
+	}
+
+	if(!Claim())
+	{
+		if(error && maxlen)
+		{
+			snprintf(error, maxlen, "No free slot of \"%s\" shared memory, %d instances are live", pszName, TICKRATE_HOST_ARBITER_SLOT_COUNT);
+		}
+
+		Close();
+
+		return false;
+	}
+
+	m_dblNextThink = 0.0;
+	m_dblCooldownUntil = 0.0;
+	m_nLastCpuBusy = m_nLastCpuTotal = 0;
+	m_dblCpuUsage = -1.0;
+
+	return true;
+#endif
+}
+
+void Tickrate::HostArbiter::Close()
+{
+#ifndef _WIN32
+	if(!m_pSegment)
+	{
+		return;
+	}
+
+	if(m_iSlot != -1)
+	{
+		uint64_t nOwner = m_nToken;
+
+		m_pSegment->m_aSlots[m_iSlot].m_nOwner.compare_exchange_strong(nOwner, 0);
+		m_iSlot = -1;
+	}
+
+	// Not unlinked, the others keep using it.
+	munmap(m_pSegment, sizeof(Segment_t));
+	m_pSegment = nullptr;
+#endif
+}
+
+bool Tickrate::HostArbiter::IsOpen() const
+{
+	return m_pSegment != nullptr;
+}
+
+int Tickrate::HostArbiter::GetSlot() const
+{
+	return m_iSlot;
+}
+
+bool Tickrate::HostArbiter::ShouldThink(double dblNow) const
+{
+	return m_pSegment && dblNow >= m_dblNextThink;
+}
+
+int Tickrate::HostArbiter::Think(double dblNow, const Instance_t &aSelf)
+{
+	if(!ShouldThink(dblNow))
+	{
+		return 0;
+	}
+
+	m_dblNextThink = dblNow + 1.0;
+
+	if(!Publish(aSelf))
+	{
+		return 0;
+	}
+
+	double dblUsage = SampleCpuUsage();
+
+	if(dblUsage < 0.0 || dblNow < m_dblCooldownUntil)
+	{
+		return 0;
+	}
+
+	bool bOver = dblUsage > m_aSettings.m_dblCpuBudget,
+	     bUnder = dblUsage < m_aSettings.m_dblCpuBudget - m_aSettings.m_dblHysteresis;
+
+	if(!bOver && !bUnder)
+	{
+		return 0;
+	}
+
+	Instance_t aInstances[TICKRATE_HOST_ARBITER_SLOT_COUNT];
+
+	int nCount = Collect(aInstances, TICKRATE_HOST_ARBITER_SLOT_COUNT);
+
+	// Every instance picks the same one: the least populated to lower, the most populated to raise.
+	const Instance_t *pChosen = nullptr;
+
+	for(int n = 0; n < nCount; n++)
+	{
+		const auto &aInstance = aInstances[n];
+
+		if(!(aInstance.m_nFlags & (bOver ? INSTANCE_CAN_LOWER : INSTANCE_CAN_RAISE)))
+		{
+			continue;
+		}
+
+		if(!pChosen ||
+		   (bOver ? aInstance.m_nHumans < pChosen->m_nHumans : aInstance.m_nHumans > pChosen->m_nHumans) ||
+		   (aInstance.m_nHumans == pChosen->m_nHumans && aInstance.m_nToken < pChosen->m_nToken))
+		{
+			pChosen = &aInstance;
+		}
+	}
+
+	if(!pChosen)
+	{
+		return 0;
+	}
+
+	m_dblCooldownUntil = dblNow + m_aSettings.m_dblCooldown;
+
+	return pChosen->m_nToken == m_nToken ? (bOver ? -1 : 1) : 0;
+}
+
+int Tickrate::HostArbiter::Collect(Instance_t *pOutput, int nMaxCount) const
+{
+	if(!m_pSegment)
+	{
+		return 0;
+	}
+
+	int64_t nNow = Now();
+
+	int nCount = 0;
+
+	for(const auto &aSlot : m_pSegment->m_aSlots)
+	{
+		if(nCount >= nMaxCount)
+		{
+			break;
+		}
+
+		int64_t nHeartbeat;
+
+		if(aSlot.m_nOwner.load(std::memory_order_acquire) && !IsExpired(aSlot, nNow) && Read(aSlot, pOutput[nCount], nHeartbeat))
+		{
+			nCount++;
+		}
+	}
+
+	return nCount;
+}
+
+double Tickrate::HostArbiter::GetCpuUsage() const
+{
+	return m_dblCpuUsage;
+}
+
+bool Tickrate::HostArbiter::Claim()
+{
+	int64_t nNow = Now();
+
+	auto &aSlots = m_pSegment->m_aSlots;
+
+	// Own one first, of a reopen.
+	for(int i = 0; i < TICKRATE_HOST_ARBITER_SLOT_COUNT; i++)
+	{
+		if(aSlots[i].m_nOwner.load(std::memory_order_acquire) == m_nToken)
+		{
+			m_iSlot = i;
+
+			return true;
+		}
+	}
+
+	for(int i = 0; i < TICKRATE_HOST_ARBITER_SLOT_COUNT; i++)
+	{
+		auto &aSlot = aSlots[i];
+
+		uint64_t nOwner = aSlot.m_nOwner.load(std::memory_order_acquire);
+
+		if(nOwner && !IsExpired(aSlot, nNow))
+		{
+			continue;
+		}
+
+		if(aSlot.m_nOwner.compare_exchange_strong(nOwner, m_nToken))
+		{
+			// A crash could leave it odd.
+			aSlot.m_nSequence.store(0, std::memory_order_relaxed);
+			aSlot.m_nHeartbeat.store(nNow, std::memory_order_release);
+
+			m_iSlot = i;
+
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool Tickrate::HostArbiter::Publish(const Instance_t &aSelf)
+{
+	// A stall over the expiry (e.g. a map load) lets another instance claim the slot.
+	if(m_iSlot == -1 || m_pSegment->m_aSlots[m_iSlot].m_nOwner.load(std::memory_order_acquire) != m_nToken)
+	{
+		m_iSlot = -1;
+
+		if(!Claim())
+		{
+			return false;
+		}
+	}
+
+	auto &aSlot = m_pSegment->m_aSlots[m_iSlot];
+
+	uint32_t nSequence = aSlot.m_nSequence.load(std::memory_order_relaxed);
+
+	aSlot.m_nSequence.store(nSequence + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	aSlot.m_nHeartbeat.store(Now(), std::memory_order_relaxed);
+	aSlot.m_nTickrate.store(aSelf.m_nTickrate, std::memory_order_relaxed);
+	aSlot.m_nHumans.store(aSelf.m_nHumans, std::memory_order_relaxed);
+	aSlot.m_nTickCost.store(aSelf.m_nTickCost, std::memory_order_relaxed);
+	aSlot.m_nFlags.store(aSelf.m_nFlags, std::memory_order_relaxed);
+
+	aSlot.m_nSequence.store(nSequence + 2, std::memory_order_release);
+
+	return true;
+}
+
+bool Tickrate::HostArbiter::Read(const Slot_t &aSlot, Instance_t &aOutput, int64_t &nHeartbeat) const
+{
+	for(int n = 0; n < TICKRATE_HOST_ARBITER_READ_RETRIES; n++)
+	{
+		uint32_t nSequence = aSlot.m_nSequence.load(std::memory_order_acquire);
+
+		if(nSequence & 1)
+		{
+			continue;
+		}
+
+		aOutput.m_nToken = aSlot.m_nOwner.load(std::memory_order_relaxed);
+		aOutput.m_nTickrate = aSlot.m_nTickrate.load(std::memory_order_relaxed);
+		aOutput.m_nHumans = aSlot.m_nHumans.load(std::memory_order_relaxed);
+		aOutput.m_nTickCost = aSlot.m_nTickCost.load(std::memory_order_relaxed);
+		aOutput.m_nFlags = aSlot.m_nFlags.load(std::memory_order_relaxed);
+		nHeartbeat = aSlot.m_nHeartbeat.load(std::memory_order_relaxed);
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+
+		if(aSlot.m_nSequence.load(std::memory_order_relaxed) == nSequence)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool Tickrate::HostArbiter::IsExpired(const Slot_t &aSlot, int64_t nNow) const
+{
+	// Only by the heartbeat: a process of another PID namespace is not seen from here.
+	return nNow - aSlot.m_nHeartbeat.load(std::memory_order_acquire) > (int64_t)(m_aSettings.m_dblExpiry * 1000000000.0);
+}
+
+double Tickrate::HostArbiter::SampleCpuUsage()
+{
+#ifdef _WIN32
+	return -1.0;
+#else
+	FILE *pFile = fopen("/proc/stat", "r");
+
+	if(!pFile)
+	{
+		return -1.0;
+	}
+
+	unsigned long long nUser = 0, nNice = 0, nSystem = 0, nIdle = 0, nIOWait = 0, nIRQ = 0, nSoftIRQ = 0, nSteal = 0;
+
+	int iRead = fscanf(pFile, "cpu %llu %llu %llu %llu %llu %llu %llu %llu", &nUser, &nNice, &nSystem, &nIdle, &nIOWait, &nIRQ, &nSoftIRQ, &nSteal);
+
+	fclose(pFile);
+
+	if(iRead < 4)
+	{
+		return -1.0;
+	}
+
+	uint64_t nBusy = nUser + nNice + nSystem + nIRQ + nSoftIRQ + nSteal,
+	         nTotal = nBusy + nIdle + nIOWait;
+
+	uint64_t nLastBusy = m_nLastCpuBusy,
+	         nLastTotal = m_nLastCpuTotal;
+
+	m_nLastCpuBusy = nBusy;
+	m_nLastCpuTotal = nTotal;
+
+	if(!nLastTotal || nTotal <= nLastTotal || nBusy < nLastBusy) // The first sample.
+	{
+		return m_dblCpuUsage = -1.0;
+	}
+
+	return m_dblCpuUsage = (double)(nBusy - nLastBusy) / (nTotal - nLastTotal);
+#endif
+}
+
+int64_t Tickrate::HostArbiter::Now()
+{
+#ifdef _WIN32
+	return 0;
+#else
+	struct timespec aTime;
+
+	clock_gettime(CLOCK_MONOTONIC, &aTime);
+
+	return (int64_t)aTime.tv_sec * 1000000000 + aTime.tv_nsec;
+#endif
+}
+
+uint64_t Tickrate::HostArbiter::MakeToken()
+{
+	std::random_device aDevice;
+
+	uint64_t nToken = ((uint64_t)aDevice() << 32) ^ aDevice();
+
+	// Mixed with the clock when the device is a deterministic fallback.
+	nToken ^= (uint64_t)std::chrono::high_resolution_clock::now().time_since_epoch().count() * 0x9E3779B97F4A7C15ull;
+
+	return nToken ? nToken : 1;
+}
@@ -0,0 +1,116 @@
+/**
+ * vim: set ts=4 sw=4 tw=99 noet :
+ * ======================================================
+ * Metamod:Source Tickrate
+ * Written by Wend4r (Vladimir Ezhikov).
+ * ======================================================
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <tickrate/map_profiles.hpp>
+
+#include <ctype.h>
+
+const std::vector<Tickrate::MapProfiles::Profile_t> &Tickrate::MapProfiles::GetProfiles() const
+{
+	return m_vecProfiles;
+}
+
+void Tickrate::MapProfiles::SetProfiles(const std::vector<Profile_t> &vecProfiles)
+{
+	m_vecProfiles = vecProfiles;
+}
+
+const Tickrate::MapProfiles::Profile_t *Tickrate::MapProfiles::Find(const char *pszMap, const char *pszWorkshop, const char *pszGameMode) const
+{
+	for(const auto &aProfile : m_vecProfiles)
+	{
+		const struct
+		{
+			const std::string *psPattern;
+			const char *pszText;
+		} aKeys[] =
+		{
+			{
+				&aProfile.m_sMap,
+				pszMap
+			},
+			{
+				&aProfile.m_sWorkshop,
+				pszWorkshop
+			},
+			{
+				&aProfile.m_sGameMode,
+				pszGameMode
+			},
+		};
+
+		bool bMatched = true;
+
+		for(const auto &aKey : aKeys)
+		{
+			if(!aKey.psPattern->empty() && !Match(aKey.psPattern->c_str(), aKey.pszText ? aKey.pszText : ""))
+			{
+				bMatched = false;
+
+				break;
+			}
+		}
+
+		if(bMatched)
+		{
+			return &aProfile;
+		}
+	}
+
+	return nullptr;
+}
+
+bool Tickrate::MapProfiles::Match(const char *pszPattern, const char *pszText)
+{
+	const char *pszStar = nullptr, 
+	           *pszStarText = nullptr;
+
+	// Greedy with a backtrack to the last star.
+	while(*pszText)
+	{
+		if(*pszPattern == '*')
+		{
+			pszStar = pszPattern++;
+			pszStarText = pszText;
+		}
+		else if(*pszPattern == '?' || tolower((unsigned char)*pszPattern) == tolower((unsigned char)*pszText))
+		{
+			pszPattern++;
+			pszText++;
+		}
+		else if(pszStar)
+		{
+			pszPattern = pszStar + 1;
+			pszText = ++pszStarText;
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	while(*pszPattern == '*')
+	{
+		pszPattern++;
+	}
+
+	return !*pszPattern;
+}
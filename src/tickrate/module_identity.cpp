@@ -0,0 +1,220 @@
+/**
+ * vim: set ts=4 sw=4 tw=99 noet :
+ * ======================================================
+ * Metamod:Source Tickrate
+ * Written by Wend4r (Vladimir Ezhikov).
+ * ======================================================
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <tickrate/module_identity.hpp>
+
+#include <stdio.h>
+#include <string.h>
+
+#ifdef _WIN32
+#	include <windows.h>
+#else
+#	include <dlfcn.h>
+#	include <link.h>
+#endif
+
+#ifndef _WIN32
+namespace
+{
+	struct PhdrSearch_t
+	{
+		uintptr_t m_nAddress;
+		Tickrate::ModuleIdentity *m_pOutput;
+		bool m_bFound;
+	};
+
+	int OnPhdr(struct dl_phdr_info *pInfo, size_t, void *pData)
+	{
+		auto *pSearch = reinterpret_cast<PhdrSearch_t *>(pData);
+
+		uintptr_t nBase = (uintptr_t)pInfo->dlpi_addr, 
+		          nEnd = nBase;
+
+		bool bContains = false;
+
+		for(ElfW(Half) n = 0; n < pInfo->dlpi_phnum; n++)
+		{
+			const auto &aHeader = pInfo->dlpi_phdr[n];
+
+			if(aHeader.p_type != PT_LOAD)
+			{
+				continue;
+			}
+
+			uintptr_t nSegmentBegin = nBase + aHeader.p_vaddr, 
+			          nSegmentEnd = nSegmentBegin + aHeader.p_memsz;
+
+			if(nSegmentBegin <= pSearch->m_nAddress && pSearch->m_nAddress < nSegmentEnd)
+			{
+				bContains = true;
+			}
+
+			if(nEnd < nSegmentEnd)
+			{
+				nEnd = nSegmentEnd;
+			}
+		}
+
+		if(!bContains)
+		{
+			return 0;
+		}
+
+		auto *pOutput = pSearch->m_pOutput;
+
+		for(ElfW(Half) n = 0; n < pInfo->dlpi_phnum && pOutput->m_nSegmentCount < TICKRATE_MODULE_IDENTITY_MAX_SEGMENTS; n++)
+		{
+			const auto &aHeader = pInfo->dlpi_phdr[n];
+
+			if(aHeader.p_type == PT_LOAD)
+			{
+				pOutput->m_aSegments[pOutput->m_nSegmentCount++] = {nBase + aHeader.p_vaddr, aHeader.p_memsz, (aHeader.p_flags & PF_X) != 0, (aHeader.p_flags & PF_W) != 0};
+			}
+		}
+
+		for(ElfW(Half) n = 0; n < pInfo->dlpi_phnum; n++)
+		{
+			const auto &aHeader = pInfo->dlpi_phdr[n];
+
+			if(aHeader.p_type == PT_GNU_EH_FRAME)
+			{
+				pOutput->m_nUnwindTable = nBase + aHeader.p_vaddr;
+				pOutput->m_nUnwindTableSize = aHeader.p_memsz;
+
+				break;
+			}
+		}
+
+		pOutput->m_nBase = nBase;
+		pOutput->m_nSize = nEnd - nBase;
+
+		for(ElfW(Half) n = 0; n < pInfo->dlpi_phnum; n++)
+		{
+			const auto &aHeader = pInfo->dlpi_phdr[n];
+
+			if(aHeader.p_type != PT_NOTE)
+			{
+				continue;
+			}
+
+			const uint8_t *pNote = reinterpret_cast<const uint8_t *>(nBase + aHeader.p_vaddr), 
+			              *pNotesEnd = pNote + aHeader.p_memsz;
+
+			while(pNote + sizeof(ElfW(Nhdr)) <= pNotesEnd)
+			{
+				const auto *pNoteHeader = reinterpret_cast<const ElfW(Nhdr) *>(pNote);
+
+				const uint8_t *pName = pNote + sizeof(ElfW(Nhdr)), 
+				              *pDesc = pName + ((pNoteHeader->n_namesz + 3) & ~3);
+
+				if(pNoteHeader->n_type == NT_GNU_BUILD_ID && pNoteHeader->n_namesz == 4 && !memcmp(pName, "GNU", 4))
+				{
+					size_t nLength = pNoteHeader->n_descsz;
+
+					if(nLength * 2 > TICKRATE_MODULE_IDENTITY_MAX_LENGTH)
+					{
+						nLength = TICKRATE_MODULE_IDENTITY_MAX_LENGTH / 2;
+					}
+
+					for(size_t i = 0; i < nLength; i++)
+					{
+						snprintf(&pOutput->m_sBuildID[i * 2], 3, "%02x", pDesc[i]);
+					}
+
+					pSearch->m_bFound = true;
+
+					return 1;
+				}
+
+				pNote = pDesc + ((pNoteHeader->n_descsz + 3) & ~3);
+			}
+		}
+
+		pSearch->m_bFound = true; // No build ID, a range only.
+
+		return 1;
+	}
+};
+#endif
+
+bool Tickrate::ModuleIdentity::Resolve(const void *pAddressInside)
+{
+	*this = {};
+
+	if(!pAddressInside)
+	{
+		return false;
+	}
+
+#ifdef _WIN32
+	HMODULE hModule = NULL;
+
+	if(!GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT, reinterpret_cast<LPCSTR>(pAddressInside), &hModule))
+	{
+		return false;
+	}
+
+	const auto *pDOSHeader = reinterpret_cast<const IMAGE_DOS_HEADER *>(hModule);
+	const auto *pNTHeaders = reinterpret_cast<const IMAGE_NT_HEADERS *>(reinterpret_cast<const uint8_t *>(hModule) + pDOSHeader->e_lfanew);
+
+	m_nBase = reinterpret_cast<uintptr_t>(hModule);
+	m_nSize = pNTHeaders->OptionalHeader.SizeOfImage;
+	snprintf(m_sBuildID, sizeof(m_sBuildID), "%08lx%08lx", (unsigned long)pNTHeaders->FileHeader.TimeDateStamp, (unsigned long)pNTHeaders->OptionalHeader.SizeOfImage);
+
+	const auto &aExceptionDirectory = pNTHeaders->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_EXCEPTION];
+
+	if(aExceptionDirectory.VirtualAddress && aExceptionDirectory.Size)
+	{
+		m_nUnwindTable = m_nBase + aExceptionDirectory.VirtualAddress;
+		m_nUnwindTableSize = aExceptionDirectory.Size;
+	}
+
+	const auto *pSection = IMAGE_FIRST_SECTION(pNTHeaders);
+
+	for(WORD n = 0; n < pNTHeaders->FileHeader.NumberOfSections && m_nSegmentCount < TICKRATE_MODULE_IDENTITY_MAX_SEGMENTS; n++, pSection++)
+	{
+		m_aSegments[m_nSegmentCount++] = {m_nBase + pSection->VirtualAddress, pSection->Misc.VirtualSize, (pSection->Characteristics & IMAGE_SCN_MEM_EXECUTE) != 0, (pSection->Characteristics & IMAGE_SCN_MEM_WRITE) != 0};
+	}
+#else
+	PhdrSearch_t aSearch {reinterpret_cast<uintptr_t>(pAddressInside), this, false};
+
+	dl_iterate_phdr(OnPhdr, &aSearch);
+
+	if(!aSearch.m_bFound)
+	{
+		return false;
+	}
+#endif
+
+	return IsValid();
+}
+
+bool Tickrate::ModuleIdentity::IsValid() const
+{
+	return m_nBase && m_sBuildID[0];
+}
+
+bool Tickrate::ModuleIdentity::Contains(const void *pAddress) const
+{
+	uintptr_t nAddress = reinterpret_cast<uintptr_t>(pAddress);
+
+	return m_nBase <= nAddress && nAddress < m_nBase + m_nSize;
+}
@@ -0,0 +1,77 @@
+/**
+ * vim: set ts=4 sw=4 tw=99 noet :
+ * ======================================================
+ * Metamod:Source Tickrate
+ * Written by Wend4r (Vladimir Ezhikov).
+ * ======================================================
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <tickrate/network_profile.hpp>
+
+#include <algorithm>
+
+Tickrate::NetworkProfile::NetworkProfile()
+{
+}
+
+const std::vector<Tickrate::NetworkProfile::Tier_t> &Tickrate::NetworkProfile::GetTiers() const
+{
+	return m_vecTiers;
+}
+
+void Tickrate::NetworkProfile::SetTiers(const std::vector<Tier_t> &vecTiers)
+{
+	m_vecTiers = vecTiers;
+
+	std::sort(m_vecTiers.begin(), m_vecTiers.end(), [](const Tier_t &aLeft, const Tier_t &aRight)
+	{
+		return aLeft.m_nTickrate < aRight.m_nTickrate;
+	});
+}
+
+bool Tickrate::NetworkProfile::Resolve(int nTickrate, Tier_t &aOutput) const
+{
+	if(m_vecTiers.empty() || nTickrate <= 0)
+	{
+		return false;
+	}
+
+	const Tier_t *pFound = &m_vecTiers.front();
+
+	for(const auto &aTier : m_vecTiers)
+	{
+		if(aTier.m_nTickrate > nTickrate)
+		{
+			break;
+		}
+
+		pFound = &aTier;
+	}
+
+	aOutput = *pFound;
+
+	if(aOutput.m_nUpdateRate <= 0)
+	{
+		aOutput.m_nUpdateRate = nTickrate;
+	}
+
+	if(aOutput.m_flInterp <= 0.0f)
+	{
+		aOutput.m_flInterp = aOutput.m_flInterpRatio / aOutput.m_nUpdateRate;
+	}
+
+	return true;
+}
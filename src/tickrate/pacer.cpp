@@ -0,0 +1,190 @@
+/**
+ * vim: set ts=4 sw=4 tw=99 noet :
+ * ======================================================
+ * Metamod:Source Tickrate
+ * Written by Wend4r (Vladimir Ezhikov).
+ * ======================================================
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <tickrate/pacer.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#ifdef _WIN32
+#	include <chrono>
+#	include <thread>
+#else
+#	include <errno.h>
+#	include <time.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#	include <emmintrin.h>
+#	define TICKRATE_PACER_PAUSE() _mm_pause()
+#else
+#	define TICKRATE_PACER_PAUSE()
+#endif
+
+#define TICKRATE_PACER_OVERSLEEP_SHIFT 3 // A weight of a new sample, 1/8.
+
+Tickrate::Pacer::Pacer()
+ :  m_nDeadline(0),
+    m_nSpinBudget(50000),
+    m_nOversleep(0),
+    m_nLateFrames(0),
+    m_nHead(0)
+{
+}
+
+void Tickrate::Pacer::Reset()
+{
+	m_nDeadline = 0;
+	m_nLateFrames = 0;
+	m_nHead = 0;
+}
+
+void Tickrate::Pacer::SetSpinBudget(uint32_t nMicroseconds)
+{
+	m_nSpinBudget = (int64_t)nMicroseconds * 1000;
+}
+
+uint32_t Tickrate::Pacer::GetSpinBudget() const
+{
+	return (uint32_t)(m_nSpinBudget / 1000);
+}
+
+bool Tickrate::Pacer::Wait(double dblInterval)
+{
+	int64_t nInterval = (int64_t)(dblInterval * 1000000000.0);
+
+	if(nInterval <= 0)
+	{
+		return false;
+	}
+
+	int64_t nNow = Now();
+
+	// The first frame, or behind a whole interval: resync the grid instead of a burst of frames.
+	if(!m_nDeadline || nNow - m_nDeadline > nInterval)
+	{
+		if(m_nDeadline)
+		{
+			m_nLateFrames++;
+		}
+
+		m_nDeadline = nNow + nInterval;
+
+		return true;
+	}
+
+	if(nNow < m_nDeadline)
+	{
+		// Spin as much as the sleep overshoots, with a quarter of a margin.
+		int64_t nSpin = std::min(m_nSpinBudget, m_nOversleep + m_nOversleep / 4), 
+		        nWakeUp = m_nDeadline - nSpin;
+
+		if(nWakeUp > nNow)
+		{
+			SleepUntil(nWakeUp);
+
+			int64_t nOversleep = std::max<int64_t>(Now() - nWakeUp, 0);
+
+			m_nOversleep += (nOversleep - m_nOversleep) >> TICKRATE_PACER_OVERSLEEP_SHIFT;
+		}
+
+		while(Now() < m_nDeadline)
+		{
+			TICKRATE_PACER_PAUSE();
+		}
+	}
+
+	int64_t nJitter = Now() - m_nDeadline;
+
+	m_aJitter[m_nHead & (TICKRATE_PACER_JITTER_COUNT - 1)] = (uint32_t)std::min<int64_t>(nJitter < 0 ? -nJitter : nJitter, UINT32_MAX);
+	m_nHead++;
+
+	m_nDeadline += nInterval;
+
+	return true;
+}
+
+uint32_t Tickrate::Pacer::GetFrameCount() const
+{
+	return m_nHead;
+}
+
+bool Tickrate::Pacer::Compute(Stats_t &aOutput) const
+{
+	aOutput = {};
+
+	uint32_t nCount = std::min<uint32_t>(m_nHead, TICKRATE_PACER_JITTER_COUNT);
+
+	aOutput.m_nFrames = (int)nCount;
+	aOutput.m_nLateFrames = m_nLateFrames;
+	aOutput.m_nOversleep = (uint32_t)std::max<int64_t>(m_nOversleep, 0);
+
+	if(!nCount)
+	{
+		return false;
+	}
+
+	// The ring is filled from the start, so the first ones are the samples until wrapped.
+	std::vector<uint32_t> vecJitter(m_aJitter, m_aJitter + nCount);
+
+	uint64_t nSum = 0;
+
+	for(uint32_t nJitter : vecJitter)
+	{
+		nSum += nJitter;
+	}
+
+	aOutput.m_dblMeanJitter = (double)nSum / nCount;
+
+	FrameProfiler::ComputePercentiles(vecJitter.data(), (int)nCount, aOutput.m_aJitter);
+
+	return true;
+}
+
+int64_t Tickrate::Pacer::Now()
+{
+#ifdef _WIN32
+	return (int64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#else
+	struct timespec aTime;
+
+	clock_gettime(CLOCK_MONOTONIC, &aTime);
+
+	return (int64_t)aTime.tv_sec * 1000000000 + aTime.tv_nsec;
+#endif
+}
+
+void Tickrate::Pacer::SleepUntil(int64_t nDeadline)
+{
+#ifdef _WIN32
+	std::this_thread::sleep_until(std::chrono::steady_clock::time_point(std::chrono::nanoseconds(nDeadline)));
+#else
+	struct timespec aDeadline;
+
+	aDeadline.tv_sec = (time_t)(nDeadline / 1000000000);
+	aDeadline.tv_nsec = (long)(nDeadline % 1000000000);
+
+	// An absolute deadline, so a signal doesn't stretch it.
+	while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &aDeadline, nullptr) == EINTR)
+	{
+	}
+#endif
+}
@@ -0,0 +1,337 @@
+/**
+ * vim: set ts=4 sw=4 tw=99 noet :
+ * ======================================================
+ * Metamod:Source Tickrate
+ * Written by Wend4r (Vladimir Ezhikov).
+ * ======================================================
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <tickrate/patch_manager.hpp>
+
+#include <string.h>
+
+#include <algorithm>
+
+#include <sourcehook/sh_memory.h>
+
+#ifdef _WIN32
+#	include <windows.h>
+#else
+#	include <sys/mman.h>
+#	include <unistd.h>
+#endif
+
+#define TICKRATE_PATCH_MANAGER_NEAR_REACH 0x7FFF0000 // Of a signed 32-bit displacement, with a margin.
+#define TICKRATE_PATCH_MANAGER_NEAR_STEP 0x100000
+
+Tickrate::PatchManager::PatchManager()
+ :  m_bOpen(false)
+{
+}
+
+Tickrate::PatchManager::~PatchManager()
+{
+	Close();
+}
+
+int Tickrate::PatchManager::Add(void *pTarget, size_t nSize)
+{
+	if(!pTarget || !nSize)
+	{
+		return -1;
+	}
+
+	uintptr_t nPageSize = GetPageSize(), 
+	          nBegin = reinterpret_cast<uintptr_t>(pTarget) & ~(nPageSize - 1), 
+	          nEnd = (reinterpret_cast<uintptr_t>(pTarget) + nSize + nPageSize - 1) & ~(nPageSize - 1);
+
+	if(!AddPages(nBegin, nEnd))
+	{
+		return -1;
+	}
+
+	auto *pBytes = reinterpret_cast<uint8_t *>(pTarget);
+
+	m_vecPatches.push_back({pBytes, std::vector<uint8_t>(pBytes, pBytes + nSize)});
+
+	return (int)m_vecPatches.size() - 1;
+}
+
+void Tickrate::PatchManager::Clear()
+{
+	Close();
+
+	m_vecPatches.clear();
+	m_vecPageRuns.clear();
+
+	for(const auto &aBlock : m_vecNearBlocks)
+	{
+		UnmapNear(aBlock.m_pBase, aBlock.m_nSize);
+	}
+
+	m_vecNearBlocks.clear();
+}
+
+int Tickrate::PatchManager::GetCount() const
+{
+	return (int)m_vecPatches.size();
+}
+
+int Tickrate::PatchManager::GetPageRunCount() const
+{
+	return (int)m_vecPageRuns.size();
+}
+
+bool Tickrate::PatchManager::Open()
+{
+	if(m_bOpen)
+	{
+		return true;
+	}
+
+	for(size_t n = 0; n < m_vecPageRuns.size(); n++)
+	{
+		const auto &aRun = m_vecPageRuns[n];
+
+		if(!SourceHook::SetMemAccess(reinterpret_cast<void *>(aRun.m_nBase), aRun.m_nSize, aRun.m_iAccess | SH_MEM_WRITE))
+		{
+			// Roll back the opened ones.
+			while(n-- > 0)
+			{
+				const auto &aOpened = m_vecPageRuns[n];
+
+				SourceHook::SetMemAccess(reinterpret_cast<void *>(aOpened.m_nBase), aOpened.m_nSize, aOpened.m_iAccess);
+			}
+
+			return false;
+		}
+	}
+
+	m_bOpen = true;
+
+	return true;
+}
+
+void Tickrate::PatchManager::Close()
+{
+	if(!m_bOpen)
+	{
+		return;
+	}
+
+	for(const auto &aRun : m_vecPageRuns)
+	{
+		SourceHook::SetMemAccess(reinterpret_cast<void *>(aRun.m_nBase), aRun.m_nSize, aRun.m_iAccess);
+	}
+
+	m_bOpen = false;
+}
+
+bool Tickrate::PatchManager::IsOpen() const
+{
+	return m_bOpen;
+}
+
+bool Tickrate::PatchManager::Restore()
+{
+	bool bWasOpen = m_bOpen;
+
+	if(!Open())
+	{
+		return false;
+	}
+
+	for(const auto &aPatch : m_vecPatches)
+	{
+		memcpy(aPatch.m_pTarget, aPatch.m_vecOriginal.data(), aPatch.m_vecOriginal.size());
+	}
+
+	if(!bWasOpen)
+	{
+		Close();
+	}
+
+	return true;
+}
+
+void *Tickrate::PatchManager::AllocateNear(const void *pNear, size_t nSize)
+{
+	if(!nSize)
+	{
+		return nullptr;
+	}
+
+	nSize = (nSize + 15) & ~(size_t)15;
+
+	uintptr_t nNear = reinterpret_cast<uintptr_t>(pNear);
+
+	for(auto &aBlock : m_vecNearBlocks)
+	{
+		uintptr_t nAddress = reinterpret_cast<uintptr_t>(aBlock.m_pBase) + aBlock.m_nUsed;
+
+		if(aBlock.m_nUsed + nSize <= aBlock.m_nSize && IsNear(nAddress, nNear) && IsNear(nAddress + nSize, nNear))
+		{
+			aBlock.m_nUsed += nSize;
+
+			return reinterpret_cast<void *>(nAddress);
+		}
+	}
+
+	size_t nPageSize = GetPageSize(), 
+	       nBlockSize = (nSize + nPageSize - 1) & ~(nPageSize - 1);
+
+	auto *pBase = reinterpret_cast<uint8_t *>(MapNear(nNear, nBlockSize));
+
+	if(!pBase)
+	{
+		return nullptr;
+	}
+
+	m_vecNearBlocks.push_back({pBase, nBlockSize, nSize});
+
+	return pBase;
+}
+
+bool Tickrate::PatchManager::IsNear(uintptr_t nAddress, uintptr_t nNear)
+{
+	return (nAddress > nNear ? nAddress - nNear : nNear - nAddress) < TICKRATE_PATCH_MANAGER_NEAR_REACH;
+}
+
+void *Tickrate::PatchManager::MapNear(uintptr_t nNear, size_t nSize)
+{
+	// Probe outwards of the address, both directions by turns.
+	for(uintptr_t nDistance = TICKRATE_PATCH_MANAGER_NEAR_STEP; nDistance + nSize < TICKRATE_PATCH_MANAGER_NEAR_REACH; nDistance += TICKRATE_PATCH_MANAGER_NEAR_STEP)
+	{
+		uintptr_t nMask = ~(uintptr_t)(TICKRATE_PATCH_MANAGER_NEAR_STEP - 1);
+
+		uintptr_t aHints[] = 
+		{
+			nNear > nDistance ? (nNear - nDistance) & nMask : 0, 
+			nNear < UINTPTR_MAX - nDistance ? (nNear + nDistance) & nMask : 0
+		};
+
+		for(uintptr_t nHint : aHints)
+		{
+			if(!nHint)
+			{
+				continue;
+			}
+
+#ifdef _WIN32
+			void *pBase = VirtualAlloc(reinterpret_cast<void *>(nHint), nSize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+
+			if(!pBase)
+			{
+				continue;
+			}
+#else
+			int iFlags = MAP_PRIVATE | MAP_ANONYMOUS;
+
+#	ifdef MAP_FIXED_NOREPLACE
+			iFlags |= MAP_FIXED_NOREPLACE;
+#	endif
+
+			void *pBase = mmap(reinterpret_cast<void *>(nHint), nSize, PROT_READ | PROT_WRITE, iFlags, -1, 0);
+
+			if(pBase == MAP_FAILED)
+			{
+				continue;
+			}
+#endif
+
+			uintptr_t nBase = reinterpret_cast<uintptr_t>(pBase);
+
+			// A hint may be not taken.
+			if(IsNear(nBase, nNear) && IsNear(nBase + nSize, nNear))
+			{
+				return pBase;
+			}
+
+			UnmapNear(pBase, nSize);
+		}
+	}
+
+	return nullptr;
+}
+
+void Tickrate::PatchManager::UnmapNear(void *pBase, size_t nSize)
+{
+#ifdef _WIN32
+	VirtualFree(pBase, 0, MEM_RELEASE);
+#else
+	munmap(pBase, nSize);
+#endif
+}
+
+bool Tickrate::PatchManager::AddPages(uintptr_t nBegin, uintptr_t nEnd)
+{
+	uintptr_t nPageSize = GetPageSize();
+
+	for(uintptr_t nPage = nBegin; nPage < nEnd; nPage += nPageSize)
+	{
+		auto it = std::lower_bound(m_vecPageRuns.begin(), m_vecPageRuns.end(), nPage, [](const PageRun_t &aRun, uintptr_t nValue)
+		{
+			return aRun.m_nBase + aRun.m_nSize <= nValue;
+		});
+
+		if(it != m_vecPageRuns.end() && it->m_nBase <= nPage)
+		{
+			continue; // Known.
+		}
+
+		int iAccess;
+
+		if(!SourceHook::GetPageBits(reinterpret_cast<void *>(nPage), &iAccess))
+		{
+			return false;
+		}
+
+		it = m_vecPageRuns.insert(it, {nPage, nPageSize, iAccess});
+
+		// Merge with the neighbours of the same protection.
+		if(it + 1 != m_vecPageRuns.end() && it->m_nBase + it->m_nSize == (it + 1)->m_nBase && it->m_iAccess == (it + 1)->m_iAccess)
+		{
+			it->m_nSize += (it + 1)->m_nSize;
+			m_vecPageRuns.erase(it + 1);
+		}
+
+		if(it != m_vecPageRuns.begin() && (it - 1)->m_nBase + (it - 1)->m_nSize == it->m_nBase && (it - 1)->m_iAccess == it->m_iAccess)
+		{
+			(it - 1)->m_nSize += it->m_nSize;
+			m_vecPageRuns.erase(it);
+		}
+	}
+
+	return true;
+}
+
+size_t Tickrate::PatchManager::GetPageSize()
+{
+	static size_t s_nPageSize = []()
+	{
+#ifdef _WIN32
+		SYSTEM_INFO aInfo;
+
+		GetSystemInfo(&aInfo);
+
+		return (size_t)aInfo.dwPageSize;
+#else
+		return (size_t)sysconf(_SC_PAGESIZE);
+#endif
+	}();
+
+	return s_nPageSize;
+}
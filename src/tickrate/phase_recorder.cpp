@@ -0,0 +1,229 @@
+/**
+ * vim: set ts=4 sw=4 tw=99 noet :
+ * ======================================================
+ * Metamod:Source Tickrate
+ * Written by Wend4r (Vladimir Ezhikov).
+ * ======================================================
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <tickrate/phase_recorder.hpp>
+
+#include <algorithm>
+#include <vector>
+
+static_assert(sizeof(Tickrate::PhaseRecorder::Record_t) == 18, "The record is a part of the dump format");
+
+Tickrate::PhaseRecorder::PhaseRecorder()
+ :  m_dblFrameStart(0.0),
+    m_dblSimulateBegin(0.0),
+    m_dblSimulateTime(0.0),
+    m_dblSendBegin(0.0),
+    m_nTicks(0),
+    m_nHead(0)
+{
+}
+
+void Tickrate::PhaseRecorder::Reset()
+{
+	m_dblFrameStart = 0.0;
+	m_dblSimulateBegin = 0.0;
+	m_dblSimulateTime = 0.0;
+	m_dblSendBegin = 0.0;
+	m_nTicks = 0;
+	m_nHead = 0;
+}
+
+void Tickrate::PhaseRecorder::OnSimulateBegin(double dblNow)
+{
+	m_dblSimulateBegin = dblNow;
+}
+
+void Tickrate::PhaseRecorder::OnSimulateEnd(double dblNow)
+{
+	if(m_dblSimulateBegin <= 0.0)
+	{
+		return;
+	}
+
+	if(dblNow > m_dblSimulateBegin)
+	{
+		m_dblSimulateTime += dblNow - m_dblSimulateBegin;
+	}
+
+	m_dblSimulateBegin = 0.0;
+	m_nTicks++;
+}
+
+void Tickrate::PhaseRecorder::OnSendBegin(double dblNow)
+{
+	// The first one of the frame, an update can follow each tick.
+	if(m_dblSendBegin <= 0.0)
+	{
+		m_dblSendBegin = dblNow;
+	}
+}
+
+void Tickrate::PhaseRecorder::OnFrameBoundary(double dblNow, double dblComputeTime)
+{
+	double dblStart = m_dblFrameStart;
+
+	if(dblStart > 0.0 && dblNow >= dblStart) // Not the first boundary after reset.
+	{
+		auto &aRecord = m_aRecords[m_nHead & (TICKRATE_PHASE_RECORDER_RECORD_COUNT - 1)];
+
+		double dblWallTime = dblNow - dblStart;
+
+		aRecord.m_nWallTime = ToMicroseconds(dblWallTime);
+		aRecord.m_nSimulateTime = ToMicroseconds(m_dblSimulateTime);
+		aRecord.m_nTicks = (uint8_t)std::min(m_nTicks, (int)UINT8_MAX);
+
+		if(dblComputeTime < 0.0)
+		{
+			aRecord.m_nSendTime = 0;
+			aRecord.m_nIdleTime = 0;
+			aRecord.m_nFlags = RECORD_COMPUTE_UNKNOWN;
+		}
+		else
+		{
+			// The computation starts at the boundary, the rest of the wall time is a sleep.
+			double dblComputeEnd = dblStart + std::min(dblComputeTime, dblWallTime);
+
+			aRecord.m_nSendTime = m_dblSendBegin > 0.0 ? ToMicroseconds(dblComputeEnd - m_dblSendBegin) : 0;
+			aRecord.m_nIdleTime = ToMicroseconds(dblNow - dblComputeEnd);
+			aRecord.m_nFlags = RECORD_NONE;
+		}
+
+		m_nHead++;
+	}
+
+	m_dblFrameStart = dblNow;
+	m_dblSimulateBegin = 0.0;
+	m_dblSimulateTime = 0.0;
+	m_dblSendBegin = 0.0;
+	m_nTicks = 0;
+}
+
+uint32_t Tickrate::PhaseRecorder::GetRecordCount() const
+{
+	return m_nHead;
+}
+
+int Tickrate::PhaseRecorder::Collect(Record_t *pOutput, int nMaxCount) const
+{
+	uint32_t nCount = std::min<uint32_t>({m_nHead, (uint32_t)nMaxCount, (uint32_t)TICKRATE_PHASE_RECORDER_RECORD_COUNT});
+
+	uint32_t nFirst = m_nHead - nCount;
+
+	for(uint32_t n = 0; n < nCount; n++)
+	{
+		pOutput[n] = m_aRecords[(nFirst + n) & (TICKRATE_PHASE_RECORDER_RECORD_COUNT - 1)];
+	}
+
+	return (int)nCount;
+}
+
+bool Tickrate::PhaseRecorder::Compute(Stats_t &aOutput, int nMaxCount) const
+{
+	std::vector<Record_t> vecRecords(std::min(nMaxCount, TICKRATE_PHASE_RECORDER_RECORD_COUNT));
+
+	int nCount = Collect(vecRecords.data(), (int)vecRecords.size());
+
+	vecRecords.resize(nCount);
+
+	aOutput = {};
+	aOutput.m_nRecords = nCount;
+
+	if(!nCount)
+	{
+		return false;
+	}
+
+	const struct
+	{
+		uint32_t Record_t::*pnValue;
+		Portion_t *pOutput;
+		bool bComputeOnly; // Skip the records with an unknown compute time.
+	} aPortions[] =
+	{
+		{
+			&Record_t::m_nWallTime,
+			&aOutput.m_aWall,
+			false
+		},
+		{
+			&Record_t::m_nSimulateTime,
+			&aOutput.m_aSimulate,
+			false
+		},
+		{
+			&Record_t::m_nSendTime,
+			&aOutput.m_aSend,
+			true
+		},
+		{
+			&Record_t::m_nIdleTime,
+			&aOutput.m_aIdle,
+			true
+		},
+	};
+
+	std::vector<uint32_t> vecValues;
+
+	vecValues.reserve(nCount);
+
+	for(const auto &aPortion : aPortions)
+	{
+		uint64_t nSum = 0;
+
+		vecValues.clear();
+
+		for(const auto &aRecord : vecRecords)
+		{
+			if(aPortion.bComputeOnly && (aRecord.m_nFlags & RECORD_COMPUTE_UNKNOWN))
+			{
+				continue;
+			}
+
+			uint32_t nValue = aRecord.*aPortion.pnValue;
+
+			nSum += nValue;
+			vecValues.push_back(nValue);
+		}
+
+		if(vecValues.size())
+		{
+			aPortion.pOutput->m_dblMean = (double)nSum / vecValues.size();
+		}
+
+		FrameProfiler::ComputePercentiles(vecValues.data(), (int)vecValues.size(), aPortion.pOutput->m_aPercentiles);
+	}
+
+	uint64_t nTicks = 0;
+
+	for(const auto &aRecord : vecRecords)
+	{
+		nTicks += aRecord.m_nTicks;
+	}
+
+	aOutput.m_dblTicksPerFrame = (double)nTicks / nCount;
+
+	return true;
+}
+
+uint32_t Tickrate::PhaseRecorder::ToMicroseconds(double dblSeconds)
+{
+	return dblSeconds <= 0.0 ? 0 : (uint32_t)std::min(dblSeconds * 1000000.0, (double)UINT32_MAX);
+}
@@ -29,6 +29,22 @@
 
 #include <any_config.hpp>
 
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#	include <process.h>
+#	define getpid _getpid
+#else
+#	include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+
 Tickrate::Provider::Provider()
  :  m_mapLibraries(DefLessFunc(const CUtlSymbolLarge))
 {
@@ -48,6 +64,7 @@ bool Tickrate::Provider::Init(GameData::CBufferStringVector &vecMessages)
 		}
 
 		m_mapLibraries.Insert(GetSymbol(szEngineModuleName), &m_aEngine2Library);
+		m_aEngine2Identity.Resolve(g_pEngineServer);
 	}
 
 	// File System.
@@ -62,6 +79,7 @@ bool Tickrate::Provider::Init(GameData::CBufferStringVector &vecMessages)
 		}
 
 		m_mapLibraries.Insert(GetSymbol(szFileSystemSTDIOModuleName), &m_aFileSystemSTDIOLibrary);
+		m_aFileSystemSTDIOIdentity.Resolve(g_pFullFileSystem);
 	}
 
 	// Server.
@@ -76,6 +94,7 @@ bool Tickrate::Provider::Init(GameData::CBufferStringVector &vecMessages)
 		}
 
 		m_mapLibraries.Insert(GetSymbol(szServerModuleName), &m_aServerLibrary);
+		m_aServerIdentity.Resolve(g_pSource2Server);
 	}
 
 	return true;
@@ -109,153 +128,2067 @@ const DynLibUtils::CModule *Tickrate::Provider::FindLibrary(const char *pszName)
 	return m_mapLibraries.Element(iFoundIndex);
 }
 
-CUtlSymbolLarge Tickrate::Provider::GetSymbol(const char *pszText)
+const Tickrate::ModuleIdentity *Tickrate::Provider::FindLibraryIdentity(const char *pszName) const
 {
-	return m_aSymbolTable.AddString(pszText);
+	ModuleIdentityEntry_t aModules[3];
+
+	int nModuleCount = GetModuleIdentities(aModules);
+
+	for(int n = 0; n < nModuleCount; n++)
+	{
+		if(!V_strcmp(aModules[n].m_pszName, pszName))
+		{
+			return aModules[n].m_pIdentity->IsValid() ? aModules[n].m_pIdentity : nullptr;
+		}
+	}
+
+	return nullptr;
 }
 
-CUtlSymbolLarge Tickrate::Provider::FindSymbol(const char *pszText) const
+size_t Tickrate::Provider::ScanLibrary(const char *pszName, const SignatureScanner &aScanner, std::vector<const uint8_t *> &vecOutput, bool bExecutable) const
 {
-	return m_aSymbolTable.Find(pszText);
+	vecOutput.assign(aScanner.GetCount(), nullptr);
+
+	const auto *pIdentity = FindLibraryIdentity(pszName);
+
+	if(!pIdentity)
+	{
+		return 0;
+	}
+
+	size_t nFound = 0;
+
+	for(int n = 0; n < pIdentity->m_nSegmentCount; n++)
+	{
+		const auto &aSegment = pIdentity->m_aSegments[n];
+
+		if(aSegment.m_bExecutable != bExecutable || (!bExecutable && aSegment.m_bWritable))
+		{
+			continue;
+		}
+
+		nFound = aScanner.ScanMore(reinterpret_cast<const uint8_t *>(aSegment.m_nBase), aSegment.m_nSize, vecOutput);
+
+		if(nFound == aScanner.GetCount())
+		{
+			break;
+		}
+	}
+
+	return nFound;
 }
 
-bool Tickrate::Provider::LoadGameData(const char *pszBaseDir, const char *pszPathID, GameData::CBufferStringVector &vecMessages)
+const Tickrate::StringXref *Tickrate::Provider::FindLibraryStringXref(const char *pszName) const
 {
-	char sBaseConfigDir[MAX_PATH];
+	const auto *pIdentity = FindLibraryIdentity(pszName);
 
-	snprintf((char *)sBaseConfigDir, sizeof(sBaseConfigDir), "%s" CORRECT_PATH_SEPARATOR_S "%s", pszBaseDir, TICKRATE_GAMECONFIG_FOLDER_DIR);
+	if(!pIdentity)
+	{
+		return nullptr;
+	}
+
+	StringXref *pXref = nullptr;
+
+	if(pIdentity == &m_aEngine2Identity)
+	{
+		pXref = &m_aEngine2StringXref;
+	}
+	else if(pIdentity == &m_aFileSystemSTDIOIdentity)
+	{
+		pXref = &m_aFileSystemSTDIOStringXref;
+	}
+	else if(pIdentity == &m_aServerIdentity)
+	{
+		pXref = &m_aServerStringXref;
+	}
+	else
+	{
+		return nullptr;
+	}
+
+	std::lock_guard<std::mutex> aLock(m_mtxStringXrefs);
+
+	if(!pXref->IsBuilt() && !pXref->Build(*pIdentity))
+	{
+		return nullptr;
+	}
 
-	return m_aStorage.Load(this, sBaseConfigDir, pszPathID, vecMessages);
+	return pXref;
 }
 
-bool Tickrate::Provider::GameDataStorage::Load(IGameData *pRoot, const char *pszBaseConfigDir, const char *pszPathID, GameData::CBufferStringVector &vecMessages)
+const Tickrate::ModuleIdentity::Segment_t *Tickrate::Provider::FindLibrarySegment(const void *pAddress, size_t nSize) const
 {
-	const struct
-	{
-		const char *pszFilename;
-		bool (Tickrate::Provider::GameDataStorage::*pfnLoad)(IGameData *, KeyValues3 *, GameData::CBufferStringVector &);
-	} aConfigs[] =
+	ModuleIdentityEntry_t aModules[3];
+
+	int nModuleCount = GetModuleIdentities(aModules);
+
+	uintptr_t nAddress = reinterpret_cast<uintptr_t>(pAddress);
+
+	for(int n = 0; n < nModuleCount; n++)
 	{
+		const auto *pIdentity = aModules[n].m_pIdentity;
+
+		for(int i = 0; i < pIdentity->m_nSegmentCount; i++)
 		{
-			TICKRATE_GAMECONFIG_GAMERESOURCE_FILENAME,
-			&GameDataStorage::LoadGameResource
-		},
-		{
-			TICKRATE_GAMECONFIG_GAMESYSTEM_FILENAME,
-			&GameDataStorage::LoadGameSystem
-		},
-		{
-			TICKRATE_GAMECONFIG_HOSTFRAME_FILENAME,
-			&GameDataStorage::LoadHostFrame
-		},
-		{
-			TICKRATE_GAMECONFIG_SOURCE2SERVER_FILENAME,
-			&GameDataStorage::LoadSource2Server
-		},
-		{
-			TICKRATE_GAMECONFIG_TICK_FILENAME,
-			&GameDataStorage::LoadTick
-		}
-	};
+			const auto &aSegment = pIdentity->m_aSegments[i];
 
-	char sConfigFile[MAX_PATH];
+			if(aSegment.m_nBase <= nAddress && nAddress - aSegment.m_nBase <= aSegment.m_nSize && nSize <= aSegment.m_nSize - (nAddress - aSegment.m_nBase))
+			{
+				return &aSegment;
+			}
+		}
+	}
 
-	CUtlString sError;
+	return nullptr;
+}
 
-	AnyConfig::LoadFromFile_Generic_t aLoadPresets({{&sError, NULL, pszPathID}, g_KV3Format_Generic});
+int Tickrate::Provider::RepairSignatures(KeyValues3 *pGameConfig, CUtlVector<CUtlString> &vecRepaired, GameData::CBufferStringVector &vecMessages) const
+{
+	struct Signature_t
+	{
+		const char *m_pszName;
+		KeyValues3 *m_pPlatform;
+		KeyValues3 *m_pUsedStrings;
+	};
 
-	for(const auto &aConfig : aConfigs)
+	struct Library_t
 	{
-		AnyConfig::Anyone aGameConfig;
+		const char *m_pszName;
+		SignatureScanner m_aScanner;
+		std::vector<Signature_t> m_vecSignatures;
+	};
 
-		snprintf((char *)sConfigFile, sizeof(sConfigFile), "%s" CORRECT_PATH_SEPARATOR_S "%s", pszBaseConfigDir, aConfig.pszFilename);
+	std::vector<Library_t> vecLibraries;
 
-		CUtlVector<CUtlString> vecConfigFiles;
+	// Only the signatures able to be repaired are checked.
+	for(int iGame = 0, iGameCount = pGameConfig->GetMemberCount(); iGame < iGameCount; iGame++)
+	{
+		KeyValues3 *pSignatures = pGameConfig->GetMember(iGame)->FindMember("Signatures");
 
-		g_pFullFileSystem->FindFileAbsoluteList(vecConfigFiles, (const char *)sConfigFile, pszPathID);
+		if(!pSignatures)
+		{
+			continue;
+		}
 
-		if(vecConfigFiles.Count() < 1)
+		for(int i = 0, iCount = pSignatures->GetMemberCount(); i < iCount; i++)
 		{
-			const char *pszMessageConcat[] = {"Failed to ", "find \"", sConfigFile, "\" file", ": ", sError.Get()};
+			KeyValues3 *pSignature = pSignatures->GetMember(i);
 
-			vecMessages.AddToTail({pszMessageConcat});
+			KeyValues3 *pLibrary = pSignature->FindMember("library"), 
+			           *pPlatform = pSignature->FindMember(TICKRATE_GAMECONFIG_PLATFORM), 
+			           *pUsedStrings = pSignature->FindMember("used_strings");
 
-			continue;
+			if(!pLibrary || !pPlatform || !pUsedStrings || !pUsedStrings->GetArrayElementCount())
+			{
+				continue;
+			}
+
+			const char *pszLibrary = pLibrary->GetString();
+
+			auto it = std::find_if(vecLibraries.begin(), vecLibraries.end(), [pszLibrary](const Library_t &aLibrary)
+			{
+				return !V_strcmp(aLibrary.m_pszName, pszLibrary);
+			});
+
+			if(it == vecLibraries.end())
+			{
+				it = vecLibraries.insert(vecLibraries.end(), Library_t {pszLibrary, {}, {}});
+			}
+
+			if(it->m_aScanner.Add(pPlatform->GetString()) == -1)
+			{
+				continue;
+			}
+
+			it->m_vecSignatures.push_back({pSignatures->GetMemberName(i), pPlatform, pUsedStrings});
 		}
+	}
 
-		aLoadPresets.m_pszFilename = vecConfigFiles[0].Get();
+	int nRepaired = 0;
 
-		if(!aGameConfig.Load(aLoadPresets)) // Hot.
-		{
-			const char *pszMessageConcat[] = {"Failed to ", "load \"", sConfigFile, "\" file", ": ", sError.Get()};
+	std::vector<const uint8_t *> vecFound;
 
-			vecMessages.AddToTail({pszMessageConcat});
+	std::vector<const char *> vecUsedStrings;
 
+	for(const auto &aLibrary : vecLibraries)
+	{
+		if(ScanLibrary(aLibrary.m_pszName, aLibrary.m_aScanner, vecFound) == aLibrary.m_vecSignatures.size())
+		{
 			continue;
 		}
 
-		if(!(this->*(aConfig.pfnLoad))(pRoot, aGameConfig.Get(), vecMessages))
+		const StringXref *pXref = FindLibraryStringXref(aLibrary.m_pszName);
+
+		for(size_t n = 0; n < aLibrary.m_vecSignatures.size(); n++)
 		{
-			const char *pszMessageConcat[] = {"Failed to ", "parse \"", sConfigFile, "\" file", ": ", sError.Get()};
+			if(vecFound[n])
+			{
+				continue;
+			}
 
-			vecMessages.AddToTail({pszMessageConcat});
+			const auto &aSignature = aLibrary.m_vecSignatures[n];
 
-			continue;
-		}
+			vecUsedStrings.clear();
+
+			for(int i = 0, iCount = aSignature.m_pUsedStrings->GetArrayElementCount(); i < iCount; i++)
+			{
+				vecUsedStrings.push_back(aSignature.m_pUsedStrings->GetArrayElement(i)->GetString());
+			}
+
+			size_t nMatched = 0;
+
+			const uint8_t *pFunction = pXref ? pXref->FindFunction(vecUsedStrings.data(), vecUsedStrings.size(), &nMatched) : nullptr;
 
-		// ...
+			CBufferStringGrowable<512> sSignature;
+
+			if(!pFunction || !MakeSignature(aLibrary.m_pszName, pFunction, sSignature))
+			{
+				const char *pszMessageConcat[] = {"Failed to ", "repair \"", aSignature.m_pszName, "\" signature", " by its used strings"};
+
+				vecMessages.AddToTail({pszMessageConcat});
+
+				continue;
+			}
+
+			aSignature.m_pPlatform->SetString(sSignature.Get());
+			vecRepaired.AddToTail(aSignature.m_pszName);
+			nRepaired++;
+
+			char sMatched[32];
+
+			V_snprintf(sMatched, sizeof(sMatched), "%zu/%zu", nMatched, vecUsedStrings.size());
+
+			const char *pszMessageConcat[] = {"Repaired \"", aSignature.m_pszName, "\" signature", " by its used strings (", sMatched, "), update the gamedata"};
+
+			vecMessages.AddToTail({pszMessageConcat});
+		}
 	}
 
-	return true;
+	return nRepaired;
 }
 
-bool Tickrate::Provider::GameDataStorage::LoadGameResource(IGameData *pRoot, KeyValues3 *pGameConfig, GameData::CBufferStringVector &vecMessages)
+bool Tickrate::Provider::MakeSignature(const char *pszLibrary, const uint8_t *pFunction, CBufferString &sOutput) const
 {
-	return m_aGameResource.Load(pRoot, pGameConfig, vecMessages);
-}
+	const auto *pIdentity = FindLibraryIdentity(pszLibrary);
 
-bool Tickrate::Provider::GameDataStorage::LoadGameSystem(IGameData *pRoot, KeyValues3 *pGameConfig, GameData::CBufferStringVector &vecMessages)
-{
-	return m_aGameSystem.Load(pRoot, pGameConfig, vecMessages);
-}
+	if(!pIdentity)
+	{
+		return false;
+	}
 
-bool Tickrate::Provider::GameDataStorage::LoadHostFrame(IGameData *pRoot, KeyValues3 *pGameConfig, GameData::CBufferStringVector &vecMessages)
-{
-	return m_aHostFrame.Load(pRoot, pGameConfig, vecMessages);
-}
+	size_t nAvailable = 0;
 
-bool Tickrate::Provider::GameDataStorage::LoadSource2Server(IGameData *pRoot, KeyValues3 *pGameConfig, GameData::CBufferStringVector &vecMessages)
-{
-	return m_aSource2Server.Load(pRoot, pGameConfig, vecMessages);
+	for(int n = 0; n < pIdentity->m_nSegmentCount; n++)
+	{
+		const auto &aSegment = pIdentity->m_aSegments[n];
+
+		uintptr_t nFunction = reinterpret_cast<uintptr_t>(pFunction);
+
+		if(aSegment.m_bExecutable && aSegment.m_nBase <= nFunction && nFunction < aSegment.m_nBase + aSegment.m_nSize)
+		{
+			nAvailable = aSegment.m_nBase + aSegment.m_nSize - nFunction;
+
+			break;
+		}
+	}
+
+	std::vector<const uint8_t *> vecFound;
+
+	for(size_t nLength = 16; nLength <= 256 && nLength <= nAvailable; nLength *= 2)
+	{
+		sOutput.Clear();
+
+		for(size_t i = 0; i < nLength; i++)
+		{
+			sOutput.AppendFormat(i ? " %02X" : "%02X", pFunction[i]);
+		}
+
+		SignatureScanner aScanner;
+
+		if(aScanner.Add(sOutput.Get()) != -1 && ScanLibrary(pszLibrary, aScanner, vecFound) && vecFound[0] == pFunction)
+		{
+			return true;
+		}
+	}
+
+	sOutput.Clear();
+
+	return false;
 }
 
-bool Tickrate::Provider::GameDataStorage::LoadTick(IGameData *pRoot, KeyValues3 *pGameConfig, GameData::CBufferStringVector &vecMessages)
+CUtlSymbolLarge Tickrate::Provider::GetSymbol(const char *pszText)
 {
-	return m_aTick.Load(pRoot, pGameConfig, vecMessages);
+	std::lock_guard<std::mutex> aLock(m_mtxSymbols);
+
+	return m_aSymbolTable.AddString(pszText);
 }
 
-const Tickrate::Provider::GameDataStorage::CGameResource &Tickrate::Provider::GameDataStorage::GetGameResource() const
+CUtlSymbolLarge Tickrate::Provider::FindSymbol(const char *pszText) const
 {
-	return m_aGameResource;
+	std::lock_guard<std::mutex> aLock(m_mtxSymbols); // Of "FindLibrary" by the load workers.
+
+	return m_aSymbolTable.Find(pszText);
 }
 
-const Tickrate::Provider::GameDataStorage::CGameSystem &Tickrate::Provider::GameDataStorage::GetGameSystem() const
+bool Tickrate::Provider::LoadGameData(const char *pszBaseDir, const char *pszPathID, GameData::CBufferStringVector &vecMessages)
 {
-	return m_aGameSystem;
+	char sBaseConfigDir[MAX_PATH];
+
+	snprintf((char *)sBaseConfigDir, sizeof(sBaseConfigDir), "%s" CORRECT_PATH_SEPARATOR_S "%s", pszBaseDir, TICKRATE_GAMECONFIG_FOLDER_DIR);
+
+	char sCacheFile[MAX_PATH];
+
+	CBufferStringGrowable<1024> sCacheKey;
+
+	bool bCacheable = GetGameDataCache(sBaseConfigDir, pszPathID, sCacheFile, sizeof(sCacheFile), sCacheKey);
+
+	m_aStorage.Reset();
+
+	// Hits skip parsing and scanning of their configs.
+	if(bCacheable)
+	{
+		LoadGameDataCache(sCacheFile, sCacheKey.Get());
+
+		// Saved with the resolved ones so far, a lazy config may never be.
+		m_aStorage.SetResolvedCallback([this, sFile = CUtlString(sCacheFile), sKey = CUtlString(sCacheKey.Get())](GameData::CBufferStringVector &vecCacheMessages)
+		{
+			if(SaveGameDataCache(sFile.Get(), sKey.Get(), vecCacheMessages))
+			{
+				OnGameDataCacheSaved(sFile.Get());
+			}
+		});
+	}
+
+	if(!m_aStorage.Load(this, sBaseConfigDir, pszPathID, vecMessages))
+	{
+		return false;
+	}
+
+	return true;
 }
 
-const Tickrate::Provider::GameDataStorage::CHostFrame &Tickrate::Provider::GameDataStorage::GetHostFrame() const
+int Tickrate::Provider::GetModuleIdentities(ModuleIdentityEntry_t (&aOutput)[3]) const
 {
-	return m_aHostFrame;
+	aOutput[0] = {"engine2", &m_aEngine2Identity};
+	aOutput[1] = {"filesystem_stdio", &m_aFileSystemSTDIOIdentity};
+	aOutput[2] = {"server", &m_aServerIdentity};
+
+	return 3;
 }
 
-const Tickrate::Provider::GameDataStorage::CSource2Server &Tickrate::Provider::GameDataStorage::GetSource2Server() const
+bool Tickrate::Provider::GetGameDataCache(const char *pszBaseConfigDir, const char *pszPathID, char *pszCacheFile, size_t nCacheFileLength, CBufferString &sKey)
 {
-	return m_aSource2Server;
+	ModuleIdentityEntry_t aModules[3];
+
+	int nModuleCount = GetModuleIdentities(aModules);
+
+	for(int n = 0; n < nModuleCount; n++)
+	{
+		const auto &aModule = aModules[n];
+
+		if(!aModule.m_pIdentity->IsValid())
+		{
+			return false;
+		}
+
+		sKey.AppendFormat("%s=%s;", aModule.m_pszName, aModule.m_pIdentity->m_sBuildID);
+	}
+
+	char sConfigFiles[MAX_PATH];
+
+	snprintf((char *)sConfigFiles, sizeof(sConfigFiles), "%s" CORRECT_PATH_SEPARATOR_S "%s", pszBaseConfigDir, TICKRATE_GAMECONFIG_FILES);
+
+	CUtlVector<CUtlString> vecConfigFiles;
+
+	g_pFullFileSystem->FindFileAbsoluteList(vecConfigFiles, (const char *)sConfigFiles, pszPathID);
+
+	if(vecConfigFiles.Count() < 1)
+	{
+		return false;
+	}
+
+	// Edited configs invalidate too.
+	for(const auto &sFile : vecConfigFiles)
+	{
+		struct stat aStat;
+
+		if(stat(sFile.Get(), &aStat))
+		{
+			return false;
+		}
+
+		sKey.AppendFormat("%s=%lld:%lld;", V_UnqualifiedFileName(sFile.Get()), (long long)aStat.st_size, (long long)aStat.st_mtime);
+	}
+
+	char sConfigDir[MAX_PATH];
+
+	V_ExtractFilePath(vecConfigFiles[0].Get(), sConfigDir, sizeof(sConfigDir));
+	snprintf(pszCacheFile, nCacheFileLength, "%s%s", sConfigDir, TICKRATE_GAMECONFIG_CACHE_FILENAME);
+
+	return true;
 }
 
-const Tickrate::Provider::GameDataStorage::CTick &Tickrate::Provider::GameDataStorage::GetTick() const
+bool Tickrate::Provider::LoadGameDataCache(const char *pszCacheFile, const char *pszKey)
 {
+	FILE *pFile = fopen(pszCacheFile, "r");
+
+	if(!pFile)
+	{
+		return false;
+	}
+
+	// Per config, each one is complete or rescanned.
+	CUtlVector<GameDataStorage::CacheEntry_t> aEntries[GameDataStorage::CONFIG_MAX];
+	std::vector<GameDataStorage::CacheValue_t> aCached[GameDataStorage::CONFIG_MAX];
+
+	bool aListed[GameDataStorage::CONFIG_MAX] = {};
+
+	for(int n = 0; n < GameDataStorage::CONFIG_MAX; n++)
+	{
+		auto eConfig = (GameDataStorage::Config_t)n;
+
+		if(!GameDataStorage::IsCacheable(eConfig) || m_aStorage.IsResolved(eConfig))
+		{
+			continue;
+		}
+
+		m_aStorage.GetCacheEntries(eConfig, aEntries[n]);
+		aCached[n].resize(aEntries[n].Count());
+	}
+
+	ModuleIdentityEntry_t aModules[3];
+
+	int nModuleCount = GetModuleIdentities(aModules);
+
+	char sLine[2048];
+
+	// Header & key.
+	{
+		char sHeader[64];
+
+		int iVersion;
+
+		if(!fgets(sLine, sizeof(sLine), pFile) || sscanf(sLine, "%63s %d", sHeader, &iVersion) != 2 || V_strcmp(sHeader, TICKRATE_GAMECONFIG_CACHE_HEADER) || iVersion != TICKRATE_GAMECONFIG_CACHE_VERSION)
+		{
+			fclose(pFile);
+
+			return false;
+		}
+
+		if(!fgets(sLine, sizeof(sLine), pFile) || V_strncmp(sLine, "key ", 4))
+		{
+			fclose(pFile);
+
+			return false;
+		}
+
+		V_StripTrailingWhitespace(sLine);
+
+		if(V_strcmp(&sLine[4], pszKey))
+		{
+			fclose(pFile);
+
+			return false;
+		}
+	}
+
+	int iConfig = GameDataStorage::CONFIG_MAX;
+
+	while(fgets(sLine, sizeof(sLine), pFile))
+	{
+		char sType[16], sName[256], sValue[256];
+
+		unsigned long long nValue = 0;
+
+		int iScanned = sscanf(sLine, "%15s %255s %255s %llx", sType, sName, sValue, &nValue);
+
+		if(iScanned == 2 && !V_strcmp(sType, "config"))
+		{
+			iConfig = GameDataStorage::FindConfig(sName);
+
+			if(iConfig != GameDataStorage::CONFIG_MAX)
+			{
+				aListed[iConfig] = true;
+			}
+
+			continue;
+		}
+
+		if(iScanned < 3 || iConfig == GameDataStorage::CONFIG_MAX)
+		{
+			continue;
+		}
+
+		const auto &vecEntries = aEntries[iConfig];
+
+		int iFound = vecEntries.InvalidIndex();
+
+		FOR_EACH_VEC(vecEntries, i)
+		{
+			if(!V_strcmp(vecEntries[i].m_pszName, sName))
+			{
+				iFound = i;
+
+				break;
+			}
+		}
+
+		if(iFound == vecEntries.InvalidIndex())
+		{
+			continue;
+		}
+
+		const auto &aEntry = vecEntries[iFound];
+
+		auto &aCachedEntry = aCached[iConfig][iFound];
+
+		if(!V_strcmp(sType, "offset") && aEntry.m_pnOffset)
+		{
+			aCachedEntry.m_nOffset = (ptrdiff_t)V_atoi64(sValue);
+			aCachedEntry.m_bFound = true;
+		}
+		else if(!V_strcmp(sType, "pattern") && aEntry.m_pPattern)
+		{
+			aCachedEntry.m_bFound = !V_strcmp(sValue, "null") || SignatureScanner::Parse(sValue, aCachedEntry.m_aPattern);
+		}
+		else if(!V_strcmp(sType, "address") && aEntry.m_ppAddress)
+		{
+			if(!V_strcmp(sValue, "null"))
+			{
+				aCachedEntry.m_pAddress = nullptr;
+				aCachedEntry.m_bFound = true;
+
+				continue;
+			}
+
+			if(iScanned < 4)
+			{
+				continue;
+			}
+
+			for(int n = 0; n < nModuleCount; n++)
+			{
+				const auto &aModule = aModules[n];
+
+				if(!V_strcmp(aModule.m_pszName, sValue) && nValue < aModule.m_pIdentity->m_nSize)
+				{
+					aCachedEntry.m_pAddress = reinterpret_cast<void *>(aModule.m_pIdentity->m_nBase + (uintptr_t)nValue);
+					aCachedEntry.m_bFound = true;
+
+					break;
+				}
+			}
+		}
+	}
+
+	fclose(pFile);
+
+	bool bResult = false;
+
+	for(int n = 0; n < GameDataStorage::CONFIG_MAX; n++)
+	{
+		if(!aListed[n])
+		{
+			continue;
+		}
+
+		// Every entry of the config is required, otherwise rescan.
+		bool bComplete = true;
+
+		for(const auto &aCachedEntry : aCached[n])
+		{
+			if(!aCachedEntry.m_bFound)
+			{
+				bComplete = false;
+
+				break;
+			}
+		}
+
+		if(!bComplete)
+		{
+			continue;
+		}
+
+		m_aStorage.WriteCacheValues((GameDataStorage::Config_t)n, aCached[n]);
+		m_aStorage.SetResolved((GameDataStorage::Config_t)n);
+		bResult = true;
+	}
+
+	return bResult;
+}
+
+bool Tickrate::Provider::SaveGameDataCache(const char *pszCacheFile, const char *pszKey, GameData::CBufferStringVector &vecMessages)
+{
+	ModuleIdentityEntry_t aModules[3];
+
+	int nModuleCount = GetModuleIdentities(aModules);
+
+	CBufferStringGrowable<4096> sContent;
+
+	sContent.Format("%s %d\n" "key %s\n", TICKRATE_GAMECONFIG_CACHE_HEADER, TICKRATE_GAMECONFIG_CACHE_VERSION, pszKey);
+
+	int nConfigCount = 0;
+
+	// The resolved ones only, a lazy config is added on a later save.
+	for(int n = 0; n < GameDataStorage::CONFIG_MAX; n++)
+	{
+		auto eConfig = (GameDataStorage::Config_t)n;
+
+		// A repaired one is rescanned each time, until the gamedata is updated.
+		if(!GameDataStorage::IsCacheable(eConfig) || !m_aStorage.IsResolved(eConfig) || m_aStorage.IsRepaired(eConfig))
+		{
+			continue;
+		}
+
+		CUtlVector<GameDataStorage::CacheEntry_t> vecEntries;
+
+		m_aStorage.GetCacheEntries(eConfig, vecEntries);
+
+		sContent.AppendFormat("config %s\n", GameDataStorage::GetConfigName(eConfig));
+		nConfigCount++;
+
+		for(const auto &aEntry : vecEntries)
+		{
+			if(aEntry.m_pnOffset)
+			{
+				sContent.AppendFormat("offset %s %lld\n", aEntry.m_pszName, (long long)*aEntry.m_pnOffset);
+
+				continue;
+			}
+
+			// "??" of a wildcard, a one word.
+			if(aEntry.m_pPattern)
+			{
+				const auto &aPattern = *aEntry.m_pPattern;
+
+				sContent.AppendFormat("pattern %s ", aEntry.m_pszName);
+
+				for(size_t i = 0; i < aPattern.m_vecBytes.size(); i++)
+				{
+					sContent.AppendFormat(aPattern.m_vecMask[i] ? "%02X" : "??", aPattern.m_vecBytes[i]);
+				}
+
+				sContent.AppendFormat("%s\n", aPattern.m_vecBytes.empty() ? "null" : "");
+
+				continue;
+			}
+
+			void *pAddress = *aEntry.m_ppAddress;
+
+			if(!pAddress)
+			{
+				sContent.AppendFormat("address %s null\n", aEntry.m_pszName);
+
+				continue;
+			}
+
+			// Out of the modules (heap) is not cacheable, the config is left for a rescan.
+			for(int i = 0; i < nModuleCount; i++)
+			{
+				const auto &aModule = aModules[i];
+
+				if(aModule.m_pIdentity->Contains(pAddress))
+				{
+					sContent.AppendFormat("address %s %s %llx\n", aEntry.m_pszName, aModule.m_pszName, (unsigned long long)(reinterpret_cast<uintptr_t>(pAddress) - aModule.m_pIdentity->m_nBase));
+
+					break;
+				}
+			}
+		}
+	}
+
+	if(!nConfigCount)
+	{
+		return false;
+	}
+
+	// Instances of the host load it at once, so never read a half-written one.
+	char sTempFile[MAX_PATH];
+
+	snprintf(sTempFile, sizeof(sTempFile), "%s.%d.tmp", pszCacheFile, (int)getpid());
+
+	FILE *pFile = fopen(sTempFile, "w");
+
+	if(!pFile)
+	{
+		const char *pszMessageConcat[] = {"Failed to ", "write \"", sTempFile, "\" file"};
+
+		vecMessages.AddToTail({pszMessageConcat});
+
+		return false;
+	}
+
+	bool bWritten = fputs(sContent.Get(), pFile) >= 0;
+
+	bWritten = !fclose(pFile) && bWritten;
+
+#ifdef _WIN32
+	// Not replaced by a rename, a missing one is a miss.
+	if(bWritten)
+	{
+		remove(pszCacheFile);
+	}
+#endif
+
+	if(!bWritten || rename(sTempFile, pszCacheFile))
+	{
+		remove(sTempFile);
+
+		const char *pszMessageConcat[] = {"Failed to ", "write \"", pszCacheFile, "\" file"};
+
+		vecMessages.AddToTail({pszMessageConcat});
+
+		return false;
+	}
+
+	return true;
+}
+
+const Tickrate::Provider::GameDataStorage::ConfigEntry_t Tickrate::Provider::GameDataStorage::sm_aConfigs[CONFIG_MAX] =
+{
+	{
+		"gameresource",
+		TICKRATE_GAMECONFIG_GAMERESOURCE_FILENAME,
+		&GameDataStorage::LoadGameResource,
+		&GameDataStorage::CommitGameResource,
+		true
+	},
+	{
+		"gamesystem",
+		TICKRATE_GAMECONFIG_GAMESYSTEM_FILENAME,
+		&GameDataStorage::LoadGameSystem,
+		&GameDataStorage::CommitGameSystem,
+		true
+	},
+	{
+		"hostframe",
+		TICKRATE_GAMECONFIG_HOSTFRAME_FILENAME,
+		&GameDataStorage::LoadHostFrame,
+		&GameDataStorage::CommitHostFrame,
+		true
+	},
+	{
+		"patches",
+		TICKRATE_GAMECONFIG_PATCHES_FILENAME,
+		&GameDataStorage::LoadPatches,
+		&GameDataStorage::CommitPatches,
+		false // Of the operand names of the config itself.
+	},
+	{
+		"source2server",
+		TICKRATE_GAMECONFIG_SOURCE2SERVER_FILENAME,
+		&GameDataStorage::LoadSource2Server,
+		&GameDataStorage::CommitSource2Server,
+		true
+	},
+	{
+		"tick",
+		TICKRATE_GAMECONFIG_TICK_FILENAME,
+		&GameDataStorage::LoadTick,
+		&GameDataStorage::CommitTick,
+		true
+	}
+};
+
+Tickrate::Provider::GameDataStorage::GameDataStorage()
+ :  m_pRoot(nullptr),
+    m_aResolved{},
+    m_aFailed{},
+    m_aRepaired{}
+{
+}
+
+bool Tickrate::Provider::GameDataStorage::Load(Provider *pRoot, const char *pszBaseConfigDir, const char *pszPathID, GameData::CBufferStringVector &vecMessages)
+{
+	m_pRoot = pRoot;
+	m_sBaseConfigDir = pszBaseConfigDir;
+	m_sPathID = pszPathID;
+
+	// Precompiled, optional.
+	{
+		char sBlobFile[MAX_PATH];
+
+		snprintf((char *)sBlobFile, sizeof(sBlobFile), "%s" CORRECT_PATH_SEPARATOR_S "%s", pszBaseConfigDir, TICKRATE_GAMECONFIG_BLOB_FILENAME);
+
+		CUtlVector<CUtlString> vecBlobFiles;
+
+		g_pFullFileSystem->FindFileAbsoluteList(vecBlobFiles, (const char *)sBlobFile, pszPathID);
+
+		char sBlobError[256];
+
+		m_aBlob.Close();
+
+		if(vecBlobFiles.Count() && !m_aBlob.Open(vecBlobFiles[0].Get(), TICKRATE_GAMEDATA_BLOB_PLATFORM, sBlobError, sizeof(sBlobError)))
+		{
+			const char *pszMessageConcat[] = {"Failed to ", "open \"", sBlobFile, "\" file", ": ", sBlobError};
+
+			vecMessages.AddToTail({pszMessageConcat});
+		}
+	}
+
+	bool aPreload[CONFIG_MAX];
+
+	ParsePreload(pszBaseConfigDir, pszPathID, aPreload, vecMessages);
+	Resolve(aPreload, vecMessages);
+
+	return true;
+}
+
+bool Tickrate::Provider::GameDataStorage::ParsePreload(const char *pszBaseConfigDir, const char *pszPathID, bool (&aOutput)[CONFIG_MAX], GameData::CBufferStringVector &vecMessages)
+{
+	// Without the list, everything is preloaded.
+	for(auto &bPreload : aOutput)
+	{
+		bPreload = true;
+	}
+
+	char sConfigFile[MAX_PATH];
+
+	snprintf((char *)sConfigFile, sizeof(sConfigFile), "%s" CORRECT_PATH_SEPARATOR_S "%s", pszBaseConfigDir, TICKRATE_GAMECONFIG_PRELOAD_FILENAME);
+
+	CUtlVector<CUtlString> vecConfigFiles;
+
+	g_pFullFileSystem->FindFileAbsoluteList(vecConfigFiles, (const char *)sConfigFile, pszPathID);
+
+	if(vecConfigFiles.Count() < 1)
+	{
+		return false;
+	}
+
+	CUtlString sError;
+
+	AnyConfig::LoadFromFile_Generic_t aLoadPresets({{&sError, NULL, pszPathID}, g_KV3Format_Generic});
+
+	AnyConfig::Anyone aPreloadConfig;
+
+	aLoadPresets.m_pszFilename = vecConfigFiles[0].Get();
+
+	if(!aPreloadConfig.Load(aLoadPresets))
+	{
+		const char *pszMessageConcat[] = {"Failed to ", "load \"", sConfigFile, "\" file", ": ", sError.Get()};
+
+		vecMessages.AddToTail({pszMessageConcat});
+
+		return false;
+	}
+
+	KeyValues3 *pPreload = aPreloadConfig.Get()->FindMember("preload");
+
+	if(!pPreload)
+	{
+		const char *pszMessageConcat[] = {"Failed to ", "get \"", "preload", "\" array of \"", sConfigFile, "\" file"};
+
+		vecMessages.AddToTail({pszMessageConcat});
+
+		return false;
+	}
+
+	for(auto &bPreload : aOutput)
+	{
+		bPreload = false;
+	}
+
+	for(int i = 0, iCount = pPreload->GetArrayElementCount(); i < iCount; i++)
+	{
+		const char *pszName = pPreload->GetArrayElement(i)->GetString();
+
+		int iFound = -1;
+
+		for(int n = 0; n < CONFIG_MAX; n++)
+		{
+			if(!V_stricmp(sm_aConfigs[n].m_pszName, pszName))
+			{
+				iFound = n;
+
+				break;
+			}
+		}
+
+		if(iFound == -1)
+		{
+			const char *pszMessageConcat[] = {"Unknown \"", pszName, "\" gamedata of \"", sConfigFile, "\" file"};
+
+			vecMessages.AddToTail({pszMessageConcat});
+
+			continue;
+		}
+
+		aOutput[iFound] = true;
+	}
+
+	return true;
+}
+
+void Tickrate::Provider::GameDataStorage::Resolve(const bool (&aConfigs)[CONFIG_MAX], GameData::CBufferStringVector &vecMessages)
+{
+	const char *pszPathID = m_sPathID.Get();
+
+	// Each config is independent: its own file, game config and listeners.
+	struct Task_t
+	{
+		int m_iConfig;
+		bool m_bLoaded;
+		char m_sConfigFile[MAX_PATH];
+		AnyConfig::Anyone m_aGameConfig;
+		KeyValues3 m_aBlobConfig;
+		KeyValues3 *m_pGameConfig; // Of the file or the blob, otherwise failed to read or indexed of the blob.
+		int m_iBlobSource;
+		Index_t m_aIndex;
+		bool m_bIndexed; // The values are evaluated of the index, not loaded by GameData.
+		std::vector<CacheValue_t> m_vecValues;
+		CUtlVector<CUtlString> m_vecRepairedAddresses;
+		GameData::CBufferStringVector m_vecMessages;
+	} aTasks[CONFIG_MAX];
+
+	size_t nTaskCount = 0;
+
+	// Read on the main thread: the engine file system is not asked from workers.
+	for(int n = 0; n < CONFIG_MAX; n++)
+	{
+		if(!aConfigs[n] || m_aResolved[n] || m_aFailed[n])
+		{
+			continue;
+		}
+
+		const auto &aConfig = sm_aConfigs[n];
+
+		auto &aTask = aTasks[nTaskCount++];
+
+		aTask.m_iConfig = n;
+		aTask.m_bLoaded = false;
+		aTask.m_pGameConfig = nullptr;
+		aTask.m_iBlobSource = -1;
+		aTask.m_bIndexed = false;
+
+		const char *pszConfigFile = aTask.m_sConfigFile;
+
+		auto &vecTaskMessages = aTask.m_vecMessages;
+
+		snprintf((char *)aTask.m_sConfigFile, sizeof(aTask.m_sConfigFile), "%s" CORRECT_PATH_SEPARATOR_S "%s", m_sBaseConfigDir.Get(), aConfig.m_pszFilename);
+
+		CUtlVector<CUtlString> vecConfigFiles;
+
+		g_pFullFileSystem->FindFileAbsoluteList(vecConfigFiles, pszConfigFile, pszPathID);
+
+		int iBlobSource = m_aBlob.IsOpen() ? m_aBlob.FindSource(aConfig.m_pszFilename) : -1;
+
+		// The blob is stale when the source has been edited since compiling.
+		if(iBlobSource != -1 && (vecConfigFiles.Count() < 1 || GameDataBlob::IsFresh(m_aBlob.GetSource(iBlobSource), vecConfigFiles[0].Get())))
+		{
+			aTask.m_iBlobSource = iBlobSource;
+
+			// The index is read in place, the tree is rebuilt only to load by GameData.
+			if(!aConfig.m_bCacheable || !BuildIndex(m_aBlob, iBlobSource, aTask.m_aIndex))
+			{
+				LoadBlobNode(m_aBlob, m_aBlob.GetSource(iBlobSource).m_nRoot, &aTask.m_aBlobConfig);
+				aTask.m_pGameConfig = &aTask.m_aBlobConfig;
+			}
+
+			continue;
+		}
+
+		if(vecConfigFiles.Count() < 1)
+		{
+			const char *pszMessageConcat[] = {"Failed to ", "find \"", pszConfigFile, "\" file"};
+
+			vecTaskMessages.AddToTail({pszMessageConcat});
+
+			continue;
+		}
+
+		CUtlString sError;
+
+		AnyConfig::LoadFromFile_Generic_t aLoadPresets({{&sError, NULL, pszPathID}, g_KV3Format_Generic});
+
+		aLoadPresets.m_pszFilename = vecConfigFiles[0].Get();
+
+		if(!aTask.m_aGameConfig.Load(aLoadPresets))
+		{
+			const char *pszMessageConcat[] = {"Failed to ", "load \"", pszConfigFile, "\" file", ": ", sError.Get()};
+
+			vecTaskMessages.AddToTail({pszMessageConcat});
+
+			continue;
+		}
+
+		aTask.m_pGameConfig = aTask.m_aGameConfig.Get();
+	}
+
+	if(!nTaskCount)
+	{
+		return;
+	}
+
+	struct Library_t
+	{
+		const char *m_pszName;
+		SignatureScanner m_aScanner;
+		std::vector<Index_t::Signature_t *> m_vecSignatures;
+	};
+
+	std::vector<Library_t> vecLibraries;
+
+	// The signatures of the cacheable configs, grouped by library for one pass over each.
+	for(size_t n = 0; n < nTaskCount; n++)
+	{
+		auto &aTask = aTasks[n];
+
+		if(!aTask.m_aIndex.m_bValid && (!aTask.m_pGameConfig || !sm_aConfigs[aTask.m_iConfig].m_bCacheable || !BuildIndex(aTask.m_pGameConfig, aTask.m_aIndex)))
+		{
+			continue;
+		}
+
+		for(auto &aSignature : aTask.m_aIndex.m_vecSignatures)
+		{
+			const char *pszLibrary = aSignature.m_pszLibrary;
+
+			auto it = std::find_if(vecLibraries.begin(), vecLibraries.end(), [pszLibrary](const Library_t &aLibrary)
+			{
+				return !V_strcmp(aLibrary.m_pszName, pszLibrary);
+			});
+
+			if(it == vecLibraries.end())
+			{
+				it = vecLibraries.insert(vecLibraries.end(), Library_t {pszLibrary, {}, {}});
+			}
+
+			const auto &aPattern = aSignature.m_aPattern;
+
+			if(it->m_aScanner.Add(aPattern.m_pBytes, aPattern.m_pMask, aPattern.m_nLength) == -1)
+			{
+				aTask.m_aIndex.m_bValid = false;
+
+				continue;
+			}
+
+			it->m_vecSignatures.push_back(&aSignature);
+		}
+	}
+
+	std::vector<const uint8_t *> vecFound;
+
+	for(const auto &aLibrary : vecLibraries)
+	{
+		m_pRoot->ScanLibrary(aLibrary.m_pszName, aLibrary.m_aScanner, vecFound);
+
+		for(size_t n = 0; n < aLibrary.m_vecSignatures.size(); n++)
+		{
+			aLibrary.m_vecSignatures[n]->m_pFound = vecFound[n];
+		}
+	}
+
+	// Every signature is found: no GameData pass, no rescan.
+	for(size_t n = 0; n < nTaskCount; n++)
+	{
+		auto &aTask = aTasks[n];
+
+		if(EvaluateIndex((Config_t)aTask.m_iConfig, aTask.m_aIndex, aTask.m_vecValues))
+		{
+			aTask.m_bIndexed = true;
+			aTask.m_bLoaded = true;
+		}
+		else if(!aTask.m_pGameConfig && aTask.m_iBlobSource != -1)
+		{
+			LoadBlobNode(m_aBlob, m_aBlob.GetSource(aTask.m_iBlobSource).m_nRoot, &aTask.m_aBlobConfig);
+			aTask.m_pGameConfig = &aTask.m_aBlobConfig;
+		}
+	}
+
+	// The workers resolve the in-memory trees only: the signatures scan over the read-only modules, and the provider lookups are locked.
+	auto funcLoadConfig = [&](Task_t &aTask)
+	{
+		if(aTask.m_bIndexed || !aTask.m_pGameConfig)
+		{
+			return;
+		}
+
+		const auto &aConfig = sm_aConfigs[aTask.m_iConfig];
+
+		auto &vecTaskMessages = aTask.m_vecMessages;
+
+		CUtlVector<CUtlString> vecRepaired;
+
+		// Hot.
+		if(m_pRoot->RepairSignatures(aTask.m_pGameConfig, vecRepaired, vecTaskMessages))
+		{
+			for(int iGame = 0, iGameCount = aTask.m_pGameConfig->GetMemberCount(); iGame < iGameCount; iGame++)
+			{
+				KeyValues3 *pAddresses = aTask.m_pGameConfig->GetMember(iGame)->FindMember("Addresses");
+
+				for(int i = 0, iCount = pAddresses ? pAddresses->GetMemberCount() : 0; i < iCount; i++)
+				{
+					KeyValues3 *pSignature = pAddresses->GetMember(i)->FindMember("signature");
+
+					if(pSignature && vecRepaired.Find(CUtlString(pSignature->GetString())) != vecRepaired.InvalidIndex())
+					{
+						aTask.m_vecRepairedAddresses.AddToTail(pAddresses->GetMemberName(i));
+					}
+				}
+			}
+		}
+
+		aTask.m_bLoaded = (this->*(aConfig.m_pfnLoad))(m_pRoot, aTask.m_pGameConfig, vecTaskMessages);
+
+		if(!aTask.m_bLoaded)
+		{
+			const char *pszMessageConcat[] = {"Failed to ", "parse \"", aTask.m_sConfigFile, "\" file"};
+
+			vecTaskMessages.AddToTail({pszMessageConcat});
+		}
+	};
+
+	// Resolve on a worker pool.
+	if(nTaskCount == 1)
+	{
+		funcLoadConfig(aTasks[0]);
+	}
+	else
+	{
+		std::atomic<size_t> nNextTask(0);
+
+		auto funcWorker = [&]()
+		{
+			for(size_t n; (n = nNextTask.fetch_add(1, std::memory_order_relaxed)) < nTaskCount;)
+			{
+				funcLoadConfig(aTasks[n]);
+			}
+		};
+
+		size_t nWorkers = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1u), nTaskCount) - 1; // With the main thread.
+
+		std::vector<std::thread> vecWorkers;
+
+		vecWorkers.reserve(nWorkers);
+
+		for(size_t n = 0; n < nWorkers; n++)
+		{
+			vecWorkers.emplace_back(funcWorker);
+		}
+
+		funcWorker();
+
+		for(auto &aWorker : vecWorkers)
+		{
+			aWorker.join();
+		}
+	}
+
+	bool bHasCacheable = false;
+
+	// Join on the main thread in the fixed order: messages and the listener callbacks.
+	for(size_t n = 0; n < nTaskCount; n++)
+	{
+		auto &aTask = aTasks[n];
+
+		for(const auto &aMessage : aTask.m_vecMessages)
+		{
+			vecMessages.AddToTail(aMessage);
+		}
+
+		auto eConfig = (Config_t)aTask.m_iConfig;
+
+		if(aTask.m_bIndexed)
+		{
+			WriteCacheValues(eConfig, aTask.m_vecValues);
+		}
+		else
+		{
+			// A part of a failed one is committed too, it's neither resolved nor cached.
+			(this->*(sm_aConfigs[eConfig].m_pfnCommit))();
+		}
+
+		if(aTask.m_bLoaded && aTask.m_vecRepairedAddresses.Count())
+		{
+			if(ValidateRepaired(eConfig, aTask.m_vecRepairedAddresses, vecMessages))
+			{
+				m_aRepaired[eConfig] = true;
+			}
+			else
+			{
+				const char *pszMessageConcat[] = {"Refused \"", sm_aConfigs[eConfig].m_pszName, "\" gamedata", " of the repaired signatures, update the gamedata"};
+
+				vecMessages.AddToTail({pszMessageConcat});
+
+				ResetConfig(eConfig);
+				aTask.m_bLoaded = false;
+			}
+		}
+
+		if(!aTask.m_bLoaded)
+		{
+			m_aFailed[eConfig] = true;
+
+			continue;
+		}
+
+		m_aResolved[eConfig] = true;
+
+		// Derived of the validated addresses.
+		if(eConfig == CONFIG_HOSTFRAME)
+		{
+			m_aHostFrame.Derive();
+		}
+
+		bHasCacheable |= sm_aConfigs[eConfig].m_bCacheable;
+	}
+
+	if(bHasCacheable && m_funcResolvedCallback)
+	{
+		m_funcResolvedCallback(vecMessages);
+	}
+}
+
+void Tickrate::Provider::GameDataStorage::Require(Config_t eConfig) const
+{
+	if(m_aResolved[eConfig] || m_aFailed[eConfig] || !m_pRoot)
+	{
+		return;
+	}
+
+	// Resolves on first access of a getter, cached afterwards.
+	auto *pThis = const_cast<GameDataStorage *>(this);
+
+	bool aConfigs[CONFIG_MAX] = {};
+
+	aConfigs[eConfig] = true;
+
+	GameData::CBufferStringVector vecMessages;
+
+	pThis->Resolve(aConfigs, vecMessages);
+
+	if(vecMessages.Count())
+	{
+		m_pRoot->OnGameDataMessages(vecMessages);
+	}
+}
+
+void Tickrate::Provider::GameDataStorage::SetResolved(Config_t eConfig)
+{
+	Assert(sm_aConfigs[eConfig].m_bCacheable);
+
+	m_aResolved[eConfig] = true;
+
+	// Derived of the cached addresses.
+	if(eConfig == CONFIG_HOSTFRAME)
+	{
+		m_aHostFrame.Derive();
+	}
+}
+
+bool Tickrate::Provider::GameDataStorage::IsResolved(Config_t eConfig) const
+{
+	return m_aResolved[eConfig];
+}
+
+bool Tickrate::Provider::GameDataStorage::IsFailed(Config_t eConfig) const
+{
+	return m_aFailed[eConfig];
+}
+
+bool Tickrate::Provider::GameDataStorage::IsRepaired(Config_t eConfig) const
+{
+	return m_aRepaired[eConfig];
+}
+
+bool Tickrate::Provider::GameDataStorage::IsCacheable(Config_t eConfig)
+{
+	return sm_aConfigs[eConfig].m_bCacheable;
+}
+
+const char *Tickrate::Provider::GameDataStorage::GetConfigName(Config_t eConfig)
+{
+	return sm_aConfigs[eConfig].m_pszName;
+}
+
+Tickrate::Provider::GameDataStorage::Config_t Tickrate::Provider::GameDataStorage::FindConfig(const char *pszName)
+{
+	for(int n = 0; n < CONFIG_MAX; n++)
+	{
+		if(!V_stricmp(sm_aConfigs[n].m_pszName, pszName))
+		{
+			return (Config_t)n;
+		}
+	}
+
+	return CONFIG_MAX;
+}
+
+void Tickrate::Provider::GameDataStorage::SetResolvedCallback(std::function<void (GameData::CBufferStringVector &)> funcCallback)
+{
+	m_funcResolvedCallback = std::move(funcCallback);
+}
+
+void Tickrate::Provider::GameDataStorage::LoadBlobNode(const GameDataBlob &aBlob, uint32_t nNode, KeyValues3 *pOutput)
+{
+	const auto &aNode = aBlob.GetNode(nNode);
+
+	switch(aNode.m_nType)
+	{
+		case GameDataBlob::NODE_BOOL:
+		{
+			pOutput->SetBool(aNode.m_nInt != 0);
+
+			break;
+		}
+
+		case GameDataBlob::NODE_INT:
+		{
+			pOutput->SetInt64(aNode.m_nInt);
+
+			break;
+		}
+
+		case GameDataBlob::NODE_DOUBLE:
+		{
+			pOutput->SetDouble(aNode.m_dblDouble);
+
+			break;
+		}
+
+		case GameDataBlob::NODE_STRING:
+		{
+			pOutput->SetString(aBlob.GetString(aNode.m_nFirst));
+
+			break;
+		}
+
+		case GameDataBlob::NODE_ARRAY:
+		{
+			pOutput->SetArrayElementCount((int)aNode.m_nCount);
+
+			for(uint32_t n = 0; n < aNode.m_nCount; n++)
+			{
+				LoadBlobNode(aBlob, aNode.m_nFirst + n, pOutput->GetArrayElement((int)n));
+			}
+
+			break;
+		}
+
+		case GameDataBlob::NODE_TABLE:
+		{
+			pOutput->SetToEmptyTable();
+
+			for(uint32_t n = 0; n < aNode.m_nCount; n++)
+			{
+				uint32_t nChild = aNode.m_nFirst + n;
+
+				LoadBlobNode(aBlob, nChild, pOutput->FindOrCreateMember(aBlob.GetString(aBlob.GetNode(nChild).m_nName)));
+			}
+
+			break;
+		}
+
+		default:
+		{
+			pOutput->SetToNull();
+
+			break;
+		}
+	}
+}
+
+bool Tickrate::Provider::GameDataStorage::BuildIndex(KeyValues3 *pGameConfig, Index_t &aOutput)
+{
+	aOutput = {};
+
+	int nPatternCount = 0;
+
+	for(int iGame = 0, iGameCount = pGameConfig->GetMemberCount(); iGame < iGameCount; iGame++)
+	{
+		KeyValues3 *pGame = pGameConfig->GetMember(iGame);
+
+		if(pGame->GetType() != KV3_TYPE_TABLE)
+		{
+			continue; // "$schema".
+		}
+
+		KeyValues3 *pSignatures = pGame->FindMember("Signatures"), 
+		           *pPrologues = pGame->FindMember("Prologues");
+
+		nPatternCount += (pSignatures ? pSignatures->GetMemberCount() : 0) + (pPrologues ? pPrologues->GetMemberCount() : 0);
+	}
+
+	// The signatures and the prologues point to the patterns.
+	aOutput.m_vecPatterns.reserve(nPatternCount);
+
+	auto funcParse = [&aOutput](KeyValues3 *pPlatform, Index_t::Pattern_t &aPattern) -> bool
+	{
+		SignatureScanner::Pattern_t aParsed;
+
+		if(pPlatform->GetType() != KV3_TYPE_STRING || !SignatureScanner::Parse(pPlatform->GetString(), aParsed))
+		{
+			return false;
+		}
+
+		aOutput.m_vecPatterns.push_back(std::move(aParsed));
+
+		const auto &aStored = aOutput.m_vecPatterns.back();
+
+		aPattern = {aStored.m_vecBytes.data(), aStored.m_vecMask.data(), aStored.m_vecBytes.size()};
+
+		return true;
+	};
+
+	for(int iGame = 0, iGameCount = pGameConfig->GetMemberCount(); iGame < iGameCount; iGame++)
+	{
+		KeyValues3 *pGame = pGameConfig->GetMember(iGame);
+
+		if(pGame->GetType() != KV3_TYPE_TABLE)
+		{
+			continue;
+		}
+
+		for(int iSection = 0, iSectionCount = pGame->GetMemberCount(); iSection < iSectionCount; iSection++)
+		{
+			const char *pszSection = pGame->GetMemberName(iSection);
+
+			KeyValues3 *pSection = pGame->GetMember(iSection);
+
+			if(V_strcmp(pszSection, "Signatures") && V_strcmp(pszSection, "Addresses") && V_strcmp(pszSection, "Offsets") && V_strcmp(pszSection, "Prologues"))
+			{
+				return false;
+			}
+
+			for(int i = 0, iCount = pSection->GetMemberCount(); i < iCount; i++)
+			{
+				const char *pszName = pSection->GetMemberName(i);
+
+				KeyValues3 *pMember = pSection->GetMember(i), 
+				           *pPlatform = pMember->FindMember(TICKRATE_GAMECONFIG_PLATFORM);
+
+				if(!pPlatform)
+				{
+					continue; // Of another platform.
+				}
+
+				if(!V_strcmp(pszSection, "Signatures"))
+				{
+					KeyValues3 *pLibrary = pMember->FindMember("library");
+
+					Index_t::Pattern_t aPattern;
+
+					if(!pLibrary || !funcParse(pPlatform, aPattern))
+					{
+						return false;
+					}
+
+					aOutput.m_vecSignatures.push_back({pszName, pLibrary->GetString(), aPattern, nullptr});
+				}
+				else if(!V_strcmp(pszSection, "Addresses"))
+				{
+					KeyValues3 *pSignature = pMember->FindMember("signature");
+
+					// A single action only, the chains are left to GameData.
+					if(!pSignature || pPlatform->GetMemberCount() != 1)
+					{
+						return false;
+					}
+
+					const char *pszAction = pPlatform->GetMemberName(0);
+
+					KeyValues3 *pValue = pPlatform->GetMember(0);
+
+					if(pValue->GetType() != KV3_TYPE_INT && pValue->GetType() != KV3_TYPE_UINT)
+					{
+						return false;
+					}
+
+					Index_t::Action_t eAction;
+
+					if(!V_strcmp(pszAction, "offset"))
+					{
+						eAction = Index_t::ACTION_OFFSET;
+					}
+					else if(!V_strcmp(pszAction, "read_offs32"))
+					{
+						eAction = Index_t::ACTION_READ_OFFS32;
+					}
+					else
+					{
+						return false;
+					}
+
+					aOutput.m_vecAddresses.push_back({pszName, pSignature->GetString(), eAction, (ptrdiff_t)pValue->GetInt()});
+				}
+				else if(!V_strcmp(pszSection, "Offsets"))
+				{
+					if(pPlatform->GetType() != KV3_TYPE_INT && pPlatform->GetType() != KV3_TYPE_UINT)
+					{
+						return false;
+					}
+
+					aOutput.m_vecOffsets.push_back({pszName, (ptrdiff_t)pPlatform->GetInt()});
+				}
+				else // Prologues.
+				{
+					Index_t::Pattern_t aPattern;
+
+					if(!funcParse(pPlatform, aPattern))
+					{
+						return false;
+					}
+
+					aOutput.m_vecPrologues.push_back({pszName, aPattern});
+				}
+			}
+		}
+	}
+
+	aOutput.m_bValid = true;
+
+	return true;
+}
+
+bool Tickrate::Provider::GameDataStorage::BuildIndex(const GameDataBlob &aBlob, int iSource, Index_t &aOutput)
+{
+	aOutput = {};
+
+	const auto &aSource = aBlob.GetSource(iSource);
+
+	if(!(aSource.m_nFlags & GameDataBlob::SOURCE_INDEXED))
+	{
+		return false;
+	}
+
+	auto funcPattern = [&aBlob](uint32_t nBytes, uint32_t nLength) -> Index_t::Pattern_t
+	{
+		const uint8_t *pBytes = aBlob.GetBytes(nBytes);
+
+		return {pBytes, pBytes + nLength, nLength};
+	};
+
+	aOutput.m_vecSignatures.reserve(aSource.m_aSignatures.m_nCount);
+
+	for(uint32_t n = 0; n < aSource.m_aSignatures.m_nCount; n++)
+	{
+		const auto &aSignature = aBlob.GetSignature(aSource.m_aSignatures.m_nFirst + n);
+
+		aOutput.m_vecSignatures.push_back({aBlob.GetString(aSignature.m_nName), aBlob.GetString(aSignature.m_nLibrary), funcPattern(aSignature.m_nBytes, aSignature.m_nLength), nullptr});
+	}
+
+	aOutput.m_vecAddresses.reserve(aSource.m_aAddresses.m_nCount);
+
+	for(uint32_t n = 0; n < aSource.m_aAddresses.m_nCount; n++)
+	{
+		const auto &aAddress = aBlob.GetAddress(aSource.m_aAddresses.m_nFirst + n);
+
+		if(aAddress.m_nAction >= GameDataBlob::ADDRESS_ACTION_MAX)
+		{
+			return false;
+		}
+
+		aOutput.m_vecAddresses.push_back({aBlob.GetString(aAddress.m_nName), aBlob.GetString(aAddress.m_nSignature), aAddress.m_nAction == GameDataBlob::ADDRESS_READ_OFFS32 ? Index_t::ACTION_READ_OFFS32 : Index_t::ACTION_OFFSET, (ptrdiff_t)aAddress.m_nValue});
+	}
+
+	aOutput.m_vecOffsets.reserve(aSource.m_aOffsets.m_nCount);
+
+	for(uint32_t n = 0; n < aSource.m_aOffsets.m_nCount; n++)
+	{
+		const auto &aOffset = aBlob.GetOffset(aSource.m_aOffsets.m_nFirst + n);
+
+		aOutput.m_vecOffsets.push_back({aBlob.GetString(aOffset.m_nName), (ptrdiff_t)aOffset.m_nValue});
+	}
+
+	aOutput.m_vecPrologues.reserve(aSource.m_aPrologues.m_nCount);
+
+	for(uint32_t n = 0; n < aSource.m_aPrologues.m_nCount; n++)
+	{
+		const auto &aPrologue = aBlob.GetPrologue(aSource.m_aPrologues.m_nFirst + n);
+
+		aOutput.m_vecPrologues.push_back({aBlob.GetString(aPrologue.m_nName), funcPattern(aPrologue.m_nBytes, aPrologue.m_nLength)});
+	}
+
+	aOutput.m_bValid = true;
+
+	return true;
+}
+
+bool Tickrate::Provider::GameDataStorage::EvaluateIndex(Config_t eConfig, const Index_t &aIndex, std::vector<CacheValue_t> &vecOutput)
+{
+	if(!aIndex.m_bValid)
+	{
+		return false;
+	}
+
+	CUtlVector<CacheEntry_t> vecEntries;
+
+	GetCacheEntries(eConfig, vecEntries);
+
+	vecOutput.assign(vecEntries.Count(), {});
+
+	auto funcFind = [](const auto &vecItems, const char *pszName)
+	{
+		return std::find_if(vecItems.begin(), vecItems.end(), [pszName](const auto &aItem)
+		{
+			return !V_strcmp(aItem.m_pszName, pszName);
+		});
+	};
+
+	static const char s_szPrologueSuffix[] = "::prologue";
+
+	// One absent of the index is of another platform, it keeps the reset value as with GameData.
+
+	FOR_EACH_VEC(vecEntries, i)
+	{
+		const auto &aEntry = vecEntries[i];
+
+		auto &aValue = vecOutput[i];
+
+		if(aEntry.m_ppAddress)
+		{
+			auto itAddress = funcFind(aIndex.m_vecAddresses, aEntry.m_pszName);
+
+			if(itAddress == aIndex.m_vecAddresses.end())
+			{
+				continue;
+			}
+
+			auto itSignature = funcFind(aIndex.m_vecSignatures, itAddress->m_pszSignature);
+
+			if(itSignature == aIndex.m_vecSignatures.end() || !itSignature->m_pFound)
+			{
+				return false;
+			}
+
+			const uint8_t *pAddress = itSignature->m_pFound + itAddress->m_nValue;
+
+			if(itAddress->m_eAction == Index_t::ACTION_READ_OFFS32)
+			{
+				// Relative to the end of the displacement, as "[rip+disp32]" and "call rel32".
+				if(!m_pRoot->FindLibrarySegment(pAddress, sizeof(int32_t)))
+				{
+					return false;
+				}
+
+				int32_t nDisplacement;
+
+				memcpy(&nDisplacement, pAddress, sizeof(nDisplacement));
+
+				pAddress += sizeof(int32_t) + nDisplacement;
+			}
+
+			aValue.m_pAddress = const_cast<uint8_t *>(pAddress);
+			aValue.m_bFound = true;
+		}
+		else if(aEntry.m_pnOffset)
+		{
+			auto itOffset = funcFind(aIndex.m_vecOffsets, aEntry.m_pszName);
+
+			if(itOffset == aIndex.m_vecOffsets.end())
+			{
+				continue;
+			}
+
+			aValue.m_nOffset = itOffset->m_nValue;
+			aValue.m_bFound = true;
+		}
+		else
+		{
+			size_t nLength = strlen(aEntry.m_pszName);
+
+			if(nLength < sizeof(s_szPrologueSuffix) - 1 || V_strcmp(aEntry.m_pszName + nLength - (sizeof(s_szPrologueSuffix) - 1), s_szPrologueSuffix))
+			{
+				continue;
+			}
+
+			size_t nFunctionLength = nLength - (sizeof(s_szPrologueSuffix) - 1);
+
+			auto itPrologue = std::find_if(aIndex.m_vecPrologues.begin(), aIndex.m_vecPrologues.end(), [&aEntry, nFunctionLength](const Index_t::Prologue_t &aPrologue)
+			{
+				return strlen(aPrologue.m_pszName) == nFunctionLength && !V_strncmp(aPrologue.m_pszName, aEntry.m_pszName, (int)nFunctionLength);
+			});
+
+			if(itPrologue == aIndex.m_vecPrologues.end())
+			{
+				continue;
+			}
+
+			const auto &aPattern = itPrologue->m_aPattern;
+
+			aValue.m_aPattern.m_vecBytes.assign(aPattern.m_pBytes, aPattern.m_pBytes + aPattern.m_nLength);
+			aValue.m_aPattern.m_vecMask.assign(aPattern.m_pMask, aPattern.m_pMask + aPattern.m_nLength);
+			aValue.m_bFound = true;
+		}
+	}
+
+	return true;
+}
+
+void Tickrate::Provider::GameDataStorage::Reset()
+{
+	for(auto &bResolved : m_aResolved)
+	{
+		bResolved = false;
+	}
+
+	for(auto &bFailed : m_aFailed)
+	{
+		bFailed = false;
+	}
+
+	for(auto &bRepaired : m_aRepaired)
+	{
+		bRepaired = false;
+	}
+
+	m_funcResolvedCallback = nullptr;
+
+	m_aGameResource.Reset();
+	m_aGameSystem.Reset();
+	m_aHostFrame.Reset();
+	m_aPatches.Reset();
+	m_aSource2Server.Reset();
+	m_aTick.Reset();
+}
+
+void Tickrate::Provider::GameDataStorage::CDeferredCallbacks::Add(std::function<void ()> funcCallback)
+{
+	m_vecCallbacks.push_back(std::move(funcCallback));
+}
+
+void Tickrate::Provider::GameDataStorage::CDeferredCallbacks::Run()
+{
+	for(const auto &funcCallback : m_vecCallbacks)
+	{
+		funcCallback();
+	}
+
+	m_vecCallbacks.clear();
+}
+
+void Tickrate::Provider::GameDataStorage::CDeferredCallbacks::Clear()
+{
+	m_vecCallbacks.clear();
+}
+
+void Tickrate::Provider::GameDataStorage::GetCacheEntries(Config_t eConfig, CUtlVector<CacheEntry_t> &vecOutput)
+{
+	switch(eConfig)
+	{
+		case CONFIG_GAMERESOURCE:
+		{
+			m_aGameResource.GetCacheEntries(vecOutput);
+
+			break;
+		}
+
+		case CONFIG_GAMESYSTEM:
+		{
+			m_aGameSystem.GetCacheEntries(vecOutput);
+
+			break;
+		}
+
+		case CONFIG_HOSTFRAME:
+		{
+			m_aHostFrame.GetCacheEntries(vecOutput);
+
+			break;
+		}
+
+		case CONFIG_SOURCE2SERVER:
+		{
+			m_aSource2Server.GetCacheEntries(vecOutput);
+
+			break;
+		}
+
+		case CONFIG_TICK:
+		{
+			m_aTick.GetCacheEntries(vecOutput);
+
+			break;
+		}
+
+		default: // Not cacheable.
+		{
+			break;
+		}
+	}
+}
+
+void Tickrate::Provider::GameDataStorage::WriteCacheValues(Config_t eConfig, const std::vector<CacheValue_t> &vecValues)
+{
+	CUtlVector<CacheEntry_t> vecEntries;
+
+	GetCacheEntries(eConfig, vecEntries);
+
+	Assert((size_t)vecEntries.Count() == vecValues.size());
+
+	FOR_EACH_VEC(vecEntries, i)
+	{
+		const auto &aEntry = vecEntries[i];
+
+		const auto &aValue = vecValues[i];
+
+		if(!aValue.m_bFound)
+		{
+			continue;
+		}
+
+		if(aEntry.m_ppAddress)
+		{
+			*aEntry.m_ppAddress = aValue.m_pAddress;
+		}
+		else if(aEntry.m_pnOffset)
+		{
+			*aEntry.m_pnOffset = aValue.m_nOffset;
+		}
+		else
+		{
+			*aEntry.m_pPattern = aValue.m_aPattern;
+		}
+	}
+}
+
+bool Tickrate::Provider::GameDataStorage::ValidateRepaired(Config_t eConfig, const CUtlVector<CUtlString> &vecAddresses, GameData::CBufferStringVector &vecMessages)
+{
+	CUtlVector<CacheEntry_t> vecEntries;
+
+	GetCacheEntries(eConfig, vecEntries);
+
+	bool bResult = true;
+
+	for(const auto &aEntry : vecEntries)
+	{
+		if(!aEntry.m_ppAddress || !*aEntry.m_ppAddress || vecAddresses.Find(CUtlString(aEntry.m_pszName)) == vecAddresses.InvalidIndex())
+		{
+			continue;
+		}
+
+		if(!m_pRoot->FindLibrarySegment(*aEntry.m_ppAddress, sizeof(void *)))
+		{
+			const char *pszMessageConcat[] = {"Failed to ", "validate \"", aEntry.m_pszName, "\" address", ": ", "out of the library segments"};
+
+			vecMessages.AddToTail({pszMessageConcat});
+
+			bResult = false;
+		}
+	}
+
+	if(!bResult)
+	{
+		return false;
+	}
+
+#ifndef _WIN32
+	// A function of a repaired signature is called to get the frame, its old offset could be of another code.
+	if(eConfig == CONFIG_HOSTFRAME && vecAddresses.Find(CUtlString("GetHostFrame")) != vecAddresses.InvalidIndex())
+	{
+		const char *pszMessageConcat[] = {"Failed to ", "validate \"", "GetHostFrame", "\" address", ": ", "not called of a repaired signature"};
+
+		vecMessages.AddToTail({pszMessageConcat});
+
+		return false;
+	}
+#endif
+
+	if(eConfig != CONFIG_TICK)
+	{
+		return true;
+	}
+
+	// Each tick value is of a plausible tickrate, as the operand patches expect.
+	auto funcIsPlausible = [](double dblTicks) -> bool
+	{
+		return dblTicks >= TICKRATE_GAMECONFIG_REPAIRED_TICKRATE_MIN && dblTicks <= TICKRATE_GAMECONFIG_REPAIRED_TICKRATE_MAX && std::abs(dblTicks - std::round(dblTicks)) < 0.01;
+	};
+
+	const struct
+	{
+		const char *pszName;
+		const void *pValue;
+		size_t nSize;
+		bool bInterval;
+	} aValues[] =
+	{
+		{"&tick_interval", m_aTick.GetIntervalPointer(), sizeof(float), true},
+		{"&(double)tick_interval", m_aTick.GetInterval2Pointer(), sizeof(double), true},
+		{"&tick_interval3_default", m_aTick.GetInterval3DefaultPointer(), sizeof(float), true},
+		{"&tick_interval3", m_aTick.GetInterval3Pointer(), sizeof(float), true},
+		{"&ticks_per_second", m_aTick.GetPerSecond(), sizeof(float), false},
+	};
+
+	for(const auto &aValue : aValues)
+	{
+		if(!aValue.pValue || vecAddresses.Find(CUtlString(aValue.pszName)) == vecAddresses.InvalidIndex())
+		{
+			continue;
+		}
+
+		double dblValue = 0.0;
+
+		if(m_pRoot->FindLibrarySegment(aValue.pValue, aValue.nSize))
+		{
+			dblValue = aValue.nSize == sizeof(double) ? *reinterpret_cast<const double *>(aValue.pValue) : *reinterpret_cast<const float *>(aValue.pValue);
+		}
+
+		if(!funcIsPlausible(aValue.bInterval ? (dblValue > 0.0 ? 1.0 / dblValue : 0.0) : dblValue))
+		{
+			const char *pszMessageConcat[] = {"Failed to ", "validate \"", aValue.pszName, "\" address", ": ", "not a plausible tick value"};
+
+			vecMessages.AddToTail({pszMessageConcat});
+
+			bResult = false;
+		}
+	}
+
+	return bResult;
+}
+
+void Tickrate::Provider::GameDataStorage::ResetConfig(Config_t eConfig)
+{
+	switch(eConfig)
+	{
+		case CONFIG_GAMERESOURCE:
+		{
+			m_aGameResource.Reset();
+
+			break;
+		}
+
+		case CONFIG_GAMESYSTEM:
+		{
+			m_aGameSystem.Reset();
+
+			break;
+		}
+
+		case CONFIG_HOSTFRAME:
+		{
+			m_aHostFrame.Reset();
+
+			break;
+		}
+
+		case CONFIG_PATCHES:
+		{
+			m_aPatches.Reset();
+
+			break;
+		}
+
+		case CONFIG_SOURCE2SERVER:
+		{
+			m_aSource2Server.Reset();
+
+			break;
+		}
+
+		case CONFIG_TICK:
+		{
+			m_aTick.Reset();
+
+			break;
+		}
+
+		default:
+		{
+			break;
+		}
+	}
+}
+
+bool Tickrate::Provider::GameDataStorage::LoadGameResource(IGameData *pRoot, KeyValues3 *pGameConfig, GameData::CBufferStringVector &vecMessages)
+{
+	return m_aGameResource.Load(pRoot, pGameConfig, vecMessages);
+}
+
+bool Tickrate::Provider::GameDataStorage::LoadGameSystem(IGameData *pRoot, KeyValues3 *pGameConfig, GameData::CBufferStringVector &vecMessages)
+{
+	return m_aGameSystem.Load(pRoot, pGameConfig, vecMessages);
+}
+
+bool Tickrate::Provider::GameDataStorage::LoadHostFrame(IGameData *pRoot, KeyValues3 *pGameConfig, GameData::CBufferStringVector &vecMessages)
+{
+	return m_aHostFrame.Load(pRoot, pGameConfig, vecMessages);
+}
+
+bool Tickrate::Provider::GameDataStorage::LoadPatches(IGameData *pRoot, KeyValues3 *pGameConfig, GameData::CBufferStringVector &vecMessages)
+{
+	return m_aPatches.Load(pRoot, pGameConfig, vecMessages);
+}
+
+bool Tickrate::Provider::GameDataStorage::LoadSource2Server(IGameData *pRoot, KeyValues3 *pGameConfig, GameData::CBufferStringVector &vecMessages)
+{
+	return m_aSource2Server.Load(pRoot, pGameConfig, vecMessages);
+}
+
+bool Tickrate::Provider::GameDataStorage::LoadTick(IGameData *pRoot, KeyValues3 *pGameConfig, GameData::CBufferStringVector &vecMessages)
+{
+	return m_aTick.Load(pRoot, pGameConfig, vecMessages);
+}
+
+void Tickrate::Provider::GameDataStorage::CommitGameResource()
+{
+	m_aGameResource.Commit();
+}
+
+void Tickrate::Provider::GameDataStorage::CommitGameSystem()
+{
+	m_aGameSystem.Commit();
+}
+
+void Tickrate::Provider::GameDataStorage::CommitHostFrame()
+{
+	m_aHostFrame.Commit();
+}
+
+void Tickrate::Provider::GameDataStorage::CommitPatches()
+{
+	m_aPatches.Commit();
+}
+
+void Tickrate::Provider::GameDataStorage::CommitSource2Server()
+{
+	m_aSource2Server.Commit();
+}
+
+void Tickrate::Provider::GameDataStorage::CommitTick()
+{
+	m_aTick.Commit();
+}
+
+const Tickrate::Provider::GameDataStorage::CGameResource &Tickrate::Provider::GameDataStorage::GetGameResource() const
+{
+	Require(CONFIG_GAMERESOURCE);
+
+	return m_aGameResource;
+}
+
+const Tickrate::Provider::GameDataStorage::CGameSystem &Tickrate::Provider::GameDataStorage::GetGameSystem() const
+{
+	Require(CONFIG_GAMESYSTEM);
+
+	return m_aGameSystem;
+}
+
+const Tickrate::Provider::GameDataStorage::CHostFrame &Tickrate::Provider::GameDataStorage::GetHostFrame() const
+{
+	Require(CONFIG_HOSTFRAME);
+
+	return m_aHostFrame;
+}
+
+const Tickrate::Provider::GameDataStorage::CPatches &Tickrate::Provider::GameDataStorage::GetPatches() const
+{
+	Require(CONFIG_PATCHES);
+
+	return m_aPatches;
+}
+
+const Tickrate::Provider::GameDataStorage::CSource2Server &Tickrate::Provider::GameDataStorage::GetSource2Server() const
+{
+	Require(CONFIG_SOURCE2SERVER);
+
+	return m_aSource2Server;
+}
+
+const Tickrate::Provider::GameDataStorage::CTick &Tickrate::Provider::GameDataStorage::GetTick() const
+{
+	Require(CONFIG_TICK);
+
 	return m_aTick;
 }
 
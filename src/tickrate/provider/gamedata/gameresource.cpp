@@ -29,7 +29,10 @@ Tickrate::Provider::GameDataStorage::CGameResource::CGameResource()
 
 		aCallbacks.Insert(m_aGameConfig.GetSymbol("CGameResourceService::m_pEntitySystem"), [&](const CUtlSymbolLarge &aKey, const ptrdiff_t &nOffset)
 		{
-			m_nEntitySystemOffset = nOffset;
+			m_aDeferred.Add([this, nOffset]()
+			{
+				m_nEntitySystemOffset = nOffset;
+			});
 		});
 
 
@@ -42,11 +45,23 @@ bool Tickrate::Provider::GameDataStorage::CGameResource::Load(IGameData *pRoot,
 	return m_aGameConfig.Load(pRoot, pGameConfig, vecMessages);
 }
 
+void Tickrate::Provider::GameDataStorage::CGameResource::Commit()
+{
+	m_aDeferred.Run();
+}
+
 void Tickrate::Provider::GameDataStorage::CGameResource::Reset()
 {
+	m_aDeferred.Clear();
+
 	m_nEntitySystemOffset = -1;
 }
 
+void Tickrate::Provider::GameDataStorage::CGameResource::GetCacheEntries(CUtlVector<CacheEntry_t> &vecOutput)
+{
+	vecOutput.AddToTail({"CGameResourceService::m_pEntitySystem", nullptr, &m_nEntitySystemOffset});
+}
+
 ptrdiff_t Tickrate::Provider::GameDataStorage::CGameResource::GetEntitySystemOffset() const
 {
 	return m_nEntitySystemOffset;
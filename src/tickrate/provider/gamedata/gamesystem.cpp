@@ -28,7 +28,10 @@ Tickrate::Provider::GameDataStorage::CGameSystem::CGameSystem()
 
 		aCallbacks.Insert(m_aGameConfig.GetSymbol("CBaseGameSystemFactory::sm_pFirst"), [&](const CUtlSymbolLarge &aKey, const DynLibUtils::CMemory &aAddress)
 		{
-			m_ppFirst = aAddress.RCast<decltype(m_ppFirst)>();
+			m_aDeferred.Add([this, aAddress]()
+			{
+				m_ppFirst = aAddress.RCast<decltype(m_ppFirst)>();
+			});
 		});
 
 		m_aGameConfig.GetAddresses().AddListener(&aCallbacks);
@@ -40,11 +43,23 @@ bool Tickrate::Provider::GameDataStorage::CGameSystem::Load(IGameData *pRoot, Ke
 	return m_aGameConfig.Load(pRoot, pGameConfig, vecMessages);
 }
 
+void Tickrate::Provider::GameDataStorage::CGameSystem::Commit()
+{
+	m_aDeferred.Run();
+}
+
 void Tickrate::Provider::GameDataStorage::CGameSystem::Reset()
 {
+	m_aDeferred.Clear();
+
 	m_ppFirst = nullptr;
 }
 
+void Tickrate::Provider::GameDataStorage::CGameSystem::GetCacheEntries(CUtlVector<CacheEntry_t> &vecOutput)
+{
+	vecOutput.AddToTail({"CBaseGameSystemFactory::sm_pFirst", reinterpret_cast<void **>(&m_ppFirst), nullptr});
+}
+
 CBaseGameSystemFactory **Tickrate::Provider::GameDataStorage::CGameSystem::GetFirstPointer() const
 {
 	return m_ppFirst;
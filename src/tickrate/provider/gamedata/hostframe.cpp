@@ -31,12 +31,18 @@ Tickrate::Provider::GameDataStorage::CHostFrame::CHostFrame()
 #ifdef _WIN32
 		aCallbacks.Insert(m_aGameConfig.GetSymbol("&s_pHostFrameSingleton->time_unbounded"), [&](const CUtlSymbolLarge &, const DynLibUtils::CMemory &aAddress)
 		{
-			m_p = (CFrame *)(aAddress.CCast<ptrdiff_t>() - offsetof(CFrame, time_unbounded));
+			m_aDeferred.Add([this, aAddress]()
+			{
+				m_pAddress = aAddress.RCast<void *>(); // Derived after a validation.
+			});
 		});
 #else
 		aCallbacks.Insert(m_aGameConfig.GetSymbol("GetHostFrame"), [&](const CUtlSymbolLarge &, const DynLibUtils::CMemory &aAddress)
 		{
-			m_p = (*aAddress.UCast<CFrame *(*)()>())();
+			m_aDeferred.Add([this, aAddress]()
+			{
+				m_pAddress = aAddress.RCast<void *>(); // Derived after a validation.
+			});
 		});
 #endif
 
@@ -49,11 +55,45 @@ bool Tickrate::Provider::GameDataStorage::CHostFrame::Load(IGameData *pRoot, Key
 	return m_aGameConfig.Load(pRoot, pGameConfig, vecMessages);
 }
 
+void Tickrate::Provider::GameDataStorage::CHostFrame::Commit()
+{
+	m_aDeferred.Run();
+}
+
 void Tickrate::Provider::GameDataStorage::CHostFrame::Reset()
 {
+	m_aDeferred.Clear();
+
+	m_pAddress = nullptr;
 	m_p = nullptr;
 }
 
+void Tickrate::Provider::GameDataStorage::CHostFrame::GetCacheEntries(CUtlVector<CacheEntry_t> &vecOutput)
+{
+	// The gamedata entry, the frame is derived.
+#ifdef _WIN32
+	vecOutput.AddToTail({"&s_pHostFrameSingleton->time_unbounded", &m_pAddress, nullptr});
+#else
+	vecOutput.AddToTail({"GetHostFrame", &m_pAddress, nullptr});
+#endif
+}
+
+void Tickrate::Provider::GameDataStorage::CHostFrame::Derive()
+{
+	if(!m_pAddress)
+	{
+		m_p = nullptr;
+
+		return;
+	}
+
+#ifdef _WIN32
+	m_p = (CFrame *)(reinterpret_cast<uintptr_t>(m_pAddress) - offsetof(CFrame, time_unbounded));
+#else
+	m_p = (reinterpret_cast<CFrame *(*)()>(m_pAddress))();
+#endif
+}
+
 CFrame *Tickrate::Provider::GameDataStorage::CHostFrame::GetPointer() const
 {
 	return m_p;
@@ -0,0 +1,176 @@
+/**
+ * vim: set ts=4 sw=4 tw=99 noet :
+ * ======================================================
+ * Metamod:Source Tickrate
+ * Written by Wend4r (Vladimir Ezhikov).
+ * ======================================================
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <tickrate/provider.hpp>
+
+Tickrate::Provider::GameDataStorage::CPatches::CPatches()
+{
+	// The address callbacks are inserted by names of the config.
+	m_aGameConfig.GetAddresses().AddListener(&m_aAddressCallbacks);
+}
+
+bool Tickrate::Provider::GameDataStorage::CPatches::Load(IGameData *pRoot, KeyValues3 *pGameConfig, GameData::CBufferStringVector &vecMessages)
+{
+	for(int iGame = 0, iGameCount = pGameConfig->GetMemberCount(); iGame < iGameCount; iGame++)
+	{
+		KeyValues3 *pGame = pGameConfig->GetMember(iGame), 
+		           *pPatches = pGame->FindMember("Patches");
+
+		if(!pPatches)
+		{
+			continue;
+		}
+
+		for(int i = 0, iCount = pPatches->GetMemberCount(); i < iCount; i++)
+		{
+			ParseOperand(pPatches->GetMemberName(i), pPatches->GetMember(i), vecMessages);
+		}
+
+		// Not a section of the game config.
+		pGame->RemoveMember("Patches");
+	}
+
+	return m_aGameConfig.Load(pRoot, pGameConfig, vecMessages);
+}
+
+void Tickrate::Provider::GameDataStorage::CPatches::Commit()
+{
+	m_aDeferred.Run();
+}
+
+void Tickrate::Provider::GameDataStorage::CPatches::Reset()
+{
+	m_aDeferred.Clear();
+
+	m_vecOperands.Purge();
+}
+
+const CUtlVector<Tickrate::Provider::GameDataStorage::CPatches::Operand_t> &Tickrate::Provider::GameDataStorage::CPatches::GetOperands() const
+{
+	return m_vecOperands;
+}
+
+size_t Tickrate::Provider::GameDataStorage::CPatches::GetTypeSize(Type_t eType)
+{
+	return eType == TYPE_DOUBLE ? sizeof(double) : sizeof(float);
+}
+
+bool Tickrate::Provider::GameDataStorage::CPatches::ParseOperand(const char *pszName, KeyValues3 *pOperand, GameData::CBufferStringVector &vecMessages)
+{
+	KeyValues3 *pPlatform = pOperand->FindMember(TICKRATE_GAMECONFIG_PLATFORM);
+
+	// The platform section overrides the common members.
+	auto funcFindMember = [pOperand, pPlatform](const char *pszMember) -> KeyValues3 *
+	{
+		KeyValues3 *pMember = pPlatform ? pPlatform->FindMember(pszMember) : nullptr;
+
+		return pMember ? pMember : pOperand->FindMember(pszMember);
+	};
+
+	auto funcFindIndex = [](KeyValues3 *pMember, const char *const *ppszNames, int nCount) -> int
+	{
+		const char *pszValue = pMember ? pMember->GetString() : nullptr;
+
+		if(pszValue)
+		{
+			for(int n = 0; n < nCount; n++)
+			{
+				if(!V_stricmp(ppszNames[n], pszValue))
+				{
+					return n;
+				}
+			}
+		}
+
+		return -1;
+	};
+
+	static const char *s_pszKinds[] = {"immediate", "rip_relative"}, 
+	                  *s_pszTypes[] = {"float", "double", "int32"}, 
+	                  *s_pszValues[] = {"interval", "ticks_per_second"};
+
+	int iKind = funcFindIndex(funcFindMember("operand"), s_pszKinds, ARRAYSIZE(s_pszKinds)), 
+	    iType = funcFindIndex(funcFindMember("type"), s_pszTypes, ARRAYSIZE(s_pszTypes)), 
+	    iValue = funcFindIndex(funcFindMember("value"), s_pszValues, ARRAYSIZE(s_pszValues));
+
+	KeyValues3 *pAddress = funcFindMember("address"), 
+	           *pOffset = funcFindMember("operand_offset"), 
+	           *pInstructionSize = funcFindMember("instruction_size"), 
+	           *pExpected = funcFindMember("expected");
+
+	const char *pszError = nullptr;
+
+	if(iKind == -1)
+	{
+		pszError = "unknown \"operand\"";
+	}
+	else if(iType == -1)
+	{
+		pszError = "unknown \"type\"";
+	}
+	else if(iValue == -1)
+	{
+		pszError = "unknown \"value\"";
+	}
+	else if(!pExpected)
+	{
+		pszError = "no \"expected\" value";
+	}
+	else if(iKind == KIND_RIP_RELATIVE && (!pInstructionSize || pInstructionSize->GetInt() < (pOffset ? pOffset->GetInt() : 0) + (int)sizeof(int32_t)))
+	{
+		pszError = "no \"instruction_size\" past the displacement";
+	}
+
+	if(pszError)
+	{
+		const char *pszMessageConcat[] = {"Failed to ", "parse \"", pszName, "\" patch", ": ", pszError};
+
+		vecMessages.AddToTail({pszMessageConcat});
+
+		return false;
+	}
+
+	int iOperand = m_vecOperands.AddToTail();
+
+	auto &aOperand = m_vecOperands[iOperand];
+
+	aOperand.m_sName = pszName;
+	aOperand.m_eKind = (Kind_t)iKind;
+	aOperand.m_iOffset = pOffset ? pOffset->GetInt() : 0;
+	aOperand.m_iInstructionSize = pInstructionSize ? pInstructionSize->GetInt() : 0;
+	aOperand.m_eType = (Type_t)iType;
+	aOperand.m_eValue = (Value_t)iValue;
+	aOperand.m_dblExpected = pExpected->GetDouble();
+
+	// An address of the same name by default.
+	m_aAddressCallbacks.Insert(m_aGameConfig.GetSymbol(pAddress ? pAddress->GetString() : pszName), [this, iOperand](const CUtlSymbolLarge &, const DynLibUtils::CMemory &aAddress)
+	{
+		m_aDeferred.Add([this, iOperand, aAddress]()
+		{
+			if(iOperand < m_vecOperands.Count())
+			{
+				m_vecOperands[iOperand].m_pInstruction = aAddress.RCast<uint8_t *>();
+			}
+		});
+	});
+
+	return true;
+}
@@ -28,7 +28,10 @@ Tickrate::Provider::GameDataStorage::CSource2Server::CSource2Server()
 
 		aCallbacks.Insert(m_aGameConfig.GetSymbol("&s_GameEventManager"), [&](const CUtlSymbolLarge &, const DynLibUtils::CMemory &aAddress)
 		{
-			m_ppGameEventManager = aAddress.RCast<decltype(m_ppGameEventManager)>();
+			m_aDeferred.Add([this, aAddress]()
+			{
+				m_ppGameEventManager = aAddress.RCast<decltype(m_ppGameEventManager)>();
+			});
 		});
 
 		m_aGameConfig.GetAddresses().AddListener(&aCallbacks);
@@ -40,11 +43,23 @@ bool Tickrate::Provider::GameDataStorage::CSource2Server::Load(IGameData *pRoot,
 	return m_aGameConfig.Load(pRoot, pGameConfig, vecMessages);
 }
 
+void Tickrate::Provider::GameDataStorage::CSource2Server::Commit()
+{
+	m_aDeferred.Run();
+}
+
 void Tickrate::Provider::GameDataStorage::CSource2Server::Reset()
 {
+	m_aDeferred.Clear();
+
 	m_ppGameEventManager = nullptr;
 }
 
+void Tickrate::Provider::GameDataStorage::CSource2Server::GetCacheEntries(CUtlVector<CacheEntry_t> &vecOutput)
+{
+	vecOutput.AddToTail({"&s_GameEventManager", reinterpret_cast<void **>(&m_ppGameEventManager), nullptr});
+}
+
 CGameEventManager **Tickrate::Provider::GameDataStorage::CSource2Server::GetGameEventManagerPointer() const
 {
 	return m_ppGameEventManager;
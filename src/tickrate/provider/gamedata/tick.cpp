@@ -28,27 +28,50 @@ Tickrate::Provider::GameDataStorage::CTick::CTick()
 
 		aCallbacks.Insert(m_aGameConfig.GetSymbol("&tick_interval"), [&](const CUtlSymbolLarge &, const DynLibUtils::CMemory &aAddress)
 		{
-			m_pInterval = aAddress.RCast<decltype(m_pInterval)>();
+			m_aDeferred.Add([this, aAddress]()
+			{
+				m_pInterval = aAddress.RCast<decltype(m_pInterval)>();
+			});
 		});
 
 		aCallbacks.Insert(m_aGameConfig.GetSymbol("&(double)tick_interval"), [&](const CUtlSymbolLarge &, const DynLibUtils::CMemory &aAddress)
 		{
-			m_pInterval2 = aAddress.RCast<decltype(m_pInterval2)>();
+			m_aDeferred.Add([this, aAddress]()
+			{
+				m_pInterval2 = aAddress.RCast<decltype(m_pInterval2)>();
+			});
 		});
 
 		aCallbacks.Insert(m_aGameConfig.GetSymbol("&tick_interval3_default"), [&](const CUtlSymbolLarge &, const DynLibUtils::CMemory &aAddress)
 		{
-			m_pInterval3Default = aAddress.RCast<decltype(m_pInterval3Default)>();
+			m_aDeferred.Add([this, aAddress]()
+			{
+				m_pInterval3Default = aAddress.RCast<decltype(m_pInterval3Default)>();
+			});
 		});
 
 		aCallbacks.Insert(m_aGameConfig.GetSymbol("&tick_interval3"), [&](const CUtlSymbolLarge &, const DynLibUtils::CMemory &aAddress)
 		{
-			m_pInterval3 = aAddress.RCast<decltype(m_pInterval3)>();
+			m_aDeferred.Add([this, aAddress]()
+			{
+				m_pInterval3 = aAddress.RCast<decltype(m_pInterval3)>();
+			});
 		});
 
 		aCallbacks.Insert(m_aGameConfig.GetSymbol("&ticks_per_second"), [&](const CUtlSymbolLarge &, const DynLibUtils::CMemory &aAddress)
 		{
-			m_pPerSecond = aAddress.RCast<decltype(m_pPerSecond)>();
+			m_aDeferred.Add([this, aAddress]()
+			{
+				m_pPerSecond = aAddress.RCast<decltype(m_pPerSecond)>();
+			});
+		});
+
+		aCallbacks.Insert(m_aGameConfig.GetSymbol("CEngineServiceMgr::SleepAfterMainLoop"), [&](const CUtlSymbolLarge &, const DynLibUtils::CMemory &aAddress)
+		{
+			m_aDeferred.Add([this, aAddress]()
+			{
+				m_pSleepAfterMainLoop = aAddress.RCast<decltype(m_pSleepAfterMainLoop)>();
+			});
 		});
 
 		m_aGameConfig.GetAddresses().AddListener(&aCallbacks);
@@ -57,16 +80,39 @@ Tickrate::Provider::GameDataStorage::CTick::CTick()
 
 bool Tickrate::Provider::GameDataStorage::CTick::Load(IGameData *pRoot, KeyValues3 *pGameConfig, GameData::CBufferStringVector &vecMessages)
 {
+	ParsePrologues(pGameConfig, vecMessages);
+
 	return m_aGameConfig.Load(pRoot, pGameConfig, vecMessages);
 }
 
+void Tickrate::Provider::GameDataStorage::CTick::Commit()
+{
+	m_aDeferred.Run();
+}
+
 void Tickrate::Provider::GameDataStorage::CTick::Reset()
 {
+	m_aDeferred.Clear();
+
 	m_pInterval = nullptr;
 	m_pInterval2 = nullptr;
 	m_pInterval3Default = nullptr;
 	m_pInterval3 = nullptr;
 	m_pPerSecond = nullptr;
+
+	m_pSleepAfterMainLoop = nullptr;
+	m_aSleepAfterMainLoopPrologue = {};
+}
+
+void Tickrate::Provider::GameDataStorage::CTick::GetCacheEntries(CUtlVector<CacheEntry_t> &vecOutput)
+{
+	vecOutput.AddToTail({"&tick_interval", reinterpret_cast<void **>(&m_pInterval), nullptr});
+	vecOutput.AddToTail({"&(double)tick_interval", reinterpret_cast<void **>(&m_pInterval2), nullptr});
+	vecOutput.AddToTail({"&tick_interval3_default", reinterpret_cast<void **>(&m_pInterval3Default), nullptr});
+	vecOutput.AddToTail({"&tick_interval3", reinterpret_cast<void **>(&m_pInterval3), nullptr});
+	vecOutput.AddToTail({"&ticks_per_second", reinterpret_cast<void **>(&m_pPerSecond), nullptr});
+	vecOutput.AddToTail({"CEngineServiceMgr::SleepAfterMainLoop", &m_pSleepAfterMainLoop, nullptr});
+	vecOutput.AddToTail({"CEngineServiceMgr::SleepAfterMainLoop::prologue", nullptr, nullptr, &m_aSleepAfterMainLoopPrologue});
 }
 
 float *Tickrate::Provider::GameDataStorage::CTick::GetIntervalPointer() const
@@ -93,3 +139,55 @@ float *Tickrate::Provider::GameDataStorage::CTick::GetPerSecond() const
 {
 	return m_pPerSecond;
 }
+
+void *Tickrate::Provider::GameDataStorage::CTick::GetSleepAfterMainLoop() const
+{
+	return m_pSleepAfterMainLoop;
+}
+
+const Tickrate::SignatureScanner::Pattern_t &Tickrate::Provider::GameDataStorage::CTick::GetSleepAfterMainLoopPrologue() const
+{
+	return m_aSleepAfterMainLoopPrologue;
+}
+
+bool Tickrate::Provider::GameDataStorage::CTick::ParsePrologues(KeyValues3 *pGameConfig, GameData::CBufferStringVector &vecMessages)
+{
+	bool bResult = true;
+
+	for(int iGame = 0, iGameCount = pGameConfig->GetMemberCount(); iGame < iGameCount; iGame++)
+	{
+		KeyValues3 *pGame = pGameConfig->GetMember(iGame), 
+		           *pPrologues = pGame->FindMember("Prologues");
+
+		if(!pPrologues)
+		{
+			continue;
+		}
+
+		KeyValues3 *pPrologue = pPrologues->FindMember("CEngineServiceMgr::SleepAfterMainLoop"), 
+		           *pPlatform = pPrologue ? pPrologue->FindMember(TICKRATE_GAMECONFIG_PLATFORM) : nullptr;
+
+		SignatureScanner::Pattern_t aPattern;
+
+		if(pPlatform && SignatureScanner::Parse(pPlatform->GetString(), aPattern))
+		{
+			m_aDeferred.Add([this, aPattern]()
+			{
+				m_aSleepAfterMainLoopPrologue = aPattern;
+			});
+		}
+		else
+		{
+			const char *pszMessageConcat[] = {"Failed to ", "parse \"", "CEngineServiceMgr::SleepAfterMainLoop", "\" prologue"};
+
+			vecMessages.AddToTail({pszMessageConcat});
+
+			bResult = false;
+		}
+
+		// Not a section of the game config.
+		pGame->RemoveMember("Prologues");
+	}
+
+	return bResult;
+}
@@ -0,0 +1,508 @@
+/**
+ * vim: set ts=4 sw=4 tw=99 noet :
+ * ======================================================
+ * Metamod:Source Tickrate
+ * Written by Wend4r (Vladimir Ezhikov).
+ * ======================================================
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <tickrate/signature_scanner.hpp>
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#	define TICKRATE_SIGNATURE_SCANNER_X86
+#	include <immintrin.h>
+#	ifdef _MSC_VER
+#		include <intrin.h>
+#	endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#	define TICKRATE_SIGNATURE_SCANNER_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#	define TICKRATE_SIGNATURE_SCANNER_TARGET_AVX2
+#endif
+
+namespace
+{
+	// The most frequent bytes of x86-64 code, first is the most. The others are the best anchors.
+	const uint8_t s_aCommonBytes[] =
+	{
+		0x00, 0xFF, 0x48, 0x89, 0x8B, 0x0F, 0xE8, 0x24, 0x4C, 0x8D, 0x41, 0x83, 0x49, 0x44, 0x85, 0xC0, 
+		0x01, 0x74, 0x75, 0xCC, 0x45, 0x90, 0x08, 0x10, 0x20, 0x18, 0xC3, 0x55, 0x53, 0x5D, 0x5B, 0xE9, 
+		0xEB, 0x84, 0x66, 0xF3, 0x28, 0x30, 0x38, 0x40, 0x50, 0x57, 0x56, 0x5E, 0x5F, 0x31, 0xC7, 0x8E,
+	};
+
+	int GetByteCommonness(uint8_t nByte)
+	{
+		for(size_t n = 0; n < sizeof(s_aCommonBytes); n++)
+		{
+			if(s_aCommonBytes[n] == nByte)
+			{
+				return (int)(sizeof(s_aCommonBytes) - n);
+			}
+		}
+
+		return 0;
+	}
+
+	inline int CountTrailingZeros(uint32_t nMask)
+	{
+#ifdef _MSC_VER
+		unsigned long nIndex;
+
+		_BitScanForward(&nIndex, nMask);
+
+		return (int)nIndex;
+#else
+		return __builtin_ctz(nMask);
+#endif
+	}
+
+#ifdef TICKRATE_SIGNATURE_SCANNER_X86
+	bool HasAVX2()
+	{
+		static const bool s_bHas = []()
+		{
+#	ifdef _MSC_VER
+			int aInfo[4];
+
+			__cpuid(aInfo, 0);
+
+			if(aInfo[0] < 7)
+			{
+				return false;
+			}
+
+			__cpuid(aInfo, 1);
+
+			bool bOSXSave = (aInfo[2] & (1 << 27)) != 0;
+
+			if(!bOSXSave || (_xgetbv(0) & 0x6) != 0x6)
+			{
+				return false;
+			}
+
+			__cpuidex(aInfo, 7, 0);
+
+			return (aInfo[1] & (1 << 5)) != 0;
+#	else
+			__builtin_cpu_init();
+
+			return __builtin_cpu_supports("avx2") != 0;
+#	endif
+		}();
+
+		return s_bHas;
+	}
+#endif
+
+	struct ScanState_t
+	{
+		const Tickrate::SignatureScanner *m_pScanner;
+		const std::vector<int> *m_pBuckets;
+
+		const uint8_t *m_pBegin;
+		size_t m_nSize;
+
+		std::vector<const uint8_t *> *m_pOutput;
+		size_t m_nFound;
+		size_t m_nTotal;
+	};
+
+	// Returns true when every pattern is found.
+	inline bool Verify(ScanState_t &aState, size_t nPosition)
+	{
+		const auto &vecBucket = aState.m_pBuckets[aState.m_pBegin[nPosition]];
+
+		auto &vecOutput = *aState.m_pOutput;
+
+		for(int iPattern : vecBucket)
+		{
+			if(vecOutput[iPattern])
+			{
+				continue;
+			}
+
+			const auto &aPattern = aState.m_pScanner->GetPattern(iPattern);
+
+			size_t nAnchor = aPattern.m_nAnchor, 
+			       nLength = aPattern.m_vecBytes.size();
+
+			if(nPosition < nAnchor || nPosition - nAnchor + nLength > aState.m_nSize)
+			{
+				continue;
+			}
+
+			const uint8_t *pStart = aState.m_pBegin + nPosition - nAnchor;
+
+			if(Tickrate::SignatureScanner::Compare(aPattern, pStart))
+			{
+				vecOutput[iPattern] = pStart;
+				aState.m_nFound++;
+			}
+		}
+
+		return aState.m_nFound == aState.m_nTotal;
+	}
+
+	bool ScanScalar(ScanState_t &aState, const std::vector<uint8_t> &vecAnchors, size_t nFrom)
+	{
+		bool aIsAnchor[256] {};
+
+		for(uint8_t nAnchor : vecAnchors)
+		{
+			aIsAnchor[nAnchor] = true;
+		}
+
+		const uint8_t *pBegin = aState.m_pBegin;
+
+		for(size_t n = nFrom; n < aState.m_nSize; n++)
+		{
+			if(aIsAnchor[pBegin[n]] && Verify(aState, n))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+#ifdef TICKRATE_SIGNATURE_SCANNER_X86
+	bool ScanSSE2(ScanState_t &aState, const std::vector<uint8_t> &vecAnchors)
+	{
+		__m128i aSets[256];
+
+		size_t nSetCount = 0;
+
+		for(uint8_t nAnchor : vecAnchors)
+		{
+			aSets[nSetCount++] = _mm_set1_epi8((char)nAnchor);
+		}
+
+		const uint8_t *pBegin = aState.m_pBegin;
+
+		size_t n = 0;
+
+		for(; n + 16 <= aState.m_nSize; n += 16)
+		{
+			__m128i aChunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pBegin + n)), 
+			        aMatches = _mm_setzero_si128();
+
+			for(size_t i = 0; i < nSetCount; i++)
+			{
+				aMatches = _mm_or_si128(aMatches, _mm_cmpeq_epi8(aChunk, aSets[i]));
+			}
+
+			uint32_t nMask = (uint32_t)_mm_movemask_epi8(aMatches);
+
+			while(nMask)
+			{
+				if(Verify(aState, n + CountTrailingZeros(nMask)))
+				{
+					return true;
+				}
+
+				nMask &= nMask - 1;
+			}
+		}
+
+		return ScanScalar(aState, vecAnchors, n);
+	}
+
+	TICKRATE_SIGNATURE_SCANNER_TARGET_AVX2 bool ScanAVX2(ScanState_t &aState, const std::vector<uint8_t> &vecAnchors)
+	{
+		__m256i aSets[256];
+
+		size_t nSetCount = 0;
+
+		for(uint8_t nAnchor : vecAnchors)
+		{
+			aSets[nSetCount++] = _mm256_set1_epi8((char)nAnchor);
+		}
+
+		const uint8_t *pBegin = aState.m_pBegin;
+
+		size_t n = 0;
+
+		for(; n + 32 <= aState.m_nSize; n += 32)
+		{
+			__m256i aChunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pBegin + n)), 
+			        aMatches = _mm256_setzero_si256();
+
+			for(size_t i = 0; i < nSetCount; i++)
+			{
+				aMatches = _mm256_or_si256(aMatches, _mm256_cmpeq_epi8(aChunk, aSets[i]));
+			}
+
+			uint32_t nMask = (uint32_t)_mm256_movemask_epi8(aMatches);
+
+			while(nMask)
+			{
+				if(Verify(aState, n + CountTrailingZeros(nMask)))
+				{
+					return true;
+				}
+
+				nMask &= nMask - 1;
+			}
+		}
+
+		return ScanScalar(aState, vecAnchors, n);
+	}
+#endif
+};
+
+Tickrate::SignatureScanner::SignatureScanner()
+{
+}
+
+bool Tickrate::SignatureScanner::Parse(const char *pszSignature, Pattern_t &aOutput)
+{
+	aOutput.m_vecBytes.clear();
+	aOutput.m_vecMask.clear();
+	aOutput.m_nAnchor = 0;
+
+	const char *psz = pszSignature;
+
+	while(*psz)
+	{
+		if(isspace((unsigned char)*psz))
+		{
+			psz++;
+
+			continue;
+		}
+
+		if(*psz == '?')
+		{
+			psz++;
+
+			if(*psz == '?')
+			{
+				psz++;
+			}
+
+			aOutput.m_vecBytes.push_back(0x00);
+			aOutput.m_vecMask.push_back(0x00);
+
+			continue;
+		}
+
+		if(!isxdigit((unsigned char)psz[0]) || !isxdigit((unsigned char)psz[1]))
+		{
+			return false;
+		}
+
+		char sByte[3] = {psz[0], psz[1], '\0'};
+
+		aOutput.m_vecBytes.push_back((uint8_t)strtoul(sByte, nullptr, 16));
+		aOutput.m_vecMask.push_back(0xFF);
+
+		psz += 2;
+	}
+
+	if(aOutput.m_vecBytes.empty())
+	{
+		return false;
+	}
+
+	aOutput.m_nAnchor = ChooseAnchor(aOutput);
+
+	return aOutput.m_vecMask[aOutput.m_nAnchor] != 0x00; // Only wildcards.
+}
+
+int Tickrate::SignatureScanner::Add(const char *pszSignature)
+{
+	Pattern_t aPattern;
+
+	if(!Parse(pszSignature, aPattern))
+	{
+		return -1;
+	}
+
+	return Add(aPattern);
+}
+
+int Tickrate::SignatureScanner::Add(const Pattern_t &aPattern)
+{
+	if(aPattern.m_vecBytes.empty() || aPattern.m_vecBytes.size() != aPattern.m_vecMask.size() || !aPattern.m_vecMask[aPattern.m_nAnchor])
+	{
+		return -1;
+	}
+
+	m_vecPatterns.push_back(aPattern);
+	Build();
+
+	return (int)m_vecPatterns.size() - 1;
+}
+
+int Tickrate::SignatureScanner::Add(const uint8_t *pBytes, const uint8_t *pMask, size_t nLength)
+{
+	Pattern_t aPattern;
+
+	aPattern.m_vecBytes.assign(pBytes, pBytes + nLength);
+	aPattern.m_vecMask.assign(pMask, pMask + nLength);
+	aPattern.m_nAnchor = nLength ? ChooseAnchor(aPattern) : 0;
+
+	return Add(aPattern);
+}
+
+void Tickrate::SignatureScanner::Clear()
+{
+	m_vecPatterns.clear();
+	Build();
+}
+
+size_t Tickrate::SignatureScanner::GetCount() const
+{
+	return m_vecPatterns.size();
+}
+
+const Tickrate::SignatureScanner::Pattern_t &Tickrate::SignatureScanner::GetPattern(int iIndex) const
+{
+	return m_vecPatterns[iIndex];
+}
+
+size_t Tickrate::SignatureScanner::Scan(const uint8_t *pBegin, size_t nSize, std::vector<const uint8_t *> &vecOutput) const
+{
+	vecOutput.assign(m_vecPatterns.size(), nullptr);
+
+	return ScanMore(pBegin, nSize, vecOutput);
+}
+
+size_t Tickrate::SignatureScanner::ScanMore(const uint8_t *pBegin, size_t nSize, std::vector<const uint8_t *> &vecOutput) const
+{
+	vecOutput.resize(m_vecPatterns.size(), nullptr);
+
+	ScanState_t aState {this, m_aBuckets, pBegin, nSize, &vecOutput, 0, m_vecPatterns.size()};
+
+	for(const auto *pFound : vecOutput)
+	{
+		if(pFound)
+		{
+			aState.m_nFound++;
+		}
+	}
+
+	if(aState.m_nFound == aState.m_nTotal || !pBegin || !nSize)
+	{
+		return aState.m_nFound;
+	}
+
+#ifdef TICKRATE_SIGNATURE_SCANNER_X86
+	if(HasAVX2())
+	{
+		ScanAVX2(aState, m_vecAnchors);
+	}
+	else
+	{
+		ScanSSE2(aState, m_vecAnchors);
+	}
+#else
+	ScanScalar(aState, m_vecAnchors, 0);
+#endif
+
+	return aState.m_nFound;
+}
+
+const uint8_t *Tickrate::SignatureScanner::ScanSingle(const Pattern_t &aPattern, const uint8_t *pBegin, size_t nSize)
+{
+	size_t nLength = aPattern.m_vecBytes.size();
+
+	if(!nLength || nSize < nLength)
+	{
+		return nullptr;
+	}
+
+	for(size_t n = 0, nLast = nSize - nLength; n <= nLast; n++)
+	{
+		if(Compare(aPattern, pBegin + n))
+		{
+			return pBegin + n;
+		}
+	}
+
+	return nullptr;
+}
+
+bool Tickrate::SignatureScanner::Compare(const Pattern_t &aPattern, const uint8_t *pAt)
+{
+	const uint8_t *pBytes = aPattern.m_vecBytes.data(), 
+	              *pMask = aPattern.m_vecMask.data();
+
+	for(size_t n = 0, nLength = aPattern.m_vecBytes.size(); n < nLength; n++)
+	{
+		if((pAt[n] & pMask[n]) != pBytes[n])
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+size_t Tickrate::SignatureScanner::ChooseAnchor(const Pattern_t &aPattern)
+{
+	size_t nBest = 0;
+
+	int iBestCommonness = INT32_MAX;
+
+	for(size_t n = 0, nLength = aPattern.m_vecBytes.size(); n < nLength; n++)
+	{
+		if(!aPattern.m_vecMask[n])
+		{
+			continue;
+		}
+
+		int iCommonness = GetByteCommonness(aPattern.m_vecBytes[n]);
+
+		if(iCommonness < iBestCommonness)
+		{
+			nBest = n;
+			iBestCommonness = iCommonness;
+		}
+	}
+
+	return nBest;
+}
+
+void Tickrate::SignatureScanner::Build()
+{
+	m_vecAnchors.clear();
+
+	for(auto &vecBucket : m_aBuckets)
+	{
+		vecBucket.clear();
+	}
+
+	for(size_t n = 0; n < m_vecPatterns.size(); n++)
+	{
+		uint8_t nAnchor = m_vecPatterns[n].m_vecBytes[m_vecPatterns[n].m_nAnchor];
+
+		auto &vecBucket = m_aBuckets[nAnchor];
+
+		if(vecBucket.empty())
+		{
+			m_vecAnchors.push_back(nAnchor);
+		}
+
+		vecBucket.push_back((int)n);
+	}
+}
@@ -0,0 +1,500 @@
+/**
+ * vim: set ts=4 sw=4 tw=99 noet :
+ * ======================================================
+ * Metamod:Source Tickrate
+ * Written by Wend4r (Vladimir Ezhikov).
+ * ======================================================
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <tickrate/string_xref.hpp>
+
+#include <string.h>
+
+#include <algorithm>
+#include <functional>
+
+#define TICKRATE_STRING_XREF_INVALID_INDEX UINT32_MAX
+#define TICKRATE_STRING_XREF_MAX_FUNCTION_SIZE 0x10000 // To walk back without an unwind table.
+#define TICKRATE_STRING_XREF_MAX_STRING_LENGTH 4096
+
+namespace
+{
+	// Size of a "DW_EH_PE_*" encoded value, 0 when unsupported.
+	size_t GetEHEncodedSize(uint8_t nEncoding)
+	{
+		switch(nEncoding & 0x0F)
+		{
+			case 0x00: return sizeof(uintptr_t); // absptr
+			case 0x02: case 0x0A: return 2; // udata2, sdata2
+			case 0x03: case 0x0B: return 4; // udata4, sdata4
+			case 0x04: case 0x0C: return 8; // udata8, sdata8
+		}
+
+		return 0;
+	}
+
+	uint64_t ReadEHUnsigned(const uint8_t *pData, size_t nSize)
+	{
+		uint64_t nValue = 0;
+
+		memcpy(&nValue, pData, nSize);
+
+		return nValue;
+	}
+};
+
+Tickrate::StringXref::StringXref()
+ :  m_bBuilt(false),
+    m_nDataBegin(0),
+    m_nDataEnd(0)
+{
+}
+
+bool Tickrate::StringXref::Build(const ModuleIdentity &aModule)
+{
+	Clear();
+
+	m_nDataBegin = UINTPTR_MAX;
+
+	for(int n = 0; n < aModule.m_nSegmentCount; n++)
+	{
+		const auto &aSegment = aModule.m_aSegments[n];
+
+		if(aSegment.m_bExecutable)
+		{
+			m_vecCode.push_back(aSegment);
+		}
+		else if(!aSegment.m_bWritable)
+		{
+			m_vecData.push_back(aSegment);
+			m_nDataBegin = std::min(m_nDataBegin, aSegment.m_nBase);
+			m_nDataEnd = std::max(m_nDataEnd, aSegment.m_nBase + aSegment.m_nSize);
+		}
+	}
+
+	// Without "-z separate-code", ".rodata" shares the executable segment.
+	if(m_vecData.empty())
+	{
+		for(const auto &aSegment : m_vecCode)
+		{
+			m_vecData.push_back(aSegment);
+			m_nDataBegin = std::min(m_nDataBegin, aSegment.m_nBase);
+			m_nDataEnd = std::max(m_nDataEnd, aSegment.m_nBase + aSegment.m_nSize);
+		}
+	}
+
+	if(m_vecCode.empty() || m_vecData.empty())
+	{
+		Clear();
+
+		return false;
+	}
+
+	// One pass: "lea r64, [rip + disp32]" is "REX.W 8D /r" with mod 00 and r/m 101.
+	for(const auto &aSegment : m_vecCode)
+	{
+		const uint8_t *pBegin = reinterpret_cast<const uint8_t *>(aSegment.m_nBase), 
+		              *pEnd = pBegin + aSegment.m_nSize;
+
+		const uint8_t *pAt = pBegin + 1;
+
+		while(pAt + 5 < pEnd && (pAt = reinterpret_cast<const uint8_t *>(memchr(pAt, 0x8D, pEnd - 5 - pAt))))
+		{
+			if((pAt[-1] & 0xF8) == 0x48 && (pAt[1] & 0xC7) == 0x05)
+			{
+				int32_t nDisplacement;
+
+				memcpy(&nDisplacement, pAt + 2, sizeof(nDisplacement));
+
+				uintptr_t nTarget = reinterpret_cast<uintptr_t>(pAt + 6) + (intptr_t)nDisplacement;
+
+				if(IsData(nTarget))
+				{
+					uint32_t nIndex = (uint32_t)m_vecReferences.size();
+
+					auto aInserted = m_mapFirstReferences.emplace(nTarget, nIndex);
+
+					m_vecReferences.push_back({reinterpret_cast<uintptr_t>(pAt - 1), aInserted.second ? TICKRATE_STRING_XREF_INVALID_INDEX : aInserted.first->second});
+
+					if(!aInserted.second)
+					{
+						aInserted.first->second = nIndex;
+					}
+				}
+			}
+
+			pAt++;
+		}
+	}
+
+	IndexStrings();
+
+#ifdef _WIN32
+	ParseExceptionDirectory(aModule);
+#else
+	ParseEHFrameHeader(aModule);
+#endif
+
+	m_bBuilt = true;
+
+	return true;
+}
+
+void Tickrate::StringXref::Clear()
+{
+	m_bBuilt = false;
+
+	m_vecCode.clear();
+	m_vecData.clear();
+	m_nDataBegin = 0;
+	m_nDataEnd = 0;
+
+	m_mapFirstReferences.clear();
+	m_vecReferences.clear();
+	m_mapStrings.clear();
+	m_vecFunctions.clear();
+}
+
+bool Tickrate::StringXref::IsBuilt() const
+{
+	return m_bBuilt;
+}
+
+size_t Tickrate::StringXref::GetReferenceCount() const
+{
+	return m_vecReferences.size();
+}
+
+size_t Tickrate::StringXref::GetFunctionCount() const
+{
+	return m_vecFunctions.size();
+}
+
+const uint8_t *Tickrate::StringXref::FindString(const char *pszString) const
+{
+	auto itReferenced = m_mapStrings.find(std::string_view(pszString));
+
+	if(itReferenced != m_mapStrings.end())
+	{
+		return reinterpret_cast<const uint8_t *>(itReferenced->second);
+	}
+
+	// With the terminators, to match a whole string, not a tail of other.
+	size_t nLength = strlen(pszString) + 1;
+
+	std::vector<uint8_t> vecNeedle(nLength + 1);
+
+	vecNeedle[0] = '\0';
+	memcpy(&vecNeedle[1], pszString, nLength);
+
+	std::boyer_moore_horspool_searcher aSearcher(vecNeedle.begin(), vecNeedle.end());
+
+	for(const auto &aSegment : m_vecData)
+	{
+		const uint8_t *pBegin = reinterpret_cast<const uint8_t *>(aSegment.m_nBase), 
+		              *pEnd = pBegin + aSegment.m_nSize;
+
+		const uint8_t *pFound = std::search(pBegin, pEnd, aSearcher);
+
+		if(pFound != pEnd)
+		{
+			return pFound + 1;
+		}
+	}
+
+	return nullptr;
+}
+
+size_t Tickrate::StringXref::FindReferences(const uint8_t *pTarget, std::vector<const uint8_t *> &vecOutput) const
+{
+	vecOutput.clear();
+
+	auto it = m_mapFirstReferences.find(reinterpret_cast<uintptr_t>(pTarget));
+
+	if(it == m_mapFirstReferences.end())
+	{
+		return 0;
+	}
+
+	for(uint32_t nIndex = it->second; nIndex != TICKRATE_STRING_XREF_INVALID_INDEX; nIndex = m_vecReferences[nIndex].m_nNext)
+	{
+		vecOutput.push_back(reinterpret_cast<const uint8_t *>(m_vecReferences[nIndex].m_nAt));
+	}
+
+	return vecOutput.size();
+}
+
+const uint8_t *Tickrate::StringXref::FindFunctionStart(const uint8_t *pInside) const
+{
+	uintptr_t nAddress = reinterpret_cast<uintptr_t>(pInside);
+
+	if(!m_vecFunctions.empty())
+	{
+		auto it = std::upper_bound(m_vecFunctions.cbegin(), m_vecFunctions.cend(), nAddress, [](uintptr_t nValue, const Function_t &aFunction)
+		{
+			return nValue < aFunction.m_nBegin;
+		});
+
+		if(it == m_vecFunctions.cbegin())
+		{
+			return nullptr;
+		}
+
+		const auto &aFunction = *(--it);
+
+		if(aFunction.m_nEnd && nAddress >= aFunction.m_nEnd)
+		{
+			return nullptr;
+		}
+
+		return reinterpret_cast<const uint8_t *>(aFunction.m_nEntry);
+	}
+
+	// Without an unwind table: the aligned start after the padding of a previous function.
+	for(const auto &aSegment : m_vecCode)
+	{
+		if(nAddress < aSegment.m_nBase || aSegment.m_nBase + aSegment.m_nSize <= nAddress)
+		{
+			continue;
+		}
+
+		uintptr_t nLimit = nAddress - std::min<uintptr_t>(nAddress - aSegment.m_nBase, TICKRATE_STRING_XREF_MAX_FUNCTION_SIZE);
+
+		for(uintptr_t nStart = nAddress & ~(uintptr_t)15; nStart > nLimit; nStart -= 16)
+		{
+			uint8_t nPrevious = *reinterpret_cast<const uint8_t *>(nStart - 1);
+
+			if(nPrevious == 0xCC || nPrevious == 0x90 || nPrevious == 0xC3)
+			{
+				return reinterpret_cast<const uint8_t *>(nStart);
+			}
+		}
+	}
+
+	return nullptr;
+}
+
+const uint8_t *Tickrate::StringXref::FindFunction(const char *const *ppStrings, size_t nCount, size_t *pnMatched) const
+{
+	std::unordered_map<const uint8_t *, size_t> mapVotes;
+
+	std::vector<const uint8_t *> vecReferences, vecFunctions;
+
+	for(size_t n = 0; n < nCount; n++)
+	{
+		const uint8_t *pString = FindString(ppStrings[n]);
+
+		if(!pString || !FindReferences(pString, vecReferences))
+		{
+			continue;
+		}
+
+		// A vote per string, even if a function references it several times.
+		vecFunctions.clear();
+
+		for(const uint8_t *pReference : vecReferences)
+		{
+			const uint8_t *pFunction = FindFunctionStart(pReference);
+
+			if(pFunction && std::find(vecFunctions.cbegin(), vecFunctions.cend(), pFunction) == vecFunctions.cend())
+			{
+				vecFunctions.push_back(pFunction);
+				mapVotes[pFunction]++;
+			}
+		}
+	}
+
+	const uint8_t *pBest = nullptr;
+
+	size_t nBestVotes = 0;
+
+	bool bAmbiguous = false;
+
+	for(const auto &it : mapVotes)
+	{
+		if(it.second > nBestVotes)
+		{
+			pBest = it.first;
+			nBestVotes = it.second;
+			bAmbiguous = false;
+		}
+		else if(it.second == nBestVotes)
+		{
+			bAmbiguous = true;
+		}
+	}
+
+	if(pnMatched)
+	{
+		*pnMatched = nBestVotes;
+	}
+
+	return bAmbiguous ? nullptr : pBest;
+}
+
+bool Tickrate::StringXref::IsData(uintptr_t nAddress) const
+{
+	if(nAddress < m_nDataBegin || m_nDataEnd <= nAddress)
+	{
+		return false;
+	}
+
+	for(const auto &aSegment : m_vecData)
+	{
+		if(aSegment.m_nBase <= nAddress && nAddress < aSegment.m_nBase + aSegment.m_nSize)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void Tickrate::StringXref::IndexStrings()
+{
+	m_mapStrings.reserve(m_mapFirstReferences.size());
+
+	for(const auto &it : m_mapFirstReferences)
+	{
+		uintptr_t nTarget = it.first;
+
+		for(const auto &aSegment : m_vecData)
+		{
+			uintptr_t nSegmentEnd = aSegment.m_nBase + aSegment.m_nSize;
+
+			if(nTarget < aSegment.m_nBase || nSegmentEnd <= nTarget)
+			{
+				continue;
+			}
+
+			// Not every target is a string: a terminator is required.
+			const char *pszTarget = reinterpret_cast<const char *>(nTarget);
+
+			const void *pTerminator = memchr(pszTarget, '\0', std::min<size_t>(nSegmentEnd - nTarget, TICKRATE_STRING_XREF_MAX_STRING_LENGTH));
+
+			if(pTerminator && pTerminator != pszTarget)
+			{
+				m_mapStrings.emplace(std::string_view(pszTarget, reinterpret_cast<const char *>(pTerminator) - pszTarget), nTarget);
+			}
+
+			break;
+		}
+	}
+}
+
+bool Tickrate::StringXref::ParseEHFrameHeader(const ModuleIdentity &aModule)
+{
+	const uint8_t *pHeader = reinterpret_cast<const uint8_t *>(aModule.m_nUnwindTable);
+
+	if(!pHeader || aModule.m_nUnwindTableSize < 4 || pHeader[0] != 1)
+	{
+		return false;
+	}
+
+	uint8_t nFrameEncoding = pHeader[1], 
+	        nCountEncoding = pHeader[2], 
+	        nTableEncoding = pHeader[3];
+
+	size_t nFrameSize = GetEHEncodedSize(nFrameEncoding), 
+	       nCountSize = GetEHEncodedSize(nCountEncoding);
+
+	// The binary search table is "datarel | sdata4" in practice.
+	if(!nFrameSize || !nCountSize || (nCountEncoding & 0x70) || nTableEncoding != 0x3B)
+	{
+		return false;
+	}
+
+	const uint8_t *pAt = pHeader + 4 + nFrameSize;
+
+	if(pAt + nCountSize > pHeader + aModule.m_nUnwindTableSize)
+	{
+		return false;
+	}
+
+	uint64_t nCount = ReadEHUnsigned(pAt, nCountSize);
+
+	pAt += nCountSize;
+
+	if(nCount > (aModule.m_nUnwindTableSize - (pAt - pHeader)) / 8)
+	{
+		return false;
+	}
+
+	m_vecFunctions.reserve((size_t)nCount);
+
+	for(uint64_t n = 0; n < nCount; n++, pAt += 8)
+	{
+		int32_t nLocation;
+
+		memcpy(&nLocation, pAt, sizeof(nLocation));
+
+		uintptr_t nBegin = reinterpret_cast<uintptr_t>(pHeader) + (intptr_t)nLocation;
+
+		m_vecFunctions.push_back({nBegin, 0, nBegin});
+	}
+
+	return true;
+}
+
+bool Tickrate::StringXref::ParseExceptionDirectory(const ModuleIdentity &aModule)
+{
+	struct RuntimeFunction_t
+	{
+		uint32_t m_nBeginAddress;
+		uint32_t m_nEndAddress;
+		uint32_t m_nUnwindData;
+	};
+
+	const auto *pFunctions = reinterpret_cast<const RuntimeFunction_t *>(aModule.m_nUnwindTable);
+
+	if(!pFunctions)
+	{
+		return false;
+	}
+
+	size_t nCount = aModule.m_nUnwindTableSize / sizeof(RuntimeFunction_t);
+
+	m_vecFunctions.reserve(nCount);
+
+	for(size_t n = 0; n < nCount; n++)
+	{
+		const auto *pPrimary = &pFunctions[n];
+
+		// Follow "UNW_FLAG_CHAININFO" to the function which the fragment belongs to.
+		for(int nDepth = 0; nDepth < 32 && !(pPrimary->m_nUnwindData & 1); nDepth++)
+		{
+			const uint8_t *pUnwindInfo = reinterpret_cast<const uint8_t *>(aModule.m_nBase + pPrimary->m_nUnwindData);
+
+			if(!((pUnwindInfo[0] >> 3) & 0x4))
+			{
+				break;
+			}
+
+			uint8_t nCodeCount = pUnwindInfo[2];
+
+			pPrimary = reinterpret_cast<const RuntimeFunction_t *>(pUnwindInfo + 4 + ((nCodeCount + 1) & ~1) * 2);
+		}
+
+		m_vecFunctions.push_back({aModule.m_nBase + pFunctions[n].m_nBeginAddress, aModule.m_nBase + pFunctions[n].m_nEndAddress, aModule.m_nBase + pPrimary->m_nBeginAddress});
+	}
+
+	std::sort(m_vecFunctions.begin(), m_vecFunctions.end(), [](const Function_t &aLeft, const Function_t &aRight)
+	{
+		return aLeft.m_nBegin < aRight.m_nBegin;
+	});
+
+	return true;
+}
@@ -0,0 +1,112 @@
+/**
+ * vim: set ts=4 sw=4 tw=99 noet :
+ * ======================================================
+ * Metamod:Source Tickrate
+ * Written by Wend4r (Vladimir Ezhikov).
+ * ======================================================
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <tickrate/system_profiler.hpp>
+
+#include <algorithm>
+
+Tickrate::SystemProfiler::SystemProfiler()
+ :  m_nHead(0)
+{
+}
+
+int Tickrate::SystemProfiler::Add(const char *pszName)
+{
+	m_vecSystems.push_back({pszName ? pszName : "", 0, 0, std::vector<uint32_t>(TICKRATE_SYSTEM_PROFILER_TICK_COUNT)});
+
+	return (int)m_vecSystems.size() - 1;
+}
+
+void Tickrate::SystemProfiler::Clear()
+{
+	m_vecSystems.clear();
+	m_nHead = 0;
+}
+
+int Tickrate::SystemProfiler::GetCount() const
+{
+	return (int)m_vecSystems.size();
+}
+
+const char *Tickrate::SystemProfiler::GetName(int iSystem) const
+{
+	return m_vecSystems[iSystem].m_sName.c_str();
+}
+
+void Tickrate::SystemProfiler::OnTick()
+{
+	uint32_t nSlot = m_nHead & (TICKRATE_SYSTEM_PROFILER_TICK_COUNT - 1);
+
+	for(auto &aSystem : m_vecSystems)
+	{
+		aSystem.m_vecSamples[nSlot] = (uint32_t)std::min<uint64_t>(aSystem.m_nAccumulated, UINT32_MAX);
+		aSystem.m_nAccumulated = 0;
+	}
+
+	m_nHead++;
+}
+
+void Tickrate::SystemProfiler::Reset()
+{
+	for(auto &aSystem : m_vecSystems)
+	{
+		aSystem.m_nBegin = 0;
+		aSystem.m_nAccumulated = 0;
+	}
+
+	m_nHead = 0;
+}
+
+uint32_t Tickrate::SystemProfiler::GetTickCount() const
+{
+	return m_nHead;
+}
+
+bool Tickrate::SystemProfiler::Compute(int iSystem, Stats_t &aOutput) const
+{
+	aOutput = {};
+
+	uint32_t nCount = std::min<uint32_t>(m_nHead, TICKRATE_SYSTEM_PROFILER_TICK_COUNT);
+
+	if(!nCount)
+	{
+		return false;
+	}
+
+	const auto &vecSamples = m_vecSystems[iSystem].m_vecSamples;
+
+	// The ring is filled from the start, so the first ones are the samples until wrapped.
+	std::vector<uint32_t> vecValues(vecSamples.begin(), vecSamples.begin() + nCount);
+
+	uint64_t nSum = 0;
+
+	for(uint32_t nValue : vecValues)
+	{
+		nSum += nValue;
+	}
+
+	aOutput.m_nSamples = (int)nCount;
+	aOutput.m_dblMean = (double)nSum / nCount / 1000.0;
+
+	FrameProfiler::ComputePercentiles(vecValues.data(), (int)nCount, aOutput.m_aPercentiles);
+
+	return true;
+}
@@ -0,0 +1,555 @@
+/**
+ * vim: set ts=4 sw=4 tw=99 noet :
+ * ======================================================
+ * Metamod:Source Tickrate
+ * Written by Wend4r (Vladimir Ezhikov).
+ * ======================================================
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <tickrate/thread_control.hpp>
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+
+#ifdef _WIN32
+#	include <windows.h>
+#else
+#	include <sys/resource.h>
+#	include <sys/syscall.h>
+#	include <unistd.h>
+#endif
+
+Tickrate::ThreadControl::ThreadControl()
+ :  m_bCaptured(false),
+    m_bApplied(false)
+{
+#ifdef _WIN32
+	m_hThread = NULL;
+	m_nOriginalMask = 0;
+	m_iOriginalPriority = THREAD_PRIORITY_NORMAL;
+#else
+	m_nThread = 0;
+	CPU_ZERO(&m_aOriginalCpus);
+	m_iOriginalPolicy = SCHED_OTHER;
+	m_aOriginalParam = {};
+	m_iOriginalNice = 0;
+#endif
+}
+
+Tickrate::ThreadControl::~ThreadControl()
+{
+#ifdef _WIN32
+	if(m_hThread)
+	{
+		CloseHandle(m_hThread);
+	}
+#endif
+}
+
+bool Tickrate::ThreadControl::Capture(char *error, size_t maxlen)
+{
+#ifdef _WIN32
+	HANDLE hThread = NULL;
+
+	if(!DuplicateHandle(GetCurrentProcess(), GetCurrentThread(), GetCurrentProcess(), &hThread, THREAD_SET_INFORMATION | THREAD_QUERY_INFORMATION, FALSE, 0))
+	{
+		if(error && maxlen)
+		{
+			snprintf(error, maxlen, "Failed to open the thread (%lu)", GetLastError());
+		}
+
+		return false;
+	}
+
+	if(m_hThread)
+	{
+		CloseHandle(m_hThread);
+	}
+
+	m_hThread = hThread;
+
+	// No getter of the mask, set the process one to get the previous.
+	DWORD_PTR nProcessMask, nSystemMask;
+
+	GetProcessAffinityMask(GetCurrentProcess(), &nProcessMask, &nSystemMask);
+	m_nOriginalMask = (uintptr_t)SetThreadAffinityMask(hThread, nProcessMask);
+
+	if(m_nOriginalMask)
+	{
+		SetThreadAffinityMask(hThread, (DWORD_PTR)m_nOriginalMask);
+	}
+	else
+	{
+		m_nOriginalMask = (uintptr_t)nProcessMask;
+	}
+
+	m_iOriginalPriority = GetThreadPriority(hThread);
+#else
+	pid_t nThread = (pid_t)syscall(SYS_gettid);
+
+	if(sched_getaffinity(nThread, sizeof(m_aOriginalCpus), &m_aOriginalCpus))
+	{
+		if(error && maxlen)
+		{
+			snprintf(error, maxlen, "Failed to get the CPU affinity: %s", strerror(errno));
+		}
+
+		return false;
+	}
+
+	m_iOriginalPolicy = sched_getscheduler(nThread);
+	sched_getparam(nThread, &m_aOriginalParam);
+
+	errno = 0;
+
+	int iNice = getpriority(PRIO_PROCESS, (id_t)nThread); // Per thread on Linux.
+
+	m_iOriginalNice = errno ? 0 : iNice;
+	m_nThread = nThread;
+#endif
+
+	m_bCaptured = true;
+	m_bApplied = false;
+
+	return true;
+}
+
+bool Tickrate::ThreadControl::IsCaptured() const
+{
+	return m_bCaptured;
+}
+
+bool Tickrate::ThreadControl::Apply(const Settings_t &aSettings, char *error, size_t maxlen)
+{
+	if(!m_bCaptured)
+	{
+		if(error && maxlen)
+		{
+			strncpy(error, "No captured thread", maxlen);
+		}
+
+		return false;
+	}
+
+	bool bResult = true;
+
+	m_bApplied = true;
+
+#ifdef _WIN32
+	if(aSettings.m_vecCpus.size())
+	{
+		DWORD_PTR nMask = 0;
+
+		for(int iCpu : aSettings.m_vecCpus)
+		{
+			if(iCpu < (int)(sizeof(nMask) * 8))
+			{
+				nMask |= (DWORD_PTR)1 << iCpu;
+			}
+		}
+
+		if(!SetThreadAffinityMask(m_hThread, nMask))
+		{
+			if(error && maxlen)
+			{
+				snprintf(error, maxlen, "Failed to set the CPU affinity (%lu)", GetLastError());
+			}
+
+			bResult = false;
+		}
+	}
+
+	// No policies, the real-time ones are the highest priority.
+	if(aSettings.m_ePolicy != POLICY_KEEP)
+	{
+		int iPriority = aSettings.m_ePolicy == POLICY_OTHER ? THREAD_PRIORITY_NORMAL : THREAD_PRIORITY_TIME_CRITICAL;
+
+		if(!SetThreadPriority(m_hThread, iPriority))
+		{
+			if(error && maxlen)
+			{
+				snprintf(error, maxlen, "Failed to set the thread priority (%lu)", GetLastError());
+			}
+
+			bResult = false;
+		}
+	}
+#else
+	if(aSettings.m_vecCpus.size())
+	{
+		cpu_set_t aCpus;
+
+		CPU_ZERO(&aCpus);
+
+		for(int iCpu : aSettings.m_vecCpus)
+		{
+			if(iCpu < CPU_SETSIZE)
+			{
+				CPU_SET(iCpu, &aCpus);
+			}
+		}
+
+		if(sched_setaffinity(m_nThread, sizeof(aCpus), &aCpus))
+		{
+			if(error && maxlen)
+			{
+				snprintf(error, maxlen, "Failed to set the CPU affinity: %s", strerror(errno));
+			}
+
+			bResult = false;
+		}
+	}
+
+	if(aSettings.m_ePolicy != POLICY_KEEP)
+	{
+		struct sched_param aParam = {};
+
+		int iPolicy = SCHED_OTHER;
+
+		if(aSettings.m_ePolicy != POLICY_OTHER)
+		{
+			iPolicy = aSettings.m_ePolicy == POLICY_FIFO ? SCHED_FIFO : SCHED_RR;
+			aParam.sched_priority = std::clamp(aSettings.m_iPriority, sched_get_priority_min(iPolicy), sched_get_priority_max(iPolicy));
+		}
+
+		// The real-time ones require "CAP_SYS_NICE" or "RLIMIT_RTPRIO".
+		if(sched_setscheduler(m_nThread, iPolicy, &aParam))
+		{
+			if(error && maxlen)
+			{
+				snprintf(error, maxlen, "Failed to set the %s policy: %s", GetPolicyName(aSettings.m_ePolicy), strerror(errno));
+			}
+
+			bResult = false;
+		}
+	}
+
+	if(aSettings.m_iNice)
+	{
+		if(setpriority(PRIO_PROCESS, (id_t)m_nThread, aSettings.m_iNice))
+		{
+			if(error && maxlen)
+			{
+				snprintf(error, maxlen, "Failed to set the nice %d: %s", aSettings.m_iNice, strerror(errno));
+			}
+
+			bResult = false;
+		}
+	}
+#endif
+
+	return bResult;
+}
+
+bool Tickrate::ThreadControl::IsApplied() const
+{
+	return m_bApplied;
+}
+
+bool Tickrate::ThreadControl::Restore(char *error, size_t maxlen)
+{
+	if(!m_bApplied)
+	{
+		return true;
+	}
+
+	bool bResult = true;
+
+	size_t nLength = 0;
+
+	// Attempts each step, a failed one does not hold the others back.
+	auto AddError = [&](const char *pszStep, const char *pszReason)
+	{
+		bResult = false;
+
+		if(error && maxlen && nLength < maxlen)
+		{
+			int iWritten = snprintf(error + nLength, maxlen - nLength, "%s%s: %s", nLength ? "; " : "Failed to restore the thread ", pszStep, pszReason);
+
+			if(iWritten > 0)
+			{
+				nLength = std::min(nLength + (size_t)iWritten, maxlen);
+			}
+		}
+	};
+
+#ifdef _WIN32
+	char sReason[32];
+
+	if(!SetThreadAffinityMask(m_hThread, (DWORD_PTR)m_nOriginalMask))
+	{
+		snprintf(sReason, sizeof(sReason), "%lu", GetLastError());
+		AddError("CPU affinity", sReason);
+	}
+
+	if(!SetThreadPriority(m_hThread, m_iOriginalPriority))
+	{
+		snprintf(sReason, sizeof(sReason), "%lu", GetLastError());
+		AddError("priority", sReason);
+	}
+#else
+	// The policy first, a lower nice can require the original one.
+	if(sched_setscheduler(m_nThread, m_iOriginalPolicy, &m_aOriginalParam))
+	{
+		AddError("policy", strerror(errno));
+	}
+
+	if(sched_setaffinity(m_nThread, sizeof(m_aOriginalCpus), &m_aOriginalCpus))
+	{
+		AddError("CPU affinity", strerror(errno));
+	}
+
+	if(setpriority(PRIO_PROCESS, (id_t)m_nThread, m_iOriginalNice))
+	{
+		AddError("nice", strerror(errno));
+	}
+#endif
+
+	m_bApplied = false;
+
+	return bResult;
+}
+
+bool Tickrate::ThreadControl::GetCpus(std::vector<int> &vecOutput) const
+{
+	vecOutput.clear();
+
+	if(!m_bCaptured)
+	{
+		return false;
+	}
+
+#ifdef _WIN32
+	DWORD_PTR nProcessMask, nSystemMask;
+
+	GetProcessAffinityMask(GetCurrentProcess(), &nProcessMask, &nSystemMask);
+
+	DWORD_PTR nMask = SetThreadAffinityMask(m_hThread, nProcessMask);
+
+	if(!nMask)
+	{
+		return false;
+	}
+
+	SetThreadAffinityMask(m_hThread, nMask);
+
+	for(int iCpu = 0; iCpu < (int)(sizeof(nMask) * 8); iCpu++)
+	{
+		if(nMask & ((DWORD_PTR)1 << iCpu))
+		{
+			vecOutput.push_back(iCpu);
+		}
+	}
+#else
+	cpu_set_t aCpus;
+
+	if(sched_getaffinity(m_nThread, sizeof(aCpus), &aCpus))
+	{
+		return false;
+	}
+
+	for(int iCpu = 0; iCpu < CPU_SETSIZE; iCpu++)
+	{
+		if(CPU_ISSET(iCpu, &aCpus))
+		{
+			vecOutput.push_back(iCpu);
+		}
+	}
+#endif
+
+	return true;
+}
+
+Tickrate::ThreadControl::Policy_t Tickrate::ThreadControl::GetPolicy() const
+{
+	if(!m_bCaptured)
+	{
+		return POLICY_KEEP;
+	}
+
+#ifdef _WIN32
+	return GetThreadPriority(m_hThread) == THREAD_PRIORITY_TIME_CRITICAL ? POLICY_FIFO : POLICY_OTHER;
+#else
+	switch(sched_getscheduler(m_nThread))
+	{
+		case SCHED_FIFO:
+			return POLICY_FIFO;
+
+		case SCHED_RR:
+			return POLICY_RR;
+
+		default:
+			return POLICY_OTHER;
+	}
+#endif
+}
+
+int Tickrate::ThreadControl::GetPriority() const
+{
+	if(!m_bCaptured)
+	{
+		return 0;
+	}
+
+#ifdef _WIN32
+	return GetThreadPriority(m_hThread);
+#else
+	struct sched_param aParam = {};
+
+	sched_getparam(m_nThread, &aParam);
+
+	return aParam.sched_priority;
+#endif
+}
+
+int Tickrate::ThreadControl::GetNice() const
+{
+#ifdef _WIN32
+	return 0;
+#else
+	if(!m_bCaptured)
+	{
+		return 0;
+	}
+
+	errno = 0;
+
+	int iNice = getpriority(PRIO_PROCESS, (id_t)m_nThread);
+
+	return errno ? 0 : iNice;
+#endif
+}
+
+bool Tickrate::ThreadControl::ParseCpus(const char *pszList, std::vector<int> &vecOutput)
+{
+	vecOutput.clear();
+
+	const char *psz = pszList;
+
+	while(*psz)
+	{
+		char *pszEnd;
+
+		long nFirst = strtol(psz, &pszEnd, 10);
+
+		if(pszEnd == psz || nFirst < 0)
+		{
+			return false;
+		}
+
+		long nLast = nFirst;
+
+		psz = pszEnd;
+
+		if(*psz == '-')
+		{
+			psz++;
+			nLast = strtol(psz, &pszEnd, 10);
+
+			if(pszEnd == psz || nLast < nFirst)
+			{
+				return false;
+			}
+
+			psz = pszEnd;
+		}
+
+		if(nLast >= 1024) // "CPU_SETSIZE".
+		{
+			return false;
+		}
+
+		for(long n = nFirst; n <= nLast; n++)
+		{
+			vecOutput.push_back((int)n);
+		}
+
+		while(*psz == ' ')
+		{
+			psz++;
+		}
+
+		if(*psz == ',')
+		{
+			psz++;
+		}
+		else if(*psz)
+		{
+			return false;
+		}
+	}
+
+	std::sort(vecOutput.begin(), vecOutput.end());
+	vecOutput.erase(std::unique(vecOutput.begin(), vecOutput.end()), vecOutput.end());
+
+	return true;
+}
+
+void Tickrate::ThreadControl::FormatCpus(const std::vector<int> &vecCpus, char *pszOutput, size_t nMaxLength)
+{
+	if(!nMaxLength)
+	{
+		return;
+	}
+
+	size_t nLength = 0;
+
+	pszOutput[0] = '\0';
+
+	// Ranges of the sorted ones.
+	for(size_t n = 0; n < vecCpus.size() && nLength < nMaxLength; )
+	{
+		size_t nLast = n;
+
+		while(nLast + 1 < vecCpus.size() && vecCpus[nLast + 1] == vecCpus[nLast] + 1)
+		{
+			nLast++;
+		}
+
+		int iWritten = nLast == n ? snprintf(pszOutput + nLength, nMaxLength - nLength, "%s%d", nLength ? "," : "", vecCpus[n]) 
+		                          : snprintf(pszOutput + nLength, nMaxLength - nLength, "%s%d-%d", nLength ? "," : "", vecCpus[n], vecCpus[nLast]);
+
+		if(iWritten < 0)
+		{
+			break;
+		}
+
+		nLength += (size_t)iWritten;
+		n = nLast + 1;
+	}
+}
+
+const char *Tickrate::ThreadControl::GetPolicyName(Policy_t ePolicy)
+{
+	switch(ePolicy)
+	{
+		case POLICY_OTHER:
+			return "SCHED_OTHER";
+
+		case POLICY_FIFO:
+			return "SCHED_FIFO";
+
+		case POLICY_RR:
+			return "SCHED_RR";
+
+		default:
+			return "keep";
+	}
+}
@@ -0,0 +1,123 @@
+/**
+ * vim: set ts=4 sw=4 tw=99 noet :
+ * ======================================================
+ * Metamod:Source Tickrate
+ * Written by Wend4r (Vladimir Ezhikov).
+ * ======================================================
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <tickrate/tiers.hpp>
+
+#include <algorithm>
+
+Tickrate::Tiers::Tiers()
+ :  m_aSettings({{}, 2, 60.0}),
+    m_dblNextThink(0.0),
+    m_dblLastSwitch(0.0),
+    m_iCurrent(-1)
+{
+}
+
+const Tickrate::Tiers::Settings_t &Tickrate::Tiers::GetSettings() const
+{
+	return m_aSettings;
+}
+
+void Tickrate::Tiers::SetSettings(const Settings_t &aSettings)
+{
+	m_aSettings = aSettings;
+
+	auto &vecTiers = m_aSettings.m_vecTiers;
+
+	std::sort(vecTiers.begin(), vecTiers.end(), [](const Tier_t &aLeft, const Tier_t &aRight)
+	{
+		return aLeft.m_nMinHumans < aRight.m_nMinHumans;
+	});
+
+	Reset();
+}
+
+void Tickrate::Tiers::Reset()
+{
+	m_dblNextThink = 0.0;
+	m_dblLastSwitch = 0.0;
+	m_iCurrent = -1;
+}
+
+int Tickrate::Tiers::Think(double dblNow, int nHumans)
+{
+	if(dblNow < m_dblNextThink)
+	{
+		return 0;
+	}
+
+	m_dblNextThink = dblNow + 1.0;
+
+	// Hysteresis: a count around a bound keeps the current tier.
+	if(m_iCurrent != -1 && Contains(m_iCurrent, nHumans, m_aSettings.m_nHysteresis))
+	{
+		return 0;
+	}
+
+	int iFound = Find(nHumans);
+
+	if(iFound == -1 || iFound == m_iCurrent)
+	{
+		return 0;
+	}
+
+	if(m_iCurrent != -1 && dblNow - m_dblLastSwitch < m_aSettings.m_dblMinDwell)
+	{
+		return 0;
+	}
+
+	m_iCurrent = iFound;
+	m_dblLastSwitch = dblNow;
+
+	return m_aSettings.m_vecTiers[iFound].m_nTickrate;
+}
+
+int Tickrate::Tiers::Find(int nHumans) const
+{
+	const auto &vecTiers = m_aSettings.m_vecTiers;
+
+	for(int i = 0, iCount = (int)vecTiers.size(); i < iCount; i++)
+	{
+		if(Contains(i, nHumans, 0))
+		{
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+bool Tickrate::Tiers::Contains(int iTier, int nHumans, int nMargin) const
+{
+	const auto &aTier = m_aSettings.m_vecTiers[iTier];
+
+	return aTier.m_nMinHumans - nMargin <= nHumans && (!aTier.m_nMaxHumans || nHumans <= aTier.m_nMaxHumans + nMargin);
+}
+
+int Tickrate::Tiers::GetCurrent() const
+{
+	return m_iCurrent;
+}
+
+int Tickrate::Tiers::GetCurrentTickrate() const
+{
+	return m_iCurrent == -1 ? 0 : m_aSettings.m_vecTiers[m_iCurrent].m_nTickrate;
+}
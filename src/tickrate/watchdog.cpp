@@ -0,0 +1,135 @@
+/**
+ * vim: set ts=4 sw=4 tw=99 noet :
+ * ======================================================
+ * Metamod:Source Tickrate
+ * Written by Wend4r (Vladimir Ezhikov).
+ * ======================================================
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <tickrate/watchdog.hpp>
+
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#	include <emmintrin.h>
+#	define TICKRATE_WATCHDOG_SSE2
+#endif
+
+// The unused lanes read it, equal to their zero expected.
+static uint32_t s_nUnusedLane = 0;
+
+Tickrate::Watchdog::Watchdog()
+ :  m_aExpected{},
+    m_nLanes(0),
+    m_bArmed(false),
+    m_nCountdown(0),
+    m_nDrifts(0)
+{
+	Clear();
+}
+
+bool Tickrate::Watchdog::Add(void *pTarget, size_t nSize)
+{
+	size_t nLanes = nSize / sizeof(uint32_t);
+
+	if(!pTarget || !nLanes || nSize % sizeof(uint32_t) || m_nLanes + nLanes > TICKRATE_WATCHDOG_LANE_COUNT)
+	{
+		return false;
+	}
+
+	auto *pLanes = reinterpret_cast<uint32_t *>(pTarget);
+
+	for(size_t n = 0; n < nLanes; n++)
+	{
+		m_apTargets[m_nLanes++] = &pLanes[n];
+	}
+
+	return true;
+}
+
+void Tickrate::Watchdog::Clear()
+{
+	for(int n = 0; n < TICKRATE_WATCHDOG_LANE_COUNT; n++)
+	{
+		m_apTargets[n] = &s_nUnusedLane;
+		m_aExpected[n] = 0;
+	}
+
+	m_nLanes = 0;
+	m_bArmed = false;
+}
+
+int Tickrate::Watchdog::GetLaneCount() const
+{
+	return m_nLanes;
+}
+
+void Tickrate::Watchdog::Arm()
+{
+	for(int n = 0; n < m_nLanes; n++)
+	{
+		memcpy(&m_aExpected[n], m_apTargets[n], sizeof(uint32_t));
+	}
+
+	m_bArmed = m_nLanes > 0;
+	m_nCountdown = 0;
+}
+
+void Tickrate::Watchdog::Disarm()
+{
+	m_bArmed = false;
+}
+
+bool Tickrate::Watchdog::IsArmed() const
+{
+	return m_bArmed;
+}
+
+void Tickrate::Watchdog::Restore()
+{
+	for(int n = 0; n < m_nLanes; n++)
+	{
+		memcpy(m_apTargets[n], &m_aExpected[n], sizeof(uint32_t));
+	}
+
+	m_nDrifts++;
+}
+
+uint32_t Tickrate::Watchdog::GetDriftCount() const
+{
+	return m_nDrifts;
+}
+
+bool Tickrate::Watchdog::IsDrifted() const
+{
+	alignas(16) uint32_t aLive[TICKRATE_WATCHDOG_LANE_COUNT];
+
+	// A fixed count, the loop is unrolled into plain loads.
+	for(int n = 0; n < TICKRATE_WATCHDOG_LANE_COUNT; n++)
+	{
+		memcpy(&aLive[n], m_apTargets[n], sizeof(uint32_t));
+	}
+
+#ifdef TICKRATE_WATCHDOG_SSE2
+	// Bitwise, the values are exactly of the last writes.
+	__m128i aLow = _mm_cmpeq_epi32(_mm_load_si128(reinterpret_cast<const __m128i *>(&aLive[0])), _mm_load_si128(reinterpret_cast<const __m128i *>(&m_aExpected[0]))), 
+	        aHigh = _mm_cmpeq_epi32(_mm_load_si128(reinterpret_cast<const __m128i *>(&aLive[4])), _mm_load_si128(reinterpret_cast<const __m128i *>(&m_aExpected[4])));
+
+	return _mm_movemask_epi8(_mm_and_si128(aLow, aHigh)) != 0xFFFF;
+#else
+	return memcmp(aLive, m_aExpected, sizeof(aLive)) != 0;
+#endif
+}
@@ -24,6 +24,7 @@
 
 #include <stdint.h>
 
+#include <algorithm>
 #include <string>
 #include <exception>
 
@@ -50,6 +51,10 @@ SH_DECL_HOOK1_void(CNetworkGameServerBase, FillServerInfo, SH_NOATTRIB, 0, CSVCM
 SH_DECL_HOOK8(CNetworkGameServerBase, ConnectClient, SH_NOATTRIB, 0, CServerSideClientBase *, const char *, ns_address *, int, CCLCMsg_SplitPlayerConnect_t *, const char *, const byte *, int, bool);
 SH_DECL_HOOK1(CServerSideClientBase, ProcessRespondCvarValue, SH_NOATTRIB, 0, bool, const CCLCMsg_RespondCvarValue_t &);
 SH_DECL_HOOK1_void(CServerSideClientBase, PerformDisconnection, SH_NOATTRIB, 0, ENetworkDisconnectionReason);
+SH_DECL_HOOK1_void(IGameSystem, ServerPreEntityThink, SH_NOATTRIB, 0, const EventServerPreEntityThink_t &);
+SH_DECL_HOOK1_void(IGameSystem, ServerPostEntityThink, SH_NOATTRIB, 0, const EventServerPostEntityThink_t &);
+SH_DECL_HOOK1_void(IGameSystem, ServerGamePostSimulate, SH_NOATTRIB, 0, const EventServerGamePostSimulate_t &);
+SH_DECL_HOOK1_void(IGameSystem, ServerPreClientUpdate, SH_NOATTRIB, 0, const EventServerPreClientUpdate_t &);
 
 static TickratePlugin s_aTickratePlugin;
 TickratePlugin *g_pTickratePlugin = &s_aTickratePlugin;
@@ -85,13 +90,110 @@ TickratePlugin::TickratePlugin()
     {
     	if(*pNewValue != *pOldValue)
     	{
-    		s_aTickratePlugin.ChangeInternal(*pNewValue);
+    		s_aTickratePlugin.QueueChange(*pNewValue);
     	}
     }),
-    m_aSVToClientClockCorrection("sv_to_cl_clock_correction", FCVAR_RELEASE | FCVAR_GAMEDLL, "Send it value of \"" TICKRATE_CLIENT_CVAR_NAME_CLOCK_CORRECTION "\" to client", false, true, false, true, true),
+    m_aSVToClientClockCorrection("sv_to_cl_clock_correction", FCVAR_RELEASE | FCVAR_GAMEDLL, "Send it value of \"" TICKRATE_CLIENT_CVAR_NAME_CLOCK_CORRECTION "\" to client", false, true, false, true, true, [](ConVar<bool> *pConVar, const CSplitScreenSlot aSlot, const bool *pNewValue, const bool *pOldValue)
+    {
+    	s_aTickratePlugin.InvalidateHandshake();
+    }),
     m_aEnableFrameDetailsConVar("mm_" META_PLUGIN_PREFIX "_enable_frame_details", FCVAR_RELEASE | FCVAR_GAMEDLL, "Enable detail messages of frames", false, true, false, true, true), 
+    m_aEnableProfilerConVar("mm_" META_PLUGIN_PREFIX "_enable_profiler", FCVAR_RELEASE | FCVAR_GAMEDLL, "Record frame boundary timings for \"mm_" META_PLUGIN_PREFIX "_stats\"", true, true, false, true, true), 
+    m_aEnableSystemProfilerConVar("mm_" META_PLUGIN_PREFIX "_enable_system_profiler", FCVAR_RELEASE | FCVAR_GAMEDLL, "Time the per-tick events of each game system for \"mm_" META_PLUGIN_PREFIX "_stats\"", false, true, false, true, true, [](ConVar<bool> *pConVar, const CSplitScreenSlot aSlot, const bool *pNewValue, const bool *pOldValue)
+    {
+    	if(*pNewValue == *pOldValue)
+    	{
+    		return;
+    	}
+
+    	if(*pNewValue)
+    	{
+    		s_aTickratePlugin.RegisterSystemProfiler();
+    	}
+    	else
+    	{
+    		s_aTickratePlugin.UnregisterSystemProfiler();
+    	}
+    }),
+    m_aOverrunToleranceConVar("mm_" META_PLUGIN_PREFIX "_overrun_tolerance", FCVAR_RELEASE | FCVAR_GAMEDLL, "A part of the tick budget that frame can exceed without counting as overrun", 0.1f, true, 0.0f, true, 10.0f), 
+    m_aEnableGovernorConVar("mm_" META_PLUGIN_PREFIX "_enable_governor", FCVAR_RELEASE | FCVAR_GAMEDLL, "Step the tickrate down through a ladder while the server exceeds the tick budget, up to \"sv_tickrate\"", false, true, false, true, true), 
+    m_aEnableTiersConVar("mm_" META_PLUGIN_PREFIX "_enable_tiers", FCVAR_RELEASE | FCVAR_GAMEDLL, "Switch the tickrate by tiers of a human count, up to \"sv_tickrate\"", false, true, false, true, true), 
+    m_aEnableMapProfilesConVar("mm_" META_PLUGIN_PREFIX "_enable_map_profiles", FCVAR_RELEASE | FCVAR_GAMEDLL, "Apply a tickrate ceiling of \"configs/maps.json\" by the map, the workshop or the game mode at a server startup, instead of \"sv_tickrate\"", false, true, false, true, true), 
+    m_aHibernationTickrateConVar("mm_" META_PLUGIN_PREFIX "_hibernation_tickrate", FCVAR_RELEASE | FCVAR_GAMEDLL, "A tickrate of the server without humans, \"sv_tickrate\" is restored on a connect. 0 - disable", 0, true, 0, true, 128), 
+    m_aHibernationDelayConVar("mm_" META_PLUGIN_PREFIX "_hibernation_delay", FCVAR_RELEASE | FCVAR_GAMEDLL, "Seconds without humans to hibernate", 30.0f, true, 0.0f, false, 0.0f), 
+    m_aWatchdogIntervalConVar("mm_" META_PLUGIN_PREFIX "_watchdog_interval", FCVAR_RELEASE | FCVAR_GAMEDLL, "Frames between verifications of the tick values against the last change, re-applied when the engine has reset them. 0 - disable", 64, true, 0, true, 65536), 
+    m_aPacerConVar("mm_" META_PLUGIN_PREFIX "_pacer", FCVAR_RELEASE | FCVAR_GAMEDLL, "Pace the main loop by a precise sleep and a spin before the engine sleep", false, true, false, true, true, [](ConVar<bool> *pConVar, const CSplitScreenSlot aSlot, const bool *pNewValue, const bool *pOldValue)
+    {
+    	if(*pNewValue == *pOldValue)
+    	{
+    		return;
+    	}
+
+    	if(*pNewValue)
+    	{
+    		char error[256];
+
+    		if(!s_aTickratePlugin.RegisterPacer(error, sizeof(error)))
+    		{
+    			s_aTickratePlugin.WarningFormat("%s\n", error);
+    		}
+    	}
+    	else
+    	{
+    		s_aTickratePlugin.UnregisterPacer();
+    	}
+    }),
+    m_aPacerSpinConVar("mm_" META_PLUGIN_PREFIX "_pacer_spin", FCVAR_RELEASE | FCVAR_GAMEDLL, "Microseconds of the pacer to spin before a frame start at most, a CPU time for precision", 50, true, 0, true, 2000, [](ConVar<int> *pConVar, const CSplitScreenSlot aSlot, const int *pNewValue, const int *pOldValue)
+    {
+    	s_aTickratePlugin.m_aPacer.SetSpinBudget((uint32_t)*pNewValue);
+    }),
+    m_aMainThreadCpusConVar("mm_" META_PLUGIN_PREFIX "_main_thread_cpus", FCVAR_RELEASE | FCVAR_GAMEDLL, "CPUs to pin the main thread to, e.g. \"2-3,8\". Empty - keep", CUtlString(""), [](ConVar<CUtlString> *pConVar, const CSplitScreenSlot aSlot, const CUtlString *pNewValue, const CUtlString *pOldValue)
+    {
+    	s_aTickratePlugin.ApplyMainThread();
+    }),
+    m_aMainThreadPolicyConVar("mm_" META_PLUGIN_PREFIX "_main_thread_policy", FCVAR_RELEASE | FCVAR_GAMEDLL, "A scheduling policy of the main thread. 0 - keep, 1 - SCHED_OTHER, 2 - SCHED_FIFO, 3 - SCHED_RR", 0, true, 0, true, 3, [](ConVar<int> *pConVar, const CSplitScreenSlot aSlot, const int *pNewValue, const int *pOldValue)
+    {
+    	s_aTickratePlugin.ApplyMainThread();
+    }),
+    m_aMainThreadPriorityConVar("mm_" META_PLUGIN_PREFIX "_main_thread_priority", FCVAR_RELEASE | FCVAR_GAMEDLL, "A real-time priority of the main thread with SCHED_FIFO or SCHED_RR", 1, true, 1, true, 99, [](ConVar<int> *pConVar, const CSplitScreenSlot aSlot, const int *pNewValue, const int *pOldValue)
+    {
+    	s_aTickratePlugin.ApplyMainThread();
+    }),
+    m_aMainThreadNiceConVar("mm_" META_PLUGIN_PREFIX "_main_thread_nice", FCVAR_RELEASE | FCVAR_GAMEDLL, "A nice value of the main thread. 0 - keep", 0, true, -20, true, 19, [](ConVar<int> *pConVar, const CSplitScreenSlot aSlot, const int *pNewValue, const int *pOldValue)
+    {
+    	s_aTickratePlugin.ApplyMainThread();
+    }),
+    m_aArbiterConVar("mm_" META_PLUGIN_PREFIX "_arbiter", FCVAR_RELEASE | FCVAR_GAMEDLL, "Share the tickrate, humans and tick cost with the other instances of the host, the least populated ones are lowered over the host CPU budget", false, true, false, true, true, [](ConVar<bool> *pConVar, const CSplitScreenSlot aSlot, const bool *pNewValue, const bool *pOldValue)
+    {
+    	if(*pNewValue == *pOldValue)
+    	{
+    		return;
+    	}
+
+    	if(*pNewValue)
+    	{
+    		char error[256];
+
+    		if(!s_aTickratePlugin.OpenArbiter(error, sizeof(error)))
+    		{
+    			s_aTickratePlugin.WarningFormat("%s\n", error);
+    		}
+    	}
+    	else
+    	{
+    		s_aTickratePlugin.CloseArbiter();
+    	}
+    }),
+    m_aArbiterCpuBudgetConVar("mm_" META_PLUGIN_PREFIX "_arbiter_cpu_budget", FCVAR_RELEASE | FCVAR_GAMEDLL, "A part of the host CPU time (\"/proc/stat\") to lower the instances over", 0.85f, true, 0.05f, true, 1.0f, [](ConVar<float> *pConVar, const CSplitScreenSlot aSlot, const float *pNewValue, const float *pOldValue)
+    {
+    	auto aSettings = s_aTickratePlugin.m_aArbiter.GetSettings();
+
+    	aSettings.m_dblCpuBudget = *pNewValue;
+    	s_aTickratePlugin.m_aArbiter.SetSettings(aSettings);
+    }),
     m_mapConVarCookies(DefLessFunc(const CUtlSymbolLarge)),
-    m_mapLanguages(DefLessFunc(const CUtlSymbolLarge))
+    m_mapLanguages(DefLessFunc(const CUtlSymbolLarge)),
+    m_mapProfiledSystems(DefLessFunc(const IGameSystem *))
 {
 }
 
@@ -136,6 +238,31 @@ bool TickratePlugin::Load(PluginId id, ISmmAPI *ismm, char *error, size_t maxlen
 		return false;
 	}
 
+	if(!ParseGovernor(error, maxlen))
+	{
+		return false;
+	}
+
+	if(!ParseTiers(error, maxlen))
+	{
+		return false;
+	}
+
+	if(!ParseHandshake(error, maxlen))
+	{
+		return false;
+	}
+
+	if(!ParseNetwork(error, maxlen))
+	{
+		return false;
+	}
+
+	if(!ParseMapProfiles(error, maxlen))
+	{
+		return false;
+	}
+
 	if(!RegisterGameFactory(error, maxlen))
 	{
 		return false;
@@ -187,6 +314,8 @@ bool TickratePlugin::Load(PluginId id, ISmmAPI *ismm, char *error, size_t maxlen
 					OnConnectClient(pNetServer, pClient, pClient->GetClientName(), &pClient->m_nAddr, -1, NULL, NULL, NULL, 0, pClient->m_bLowViolence);
 				}
 			}
+
+			m_nHumans = CountHumans(pNetServer); // Counted by the connects too.
 		}
 	}
 
@@ -224,6 +353,13 @@ bool TickratePlugin::Unload(char *error, size_t maxlen)
 
 	SH_REMOVE_HOOK_MEMFUNC(INetworkServerService, StartupServer, g_pNetworkServerService, this, &TickratePlugin::OnStartupServerHook, true);
 
+	UnregisterSystemProfiler();
+	UnregisterPacer();
+	RestoreMainThread();
+	m_aArbiter.Close();
+
+	m_nHumans = 0;
+
 	Assert(ClearLanguages());
 	Assert(ClearTranslations());
 
@@ -318,7 +454,14 @@ void *TickratePlugin::OnMetamodQuery(const char *iface, int *ret)
 
 CGameEntitySystem **TickratePlugin::GetGameEntitySystemPointer() const
 {
-	return reinterpret_cast<CGameEntitySystem **>((uintptr_t)g_pGameResourceServiceServer + GetGameDataStorage().GetGameResource().GetEntitySystemOffset());
+	ptrdiff_t nOffset = GetGameDataStorage().GetGameResource().GetEntitySystemOffset();
+
+	if(nOffset < 0)
+	{
+		return nullptr;
+	}
+
+	return reinterpret_cast<CGameEntitySystem **>((uintptr_t)g_pGameResourceServiceServer + nOffset);
 }
 
 CBaseGameSystemFactory **TickratePlugin::GetFirstGameSystemPointer() const
@@ -526,13 +669,15 @@ ITickrate::IPlayerData *TickratePlugin::GetPlayerData(const CPlayerSlot &aSlot)
 	return &m_aPlayers[aSlot.Get()];
 }
 
-TickratePlugin::CChangedData::CChangedData(int nInitOld, int nInitNew)
+TickratePlugin::CChangedData::CChangedData(int nInitOld, int nInitNew, bool bInitNotify)
  :  m_nOld(nInitOld), 
     m_flOldInterval(1.0f / nInitOld), 
     m_nNew(nInitNew), 
     m_flNewInterval(1.0f / nInitNew), 
     m_dblNewInterval(1.02l / nInitNew), 
-    m_flMultiple(nInitOld / nInitNew)
+    m_flNewTicksPerSecond((float)nInitNew), 
+    m_dblTickMultiple((double)nInitNew / nInitOld), 
+    m_bNotify(bInitNotify)
 {
 }
 
@@ -561,9 +706,19 @@ double TickratePlugin::CChangedData::GetNewInterval2() const
 	return m_dblNewInterval;
 }
 
-float TickratePlugin::CChangedData::GetMultiple() const
+float TickratePlugin::CChangedData::GetNewTicksPerSecond() const
+{
+	return m_flNewTicksPerSecond;
+}
+
+double TickratePlugin::CChangedData::GetTickMultiple() const
+{
+	return m_dblTickMultiple;
+}
+
+bool TickratePlugin::CChangedData::IsNotify() const
 {
-	return m_flMultiple;
+	return m_bNotify;
 }
 
 int TickratePlugin::Get()
@@ -580,140 +735,156 @@ int TickratePlugin::Get()
 	return TICKRATE_DEFAULT;
 }
 
+int TickratePlugin::GetTarget()
+{
+	return m_bHasChangedData ? m_aChangedData.GetNew() : Get();
+}
+
 int TickratePlugin::Set(int nNew)
+{
+	return Stage(nNew, false);
+}
+
+int TickratePlugin::Stage(int nNew, bool bNotify)
 {
 	int nOld = Get();
 
-	const CChangedData aData(nOld, nNew);
+	// Several stages before the commit are merged into the last one, a notified one keeps to notify.
+	m_aChangedData = CChangedData(nOld, nNew, bNotify || (m_bHasChangedData && m_aChangedData.IsNotify()));
+	m_bHasChangedData = true;
 
-	// Change tick globals.
+	// Without a game server nothing reads the tick globals concurrently.
+	if(!g_pNetworkServerService->GetIGameServer())
 	{
-		const auto &aConcat = s_aEmbedConcat;
+		CommitChange();
+	}
 
-		CBufferStringGrowable<1024> sMessage;
+	return nOld;
+}
 
-		sMessage.Format("Old tick intervals:\n");
+bool TickratePlugin::CommitChange()
+{
+	if(!m_bHasChangedData)
+	{
+		return false;
+	}
 
-		// Tick invervals.
-		{
-			const struct
-			{
-				const char *pszName;
-				float *pflValue;
-			} aTickIntervals[] =
-			{
-				{
-					"Tick interval",
-					GetTickIntervalPointer()
-				},
-				// {
-				// 	"Tick interval (#3, default)",
-				// 	GetTickInterval3DefaultPointer()
-				// },
-				{
-					"Tick interval (#3)",
-					GetTickInterval3Pointer()
-				},
-			};
+	m_bHasChangedData = false;
 
-			float flInterval = aData.GetNewInterval();
+	const auto &aData = m_aChangedData;
 
-			for(const auto &aInterval : aTickIntervals)
-			{
-				if(aInterval.pflValue)
-				{
-					aConcat.AppendToBuffer(sMessage, aInterval.pszName, *aInterval.pflValue);
-					*aInterval.pflValue = flInterval;
-				}
-				else
-				{
-					WarningFormat("%s is not ready\n", aInterval.pszName);
-				}
-			}
-		}
+	// Resolve every target first, nothing is written when one is missing.
+	float *pTickInterval = GetTickIntervalPointer(), 
+	      *pTickInterval3 = GetTickInterval3Pointer(), 
+	      *pTicksPerSecond = GetTicksPerSecondPointer();
+
+	double *pTickInterval2 = GetTickInterval2Pointer();
 
-		// Double tick invervals.
+	CFrame *pHostFrame = GetHostFramePointer();
+
+	{
+		const struct
+		{
+			const char *pszName;
+			const void *pTarget;
+		} aTargets[] =
 		{
-			const struct
 			{
-				const char *pszName;
-				double *pdblValue;
-			} aDoubleTickIntervals[] =
+				"Tick interval",
+				pTickInterval
+			},
 			{
-				{
-					"Tick interval (#2)",
-					GetTickInterval2Pointer()
-				},
-			};
-
-			double dblInterval = aData.GetNewInterval2();
+				"Tick interval (#2)",
+				pTickInterval2
+			},
+			// The default tick interval (#3) is an instruction immediate, see the operand patches.
+			{
+				"Tick interval (#3)",
+				pTickInterval3
+			},
+			{
+				"Ticks per second",
+				pTicksPerSecond
+			},
+			{
+				"Host frame",
+				pHostFrame
+			},
+		};
 
-			for(const auto &aInterval : aDoubleTickIntervals)
+		for(const auto &aTarget : aTargets)
+		{
+			if(!aTarget.pTarget)
 			{
-				if(aInterval.pdblValue)
-				{
-					aConcat.AppendToBuffer(sMessage, aInterval.pszName, *aInterval.pdblValue);
-					*aInterval.pdblValue = dblInterval;
-				}
-				else
-				{
-					WarningFormat("%s is not ready\n", aInterval.pszName);
-				}
+				WarningFormat("Rollback the tickrate change from %d to %d: %s is not ready\n", aData.GetOld(), aData.GetNew(), aTarget.pszName);
+
+				return false;
 			}
 		}
+	}
 
-		// Ticks per second.
-		{
-			const struct
-			{
-				const char *pszName;
-				float *pflValue;
-			} aTicksPerSecond[] =
-			{
-				{
-					"Ticks per second",
-					GetTicksPerSecondPointer()
-				},
-			};
+	INetworkGameServer *pServer = g_pNetworkServerService->GetIGameServer();
+
+	CGlobalVars *pGlobals = pServer ? pServer->GetGlobals() : nullptr;
+
+	// Dump the old ones before, to keep the writes together.
+	{
+		const auto &aConcat = s_aEmbedConcat, 
+		           &aConcat2 = s_aEmbed2Concat;
+
+		CBufferStringGrowable<1024> sMessage;
 
-			float flTicks = (float)aData.GetNew();
+		sMessage.Format("Old tick intervals:\n");
+		aConcat.AppendToBuffer(sMessage, "Tick interval", *pTickInterval);
+		aConcat.AppendToBuffer(sMessage, "Tick interval (#3)", *pTickInterval3);
+		aConcat.AppendToBuffer(sMessage, "Tick interval (#2)", *pTickInterval2);
+		aConcat.AppendToBuffer(sMessage, "Ticks per second", *pTicksPerSecond);
+
+		if(IsChannelEnabled(LS_DETAILED))
+		{
+			sMessage.AppendFormat("Host frame:\n");
+			DumpHostFrame(aConcat, sMessage, pHostFrame);
 
-			for(const auto &aSecond : aTicksPerSecond)
+			if(pGlobals)
 			{
-				if(aSecond.pflValue)
-				{
-					aConcat.AppendToBuffer(sMessage, aSecond.pszName, *aSecond.pflValue);
-					*aSecond.pflValue = flTicks;
-				}
-				else
-				{
-					WarningFormat("%s is not ready\n", aSecond.pszName);
-				}
+				sMessage.AppendFormat("Global vars:\n");
+				DumpGlobalVars(aConcat, aConcat2, sMessage, pGlobals);
 			}
 		}
 
 		Logger::Message(sMessage);
 	}
 
-	// A host frame
+	// Compute the ones depending on the live values: the same time in ticks of the new interval.
+	int nNewServerTick = pServer ? (int)(pServer->GetServerTick() * aData.GetTickMultiple()) : 0;
+
+	// One write window per page, closed right after.
+	if(!m_aTickPatches.Open())
 	{
-		CFrame *pHostFrame = GetHostFramePointer();
+		WarningFormat("Rollback the tickrate change from %d to %d: %s\n", aData.GetOld(), aData.GetNew(), "failed to open the tick interval pages for write");
 
-		if(pHostFrame)
-		{
-			ChangeHostFrame(pHostFrame, aData);
-		}
+		return false;
 	}
 
-	// Global vars.
+	// Apply at once.
 	{
-		INetworkGameServer *pServer = g_pNetworkServerService->GetIGameServer();
+		float flInterval = aData.GetNewInterval();
+
+		*pTickInterval = flInterval;
+		*pTickInterval3 = flInterval;
+		*pTickInterval2 = aData.GetNewInterval2();
+		*pTicksPerSecond = aData.GetNewTicksPerSecond();
+
+		ChangeOperandPatches(aData);
+
+		m_aTickPatches.Close();
+		m_aTickWatchdog.Arm();
+
+		ChangeHostFrame(pHostFrame, aData);
 
 		if(pServer)
 		{
-			pServer->SetServerTick((int)(pServer->GetServerTick() * aData.GetMultiple()));
-
-			auto *pGlobals = pServer->GetGlobals();
+			pServer->SetServerTick(nNewServerTick);
 
 			if(pGlobals)
 			{
@@ -722,7 +893,16 @@ int TickratePlugin::Set(int nNew)
 		}
 	}
 
-	return nOld;
+	m_aFrameProfiler.Reset(); // Samples are measured against the old budget.
+	m_aPhaseRecorder.Reset();
+	m_aPacer.Reset(); // A grid of the new interval.
+
+	if(aData.IsNotify())
+	{
+		NotifyChange(aData.GetOld(), aData.GetNew());
+	}
+
+	return true;
 }
 
 int TickratePlugin::Change(int nNew)
@@ -734,10 +914,53 @@ int TickratePlugin::Change(int nNew)
 	return nOld;
 }
 
+void TickratePlugin::QueueChange(int nNew)
+{
+	// Without a game server there are no frame boundaries to wait.
+	if(!g_pNetworkServerService->GetIGameServer())
+	{
+		m_nPendingTickrate.store(0, std::memory_order_relaxed);
+		ChangeInternal(nNew);
+
+		return;
+	}
+
+	// The last one wins, several changes in a frame are merged into it.
+	m_nPendingTickrate.store(nNew, std::memory_order_release);
+}
+
+bool TickratePlugin::ApplyPendingChange()
+{
+	int nNew = m_nPendingTickrate.exchange(0, std::memory_order_acq_rel);
+
+	if(!nNew)
+	{
+		return false;
+	}
+
+	m_nMapProfileTickrate = 0; // An operator one wins until the next map.
+
+	// Out of hibernation, to resume the governor & tiers and hibernate again.
+	m_bHibernating = false;
+	m_dblNoHumansSince = 0.0;
+
+	if(nNew == GetTarget())
+	{
+		return false;
+	}
+
+	ChangeInternal(nNew);
+
+	return true;
+}
+
 int TickratePlugin::ChangeInternal(int nNew)
 {
-	int nOld = Set(nNew);
+	return Stage(nNew, true); // Clients are notified on the commit.
+}
 
+void TickratePlugin::NotifyChange(int nOld, int nNew)
+{
 	if(nOld == nNew)
 	{
 		Logger::MessageFormat("%s to %d\n", "The tickrate are changed", nNew);
@@ -751,6 +974,22 @@ int TickratePlugin::ChangeInternal(int nNew)
 
 	if(pNetServer)
 	{
+		// Clients of the same translation share a phrase, so one message per them.
+		struct PhraseGroup_t
+		{
+			const Translations::CPhrase::CContent *m_pContent;
+			const Translations::CPhrase::CFormat *m_pFormat;
+			CRecipientFilter m_aFilter;
+		};
+
+		PhraseGroup_t aGroups[ABSOLUTE_PLAYER_LIMIT];
+
+		int nGroupCount = 0;
+
+		CRecipientFilter aNetworkFilter;
+
+		int nNetworkRecipients = 0;
+
 		for(auto &pClient : pNetServer->m_Clients)
 		{
 			if(pClient->IsConnected() && !pClient->IsFakeClient())
@@ -767,34 +1006,56 @@ int TickratePlugin::ChangeInternal(int nNew)
 
 				if(aPhrase.m_pFormat && aPhrase.m_pContent)
 				{
-					CSingleRecipientFilter aFilter(aPlayerSlot);
+					int iGroup = 0;
+
+					while(iGroup < nGroupCount && aGroups[iGroup].m_pContent != aPhrase.m_pContent)
+					{
+						iGroup++;
+					}
+
+					auto &aGroup = aGroups[iGroup];
+
+					if(iGroup == nGroupCount)
+					{
+						aGroup.m_pContent = aPhrase.m_pContent;
+						aGroup.m_pFormat = aPhrase.m_pFormat;
+						nGroupCount++;
+					}
 
-					SendTextMessage(&aFilter, HUD_PRINTTALK, 1, aPhrase.m_pContent->Format(*aPhrase.m_pFormat, 2, nOld, nNew).Get());
+					aGroup.m_aFilter.AddRecipient(aPlayerSlot);
 				}
 
-				pClient->SetUpdateRate((float)(Get()));
+				aNetworkFilter.AddRecipient(aPlayerSlot);
+				nNetworkRecipients++;
+
+				pClient->SetUpdateRate((float)nNew);
 			}
 		}
-	}
 
-	return nOld;
-}
+		for(int iGroup = 0; iGroup < nGroupCount; iGroup++)
+		{
+			auto &aGroup = aGroups[iGroup];
 
-void TickratePlugin::ChangeHostFrame(CFrame *pHostFrame, const CChangedData &aData)
-{
-	if(IsChannelEnabled(LS_DETAILED))
-	{
-		const auto &aConcat = s_aEmbedConcat, 
-		           &aConcat2 = s_aEmbed2Concat;
+			SendTextMessage(&aGroup.m_aFilter, HUD_PRINTTALK, 1, aGroup.m_pContent->Format(*aGroup.m_pFormat, 2, nOld, nNew).Get());
+		}
 
-		CBufferStringGrowable<1024> sMessage;
+		// Scale client network settings to the new tickrate.
+		if(nNetworkRecipients)
+		{
+			CUtlString aNetworkValues[TICKRATE_CLIENT_NETWORK_CVARS_COUNT];
 
-		sMessage.Format("Host frame:\n");
-		DumpHostFrame(aConcat, sMessage, pHostFrame);
+			CUtlVector<CVar_t> vecNetworkConVars;
 
-		Logger::Detailed(sMessage);
+			if(GetNetworkConVars(nNew, vecNetworkConVars, aNetworkValues))
+			{
+				SendSetConVar(&aNetworkFilter, vecNetworkConVars);
+			}
+		}
 	}
+}
 
+void TickratePlugin::ChangeHostFrame(CFrame *pHostFrame, const CChangedData &aData)
+{
 	float flNewInterval = aData.GetNewInterval();
 
 	pHostFrame->time_unbounded = flNewInterval;
@@ -803,28 +1064,13 @@ void TickratePlugin::ChangeHostFrame(CFrame *pHostFrame, const CChangedData &aDa
 
 void TickratePlugin::ChangeGlobals(CGlobalVars *pGlobals, const CChangedData &aData)
 {
-	if(IsChannelEnabled(LS_DETAILED))
-	{
-		const auto &aConcat = s_aEmbedConcat, 
-		           &aConcat2 = s_aEmbed2Concat;
-
-		CBufferStringGrowable<1024> sMessage;
-
-		sMessage.Format("Global vars:\n");
-		DumpGlobalVars(aConcat, aConcat2, sMessage, pGlobals);
-
-		Logger::Detailed(sMessage);
-	}
-
-	float flNewInterval = aData.GetNewInterval(), 
-	      flMultiple = aData.GetMultiple();
+	float flNewInterval = aData.GetNewInterval();
 
 	pGlobals->absoluteframetime = flNewInterval;
 	pGlobals->absoluteframestarttimestddev = flNewInterval;
 
-	pGlobals->frametime *= flMultiple;
-	pGlobals->curtime *= flMultiple;
-	pGlobals->rendertime *= flMultiple;
+	// A tick long. The times are in seconds, not depending on the tickrate.
+	pGlobals->frametime = flNewInterval;
 }
 
 bool TickratePlugin::Init()
@@ -855,7 +1101,9 @@ void TickratePlugin::Shutdown()
 
 GS_EVENT_MEMBER(TickratePlugin, GameFrameBoundary)
 {
-	if(m_aEnableFrameDetailsConVar.GetValue() && m_aEnableFrameDetailsConVar.GetValue() && IsChannelEnabled(LS_DETAILED))
+	OnFrameBoundary(msg);
+
+	if(m_aEnableFrameDetailsConVar.GetValue() && IsChannelEnabled(LS_DETAILED))
 	{
 		Logger::DetailedFormat("%s:\n", __FUNCTION__);
 
@@ -872,6 +1120,8 @@ GS_EVENT_MEMBER(TickratePlugin, GameFrameBoundary)
 
 GS_EVENT_MEMBER(TickratePlugin, OutOfGameFrameBoundary)
 {
+	OnFrameBoundary(msg);
+
 	if(m_aEnableFrameDetailsConVar.GetValue() && IsChannelEnabled(LS_DETAILED))
 	{
 		Logger::DetailedFormat("%s:\n", __FUNCTION__);
@@ -887,48 +1137,1751 @@ GS_EVENT_MEMBER(TickratePlugin, OutOfGameFrameBoundary)
 	}
 }
 
-bool TickratePlugin::InitProvider(char *error, size_t maxlen)
+GS_EVENT_MEMBER(TickratePlugin, ServerAdvanceTick)
 {
-	GameData::CBufferStringVector vecMessages;
+	if(m_aEnableProfilerConVar.GetValue())
+	{
+		m_aPhaseRecorder.OnSimulateBegin(Plat_FloatTime());
+	}
 
-	bool bResult = Provider::Init(vecMessages);
+	// Closes the previous tick, a few of them can run in one frame.
+	if(m_aSystemProfiler.GetCount())
+	{
+		m_aSystemProfiler.OnTick();
+	}
 
-	if(vecMessages.Count())
+	if(m_aEnableFrameDetailsConVar.GetValue() && IsChannelEnabled(LS_DETAILED))
 	{
-		if(IsChannelEnabled(LS_WARNING))
-		{
-			auto aWarnings = Logger::CreateWarningsScope();
+		Logger::DetailedFormat("%s:\n", __FUNCTION__);
 
-			FOR_EACH_VEC(vecMessages, i)
-			{
-				auto &aMessage = vecMessages[i];
+		{
+			const auto &aConcat = s_aEmbedConcat, 
+			           &aConcat2 = s_aEmbed2Concat;
 
-				aWarnings.Push(aMessage.Get());
-			}
+			CBufferStringGrowable<1024> sBuffer;
 
-			aWarnings.SendColor([&](Color rgba, const CUtlString &sContext)
-			{
-				Logger::Warning(rgba, sContext);
-			});
+			DumpEventSimulate(aConcat, aConcat2, sBuffer, msg);
+			Logger::Detailed(sBuffer);
 		}
 	}
+}
+
+GS_EVENT_MEMBER(TickratePlugin, ServerGamePostSimulate)
+{
+	if(m_aEnableProfilerConVar.GetValue())
+	{
+		m_aPhaseRecorder.OnSimulateEnd(Plat_FloatTime());
+	}
+}
+
+GS_EVENT_MEMBER(TickratePlugin, ServerPreClientUpdate)
+{
+	if(m_aEnableProfilerConVar.GetValue())
+	{
+		m_aPhaseRecorder.OnSendBegin(Plat_FloatTime());
+	}
+}
+
+// Both boundaries are listened, and which of them the engine dispatches per a frame is not known, so one per a frame is taken.
+void TickratePlugin::OnFrameBoundary(const EventFrameBoundary_t &msg)
+{
+	{
+		INetworkGameServer *pServer = g_pNetworkServerService ? g_pNetworkServerService->GetIGameServer() : nullptr;
+
+		CGlobalVars *pGlobals = pServer ? pServer->GetGlobals() : nullptr;
+
+		int nFrame = pGlobals ? pGlobals->framecount : -1;
+
+		double dblNow = Plat_FloatTime();
+
+		// The frame count can stall out of game, so a repeat is also a close one.
+		if(nFrame != -1 && nFrame == m_nLastBoundaryFrame && dblNow - m_dblLastBoundaryTime < TICKRATE_FRAME_BOUNDARY_REPEAT_TIME)
+		{
+			return;
+		}
+
+		m_nLastBoundaryFrame = nFrame;
+		m_dblLastBoundaryTime = dblNow;
+	}
+
+	if(!m_aMainThread.IsCaptured())
+	{
+		char error[256];
+
+		if(!CaptureMainThread(error, sizeof(error)))
+		{
+			WarningFormat("%s\n", error);
+		}
+	}
+
+	ApplyPendingChange();
+	CommitChange();
+
+	if(m_aTickWatchdog.Think(m_aWatchdogIntervalConVar.GetValue()))
+	{
+		RepairTick();
+	}
+
+	if(m_aEnableProfilerConVar.GetValue())
+	{
+		double dblNow = Plat_FloatTime(), 
+		       dblComputeTime = g_pHostFrame ? (double)g_pHostFrame->time_computationduration : -1.0;
+
+		m_aFrameProfiler.OnFrameBoundary(dblNow, dblComputeTime);
+		m_aPhaseRecorder.OnFrameBoundary(dblNow, dblComputeTime);
+
+		if(m_aEnableGovernorConVar.GetValue() && !m_bHibernating)
+		{
+			ThinkGovernor();
+		}
+	}
+
+	ThinkHibernation();
+
+	if(m_aEnableTiersConVar.GetValue() && !m_bHibernating)
+	{
+		ThinkTiers();
+	}
+
+	if(m_aArbiter.IsOpen())
+	{
+		ThinkArbiter();
+	}
+}
+
+double TickratePlugin::GetTickBudget()
+{
+	return 1.0 / Get();
+}
+
+void TickratePlugin::DumpFrameStats(const ConcatLineString &aConcat, CBufferString &sOutput)
+{
+	Tickrate::FrameProfiler::Stats_t aStats;
+
+	if(!m_aFrameProfiler.Compute(aStats, GetTickBudget(), m_aOverrunToleranceConVar.GetValue()))
+	{
+		aConcat.AppendToBuffer(sOutput, "Frames", 0);
+
+		return;
+	}
+
+	const struct
+	{
+		const char *pszName;
+		const Tickrate::FrameProfiler::Percentiles_t *pPercentiles;
+	} aTimings[] =
+	{
+		{
+			"Wall time",
+			&aStats.m_aWallTime
+		},
+		{
+			"Compute time",
+			&aStats.m_aComputeTime
+		},
+	};
+
+	aConcat.AppendToBuffer(sOutput, "Frames", aStats.m_nSamples);
+	aConcat.AppendToBuffer(sOutput, "Tick budget (ms)", aStats.m_nBudget / 1000.0f);
+
+	for(const auto &aTiming : aTimings)
+	{
+		const auto &aPercentiles = *aTiming.pPercentiles;
+
+		char sValue[64];
+
+		V_snprintf(sValue, sizeof(sValue), "%.3f / %.3f / %.3f / %.3f", aPercentiles.m_nP50 / 1000.0f, aPercentiles.m_nP95 / 1000.0f, aPercentiles.m_nP99 / 1000.0f, aPercentiles.m_nMax / 1000.0f);
+
+		const char *pszKeyConcat[] = {aTiming.pszName, " (p50 / p95 / p99 / max, ms)"};
+
+		CBufferStringGrowable<64> sKey;
+
+		sKey.AppendConcat(ARRAYSIZE(pszKeyConcat), pszKeyConcat, NULL);
+		aConcat.AppendToBuffer(sOutput, sKey.Get(), (const char *)sValue);
+	}
+
+	aConcat.AppendToBuffer(sOutput, "Mean jitter (ms)", aStats.m_nMeanJitter / 1000.0f);
+	aConcat.AppendToBuffer(sOutput, "Overruns", aStats.m_nOverruns);
+	aConcat.AppendToBuffer(sOutput, "Overruns (%)", 100.0f * aStats.m_nOverruns / aStats.m_nSamples);
+}
+
+void TickratePlugin::DumpPhases(const ConcatLineString &aConcat, CBufferString &sOutput)
+{
+	Tickrate::PhaseRecorder::Stats_t aStats;
+
+	if(!m_aPhaseRecorder.Compute(aStats))
+	{
+		aConcat.AppendToBuffer(sOutput, "Frames", 0);
+
+		return;
+	}
+
+	const struct
+	{
+		const char *pszName;
+		const Tickrate::PhaseRecorder::Portion_t *pPortion;
+	} aPortions[] =
+	{
+		{
+			"Simulate",
+			&aStats.m_aSimulate
+		},
+		{
+			"Network send",
+			&aStats.m_aSend
+		},
+		{
+			"Idle",
+			&aStats.m_aIdle
+		},
+	};
+
+	aConcat.AppendToBuffer(sOutput, "Frames", aStats.m_nRecords);
+	aConcat.AppendToBuffer(sOutput, "Ticks per frame", (float)aStats.m_dblTicksPerFrame);
+
+	double dblWallTime = aStats.m_aWall.m_dblMean;
+
+	for(const auto &aPortion : aPortions)
+	{
+		const auto &aTiming = *aPortion.pPortion;
+
+		char sValue[64];
+
+		V_snprintf(sValue, sizeof(sValue), "%.3f / %.3f / %.1f%%", aTiming.m_dblMean / 1000.0, aTiming.m_aPercentiles.m_nP95 / 1000.0f, dblWallTime > 0.0 ? 100.0 * aTiming.m_dblMean / dblWallTime : 0.0);
+
+		const char *pszKeyConcat[] = {aPortion.pszName, " (mean / p95, ms / of the frame)"};
+
+		CBufferStringGrowable<64> sKey;
+
+		sKey.AppendConcat(ARRAYSIZE(pszKeyConcat), pszKeyConcat, NULL);
+		aConcat.AppendToBuffer(sOutput, sKey.Get(), (const char *)sValue);
+	}
+
+	// Without a sleep left, the larger portion limits a higher tickrate.
+	const char *pszBound = "none";
+
+	if(dblWallTime > 0.0 && aStats.m_aIdle.m_dblMean < dblWallTime * 0.1)
+	{
+		pszBound = aStats.m_aSimulate.m_dblMean >= aStats.m_aSend.m_dblMean ? "CPU (simulate)" : "network (send)";
+	}
+
+	aConcat.AppendToBuffer(sOutput, "Bound", pszBound);
+}
+
+bool TickratePlugin::WritePhases(const char *pszFilename, char *error, size_t maxlen)
+{
+	std::vector<Tickrate::PhaseRecorder::Record_t> vecRecords(TICKRATE_PHASE_RECORDER_RECORD_COUNT);
+
+	int nCount = m_aPhaseRecorder.Collect(vecRecords.data(), (int)vecRecords.size());
+
+	Tickrate::PhaseRecorder::FileHeader_t aHeader = 
+	{
+		TICKRATE_PHASE_RECORDER_FILE_MAGIC,
+		TICKRATE_PHASE_RECORDER_FILE_VERSION,
+		(uint16_t)sizeof(Tickrate::PhaseRecorder::Record_t),
+		(uint32_t)Get(),
+		(uint32_t)nCount,
+	};
+
+	FILE *pFile = fopen(pszFilename, "wb");
+
+	if(!pFile)
+	{
+		if(error && maxlen)
+		{
+			snprintf(error, maxlen, "Failed to open \"%s\" file", pszFilename);
+		}
+
+		return false;
+	}
+
+	bool bResult = fwrite(&aHeader, sizeof(aHeader), 1, pFile) == 1 && 
+	               (!nCount || fwrite(vecRecords.data(), sizeof(Tickrate::PhaseRecorder::Record_t), nCount, pFile) == (size_t)nCount);
+
+	fclose(pFile);
+
+	if(!bResult && error && maxlen)
+	{
+		snprintf(error, maxlen, "Failed to write \"%s\" file", pszFilename);
+	}
+
+	return bResult;
+}
+
+// Mirrors "CBaseGameSystemFactory" to walk its list, the members are private.
+class CGameSystemFactoryNode : public IGameSystemFactory
+{
+public:
+	CBaseGameSystemFactory *m_pNext;
+	const char *m_pName;
+};
+
+int TickratePlugin::RegisterSystemProfiler()
+{
+	UnregisterSystemProfiler();
+
+	CBaseGameSystemFactory **ppFirst = GetGameDataStorage().GetGameSystem().GetFirstPointer();
+
+	if(!ppFirst)
+	{
+		Logger::Warning("Failed to get a first game system factory, the game system profiler is not registered\n");
+
+		return 0;
+	}
+
+	for(CBaseGameSystemFactory *pFactory = *ppFirst; pFactory; pFactory = reinterpret_cast<CGameSystemFactoryNode *>(pFactory)->m_pNext)
+	{
+		const char *pszName = reinterpret_cast<CGameSystemFactoryNode *>(pFactory)->m_pName;
+
+		// The reallocating ones have no instance until the game creates it.
+		IGameSystem *pSystem = pFactory->GetStaticGameSystem();
+
+		if(!pSystem)
+		{
+			m_vecSkippedSystems.AddToTail(pszName);
+
+			continue;
+		}
+
+		if(pSystem == static_cast<IGameSystem *>(this) || m_mapProfiledSystems.Find(pSystem) != m_mapProfiledSystems.InvalidIndex())
+		{
+			continue;
+		}
+
+		m_mapProfiledSystems.Insert(pSystem, m_aSystemProfiler.Add(pszName));
+
+		SH_ADD_HOOK_MEMFUNC(IGameSystem, ServerPreEntityThink, pSystem, this, &TickratePlugin::OnServerPreEntityThinkPreHook, false);
+		SH_ADD_HOOK_MEMFUNC(IGameSystem, ServerPreEntityThink, pSystem, this, &TickratePlugin::OnServerPreEntityThinkPostHook, true);
+		SH_ADD_HOOK_MEMFUNC(IGameSystem, ServerPostEntityThink, pSystem, this, &TickratePlugin::OnServerPostEntityThinkPreHook, false);
+		SH_ADD_HOOK_MEMFUNC(IGameSystem, ServerPostEntityThink, pSystem, this, &TickratePlugin::OnServerPostEntityThinkPostHook, true);
+		SH_ADD_HOOK_MEMFUNC(IGameSystem, ServerGamePostSimulate, pSystem, this, &TickratePlugin::OnServerGamePostSimulatePreHook, false);
+		SH_ADD_HOOK_MEMFUNC(IGameSystem, ServerGamePostSimulate, pSystem, this, &TickratePlugin::OnServerGamePostSimulatePostHook, true);
+		SH_ADD_HOOK_MEMFUNC(IGameSystem, ServerPreClientUpdate, pSystem, this, &TickratePlugin::OnServerPreClientUpdatePreHook, false);
+		SH_ADD_HOOK_MEMFUNC(IGameSystem, ServerPreClientUpdate, pSystem, this, &TickratePlugin::OnServerPreClientUpdatePostHook, true);
+	}
+
+	int nCount = m_aSystemProfiler.GetCount();
+
+	if(IsChannelEnabled(LS_DETAILED))
+	{
+		Logger::DetailedFormat("Profiling %d game systems, skipped %d reallocating\n", nCount, m_vecSkippedSystems.Count());
+	}
+
+	return nCount;
+}
+
+void TickratePlugin::UnregisterSystemProfiler()
+{
+	FOR_EACH_MAP_FAST(m_mapProfiledSystems, i)
+	{
+		IGameSystem *pSystem = const_cast<IGameSystem *>(m_mapProfiledSystems.Key(i));
+
+		SH_REMOVE_HOOK_MEMFUNC(IGameSystem, ServerPreEntityThink, pSystem, this, &TickratePlugin::OnServerPreEntityThinkPreHook, false);
+		SH_REMOVE_HOOK_MEMFUNC(IGameSystem, ServerPreEntityThink, pSystem, this, &TickratePlugin::OnServerPreEntityThinkPostHook, true);
+		SH_REMOVE_HOOK_MEMFUNC(IGameSystem, ServerPostEntityThink, pSystem, this, &TickratePlugin::OnServerPostEntityThinkPreHook, false);
+		SH_REMOVE_HOOK_MEMFUNC(IGameSystem, ServerPostEntityThink, pSystem, this, &TickratePlugin::OnServerPostEntityThinkPostHook, true);
+		SH_REMOVE_HOOK_MEMFUNC(IGameSystem, ServerGamePostSimulate, pSystem, this, &TickratePlugin::OnServerGamePostSimulatePreHook, false);
+		SH_REMOVE_HOOK_MEMFUNC(IGameSystem, ServerGamePostSimulate, pSystem, this, &TickratePlugin::OnServerGamePostSimulatePostHook, true);
+		SH_REMOVE_HOOK_MEMFUNC(IGameSystem, ServerPreClientUpdate, pSystem, this, &TickratePlugin::OnServerPreClientUpdatePreHook, false);
+		SH_REMOVE_HOOK_MEMFUNC(IGameSystem, ServerPreClientUpdate, pSystem, this, &TickratePlugin::OnServerPreClientUpdatePostHook, true);
+	}
+
+	m_mapProfiledSystems.Purge();
+	m_vecSkippedSystems.Purge();
+	m_aSystemProfiler.Clear();
+}
+
+void TickratePlugin::BeginSystemEvent(const IGameSystem *pSystem)
+{
+	auto iFound = m_mapProfiledSystems.Find(pSystem);
+
+	if(iFound != m_mapProfiledSystems.InvalidIndex())
+	{
+		m_aSystemProfiler.Begin(m_mapProfiledSystems.Element(iFound));
+	}
+}
+
+void TickratePlugin::EndSystemEvent(const IGameSystem *pSystem)
+{
+	auto iFound = m_mapProfiledSystems.Find(pSystem);
+
+	if(iFound != m_mapProfiledSystems.InvalidIndex())
+	{
+		m_aSystemProfiler.End(m_mapProfiledSystems.Element(iFound));
+	}
+}
+
+void TickratePlugin::DumpSystemProfiler(const ConcatLineString &aConcat, CBufferString &sOutput)
+{
+	int nCount = m_aSystemProfiler.GetCount();
+
+	aConcat.AppendToBuffer(sOutput, "Systems", nCount);
+
+	if(!nCount)
+	{
+		return;
+	}
+
+	aConcat.AppendToBuffer(sOutput, "Ticks", (int)m_aSystemProfiler.GetTickCount());
+
+	// The limits of the profiler, to read the times right.
+	aConcat.AppendToBuffer(sOutput, "Events", (const char *)"ServerPreEntityThink, ServerPostEntityThink, ServerGamePostSimulate, ServerPreClientUpdate (once per frame, to the last tick of it)");
+
+	{
+		CBufferStringGrowable<1024> sSkipped;
+
+		FOR_EACH_VEC(m_vecSkippedSystems, i)
+		{
+			const char *pszSkippedConcat[] = {i ? ", " : "", m_vecSkippedSystems[i].Get()};
+
+			sSkipped.AppendConcat(ARRAYSIZE(pszSkippedConcat), pszSkippedConcat, NULL);
+		}
+
+		char sKey[64];
+
+		V_snprintf(sKey, sizeof(sKey), "Skipped reallocating (%d)", m_vecSkippedSystems.Count());
+		aConcat.AppendToBuffer(sOutput, sKey, m_vecSkippedSystems.Count() ? sSkipped.Get() : (const char *)"none");
+	}
+
+	struct SystemStats_t
+	{
+		int m_iSystem;
+		Tickrate::SystemProfiler::Stats_t m_aStats;
+	};
+
+	std::vector<SystemStats_t> vecStats;
+
+	vecStats.reserve(nCount);
+
+	for(int i = 0; i < nCount; i++)
+	{
+		SystemStats_t aSystemStats {i, {}};
+
+		if(m_aSystemProfiler.Compute(i, aSystemStats.m_aStats))
+		{
+			vecStats.push_back(aSystemStats);
+		}
+	}
+
+	// The most expensive first.
+	std::sort(vecStats.begin(), vecStats.end(), [](const SystemStats_t &aLeft, const SystemStats_t &aRight)
+	{
+		return aLeft.m_aStats.m_aPercentiles.m_nP99 > aRight.m_aStats.m_aPercentiles.m_nP99;
+	});
+
+	if(vecStats.size() > TICKRATE_SYSTEM_PROFILER_DUMP_COUNT)
+	{
+		vecStats.resize(TICKRATE_SYSTEM_PROFILER_DUMP_COUNT);
+	}
+
+	for(const auto &aSystemStats : vecStats)
+	{
+		const auto &aStats = aSystemStats.m_aStats;
+
+		char sValue[64];
+
+		V_snprintf(sValue, sizeof(sValue), "%.2f / %.2f / %.2f", aStats.m_dblMean, aStats.m_aPercentiles.m_nP99 / 1000.0f, aStats.m_aPercentiles.m_nMax / 1000.0f);
+
+		const char *pszKeyConcat[] = {m_aSystemProfiler.GetName(aSystemStats.m_iSystem), " (mean / p99 / max, us)"};
+
+		CBufferStringGrowable<128> sKey;
+
+		sKey.AppendConcat(ARRAYSIZE(pszKeyConcat), pszKeyConcat, NULL);
+		aConcat.AppendToBuffer(sOutput, sKey.Get(), (const char *)sValue);
+	}
+}
+
+bool TickratePlugin::ParseGovernor(char *error, size_t maxlen)
+{
+	const char *pszGovernorFiles = TICKRATE_GAME_GOVERNOR_PATH_FILES;
+
+	// Optional, keep the defaults.
+	if(!LoadConfigFiles(pszGovernorFiles, &TickratePlugin::ParseGovernor) && IsChannelEnabled(LS_DETAILED))
+	{
+		Logger::DetailedFormat("No found a governor config by \"%s\" path, using defaults\n", pszGovernorFiles);
+	}
+
+	return true;
+}
+
+bool TickratePlugin::ParseGovernor(KeyValues3 *pRoot, CUtlVector<CUtlString> &vecMessages)
+{
+	auto aSettings = m_aGovernor.GetSettings();
+
+	KeyValues3 *pLadder = pRoot->FindMember("ladder");
+
+	if(pLadder)
+	{
+		int iCount = pLadder->GetArrayElementCount();
+
+		if(!iCount)
+		{
+			vecMessages.AddToTail("Ladder is empty");
+
+			return false;
+		}
+
+		aSettings.m_vecLadder.clear();
+
+		for(int i = 0; i < iCount; i++)
+		{
+			int iStep = pLadder->GetArrayElement(i)->GetInt();
+
+			if(iStep <= 0)
+			{
+				CUtlString sMessage;
+
+				sMessage.Format("Ladder step #%d is invalid (%d)", i, iStep);
+				vecMessages.AddToTail(sMessage);
+
+				return false;
+			}
+
+			aSettings.m_vecLadder.push_back(iStep);
+		}
+	}
+
+	const struct
+	{
+		const char *pszName;
+		double *pdblValue;
+	} aNumbers[] =
+	{
+		{
+			"window",
+			&aSettings.m_dblWindow
+		},
+		{
+			"overrun_ratio",
+			&aSettings.m_dblOverrunRatio
+		},
+		{
+			"recover_window",
+			&aSettings.m_dblRecoverWindow
+		},
+		{
+			"recover_ratio",
+			&aSettings.m_dblRecoverRatio
+		},
+	};
+
+	for(const auto &aNumber : aNumbers)
+	{
+		const KeyValues3 *pMember = pRoot->FindMember(aNumber.pszName);
+
+		if(pMember)
+		{
+			*aNumber.pdblValue = pMember->GetDouble(*aNumber.pdblValue);
+		}
+	}
+
+	// Of the highest tickrate to govern at.
+	{
+		const auto &vecLadder = aSettings.m_vecLadder;
+
+		int nTop = m_aSVTickrateConVar.GetValue();
+
+		if(!vecLadder.empty())
+		{
+			nTop = std::max(nTop, *std::max_element(vecLadder.cbegin(), vecLadder.cend()));
+		}
+
+		double dblMaxWindow = Tickrate::Governor::GetMaxWindow(nTop);
+
+		for(const auto &aNumber : aNumbers)
+		{
+			if(aNumber.pdblValue != &aSettings.m_dblWindow && aNumber.pdblValue != &aSettings.m_dblRecoverWindow)
+			{
+				continue;
+			}
+
+			if(*aNumber.pdblValue > dblMaxWindow)
+			{
+				Logger::WarningFormat("Governor \"%s\" of %.1f seconds exceeds %d frames of the profiler at %d tick, clamped to %.1f seconds\n", aNumber.pszName, *aNumber.pdblValue, TICKRATE_FRAME_PROFILER_SAMPLE_COUNT, nTop, dblMaxWindow);
+			}
+		}
+	}
+
+	m_aGovernor.SetSettings(aSettings);
+
+	return true;
+}
+
+void TickratePlugin::ThinkGovernor()
+{
+	int nCurrent = Get(), 
+	    nNew = m_aGovernor.Think(Plat_FloatTime(), nCurrent, GetCeiling(), m_aFrameProfiler);
+
+	if(!nNew || nNew == nCurrent)
+	{
+		return;
+	}
+
+	Logger::MessageFormat("Governor: the tick budget is %s, stepping from %d to %d\n", nNew < nCurrent ? "exceeded" : "met", nCurrent, nNew);
+
+	// Keep "sv_tickrate" (or a tier) as the ceiling.
+	ChangeInternal(nNew);
+}
+
+void TickratePlugin::DumpGovernor(const ConcatLineString &aConcat, CBufferString &sOutput)
+{
+	aConcat.AppendToBuffer(sOutput, "Enabled", m_aEnableGovernorConVar.GetValue());
+	aConcat.AppendToBuffer(sOutput, "Ceiling", GetCeiling());
+	aConcat.AppendToBuffer(sOutput, "Last decision", m_aGovernor.GetLastDecision());
+}
+
+void TickratePlugin::ThinkHibernation()
+{
+	int nHibernationTickrate = m_aHibernationTickrateConVar.GetValue();
+
+	if(nHibernationTickrate <= 0)
+	{
+		WakeUp();
+
+		return;
+	}
+
+	double dblNow = Plat_FloatTime();
+
+	if(dblNow < m_dblNextHibernationThink)
+	{
+		return;
+	}
+
+	m_dblNextHibernationThink = dblNow + 1.0;
+
+	if(!g_pNetworkServerService->GetIGameServer() || m_nHumans)
+	{
+		m_dblNoHumansSince = 0.0;
+
+		return;
+	}
+
+	if(m_dblNoHumansSince <= 0.0)
+	{
+		m_dblNoHumansSince = dblNow;
+	}
+
+	if(m_bHibernating || dblNow - m_dblNoHumansSince < m_aHibernationDelayConVar.GetValue() || nHibernationTickrate >= GetTarget())
+	{
+		return;
+	}
+
+	Logger::MessageFormat("Hibernation: no humans for %.0f seconds\n", dblNow - m_dblNoHumansSince);
+
+	m_bHibernating = true;
+	ChangeInternal(nHibernationTickrate);
+}
+
+bool TickratePlugin::WakeUp()
+{
+	if(!m_bHibernating)
+	{
+		return false;
+	}
+
+	m_bHibernating = false;
+	m_dblNoHumansSince = 0.0;
+
+	Logger::Message("Hibernation: waking up\n");
+	ChangeInternal(GetCeiling());
+
+	return true;
+}
+
+void TickratePlugin::DumpHibernation(const ConcatLineString &aConcat, CBufferString &sOutput)
+{
+	aConcat.AppendToBuffer(sOutput, "Tickrate", m_aHibernationTickrateConVar.GetValue());
+	aConcat.AppendToBuffer(sOutput, "Delay (s)", m_aHibernationDelayConVar.GetValue());
+	aConcat.AppendToBuffer(sOutput, "Hibernating", m_bHibernating);
+}
+
+bool TickratePlugin::ParseTiers(char *error, size_t maxlen)
+{
+	const char *pszTiersFiles = TICKRATE_GAME_TIERS_PATH_FILES;
+
+	// Optional, no tiers.
+	if(!LoadConfigFiles(pszTiersFiles, &TickratePlugin::ParseTiers) && IsChannelEnabled(LS_DETAILED))
+	{
+		Logger::DetailedFormat("No found a tiers config by \"%s\" path\n", pszTiersFiles);
+	}
+
+	return true;
+}
+
+bool TickratePlugin::ParseTiers(KeyValues3 *pRoot, CUtlVector<CUtlString> &vecMessages)
+{
+	auto aSettings = m_aTiers.GetSettings();
+
+	KeyValues3 *pTiers = pRoot->FindMember("tiers");
+
+	if(pTiers)
+	{
+		aSettings.m_vecTiers.clear();
+
+		for(int i = 0, iCount = pTiers->GetArrayElementCount(); i < iCount; i++)
+		{
+			KeyValues3 *pTier = pTiers->GetArrayElement(i), 
+			           *pMin = pTier->FindMember("min"), 
+			           *pMax = pTier->FindMember("max"), 
+			           *pTickrate = pTier->FindMember("tickrate");
+
+			Tickrate::Tiers::Tier_t aTier {pMin ? pMin->GetInt() : 1, pMax ? pMax->GetInt() : 0, pTickrate ? pTickrate->GetInt() : 0};
+
+			if(aTier.m_nMinHumans < 0 || (aTier.m_nMaxHumans && aTier.m_nMaxHumans < aTier.m_nMinHumans) || aTier.m_nTickrate <= 0)
+			{
+				CUtlString sMessage;
+
+				sMessage.Format("Tier #%d is invalid (%d-%d players, %d tickrate)", i, aTier.m_nMinHumans, aTier.m_nMaxHumans, aTier.m_nTickrate);
+				vecMessages.AddToTail(sMessage);
+
+				return false;
+			}
+
+			aSettings.m_vecTiers.push_back(aTier);
+		}
+	}
+
+	KeyValues3 *pHysteresis = pRoot->FindMember("hysteresis"), 
+	           *pMinDwell = pRoot->FindMember("min_dwell");
+
+	if(pHysteresis)
+	{
+		aSettings.m_nHysteresis = pHysteresis->GetInt(aSettings.m_nHysteresis);
+	}
+
+	if(pMinDwell)
+	{
+		aSettings.m_dblMinDwell = pMinDwell->GetDouble(aSettings.m_dblMinDwell);
+	}
+
+	m_aTiers.SetSettings(aSettings);
+
+	return true;
+}
+
+void TickratePlugin::ThinkTiers()
+{
+	int nCurrent = GetTarget(), 
+	    nNew = m_aTiers.Think(Plat_FloatTime(), m_nHumans);
+
+	if(!nNew)
+	{
+		return;
+	}
+
+	nNew = std::min(nNew, GetServerTickrate());
+
+	if(m_nArbiterTickrate)
+	{
+		nNew = std::min(nNew, m_nArbiterTickrate);
+	}
+
+	if(nNew == nCurrent)
+	{
+		return;
+	}
+
+	Logger::MessageFormat("Tiers: %d humans, switching from %d to %d\n", m_nHumans, nCurrent, nNew);
+
+	m_aGovernor.Reset(); // Measured against the old tier.
+	ChangeInternal(nNew);
+}
+
+void TickratePlugin::DumpTiers(const ConcatLineString &aConcat, CBufferString &sOutput)
+{
+	aConcat.AppendToBuffer(sOutput, "Enabled", m_aEnableTiersConVar.GetValue());
+	aConcat.AppendToBuffer(sOutput, "Humans", m_nHumans);
+	aConcat.AppendToBuffer(sOutput, "Current tier", m_aTiers.GetCurrent());
+	aConcat.AppendToBuffer(sOutput, "Tier tickrate", m_aTiers.GetCurrentTickrate());
+}
+
+int TickratePlugin::GetBaseCeiling()
+{
+	int nCeiling = GetServerTickrate(), 
+	    nTier = m_aEnableTiersConVar.GetValue() ? m_aTiers.GetCurrentTickrate() : 0;
+
+	return nTier ? std::min(nTier, nCeiling) : nCeiling;
+}
+
+int TickratePlugin::GetCeiling()
+{
+	int nCeiling = GetBaseCeiling();
+
+	return m_nArbiterTickrate ? std::min(m_nArbiterTickrate, nCeiling) : nCeiling;
+}
+
+int TickratePlugin::GetHumanCount() const
+{
+	return m_nHumans;
+}
+
+int TickratePlugin::CountHumans(CNetworkGameServerBase *pNetServer)
+{
+	int nHumans = 0;
+
+	for(const auto &pClient : pNetServer->m_Clients)
+	{
+		if(pClient->IsConnected() && !pClient->IsFakeClient())
+		{
+			nHumans++;
+		}
+	}
+
+	return nHumans;
+}
+
+void TickratePlugin::RepairTick()
+{
+	if(!m_aTickPatches.Open())
+	{
+		WarningFormat("Failed to repair the tick values: %s\n", "failed to open the tick interval pages for write");
+
+		m_aTickWatchdog.Disarm();
+
+		return;
+	}
+
+	m_aTickWatchdog.Restore();
+	m_aTickPatches.Close();
+
+	WarningFormat("The tick values have been reset by the engine, re-applied tickrate %d (%u times)\n", Get(), m_aTickWatchdog.GetDriftCount());
+}
+
+bool TickratePlugin::CaptureMainThread(char *error, size_t maxlen)
+{
+	if(!m_aMainThread.Capture(error, maxlen))
+	{
+		return false;
+	}
+
+	return ApplyMainThread(error, maxlen);
+}
+
+bool TickratePlugin::ApplyMainThread(char *error, size_t maxlen)
+{
+	if(!m_aMainThread.IsCaptured())
+	{
+		return true; // Applies on capture.
+	}
+
+	RestoreMainThread();
+
+	Tickrate::ThreadControl::Settings_t aSettings {{}, (Tickrate::ThreadControl::Policy_t)m_aMainThreadPolicyConVar.GetValue(), m_aMainThreadPriorityConVar.GetValue(), m_aMainThreadNiceConVar.GetValue()};
+
+	const char *pszCpus = m_aMainThreadCpusConVar.GetValue().Get();
+
+	if(!Tickrate::ThreadControl::ParseCpus(pszCpus, aSettings.m_vecCpus))
+	{
+		if(error && maxlen)
+		{
+			snprintf(error, maxlen, "Invalid CPU list \"%s\" of the main thread", pszCpus);
+		}
+		else
+		{
+			WarningFormat("Invalid CPU list \"%s\" of the main thread\n", pszCpus);
+		}
+
+		return false;
+	}
+
+	if(aSettings.m_vecCpus.empty() && aSettings.m_ePolicy == Tickrate::ThreadControl::POLICY_KEEP && !aSettings.m_iNice)
+	{
+		return true;
+	}
+
+	// A tick time to compare with.
+	m_bHasMainThreadBaseline = m_aFrameProfiler.Compute(m_aMainThreadBaseline, GetTickBudget(), m_aOverrunToleranceConVar.GetValue());
+	m_aFrameProfiler.Reset();
+
+	char sError[256];
+
+	bool bResult = m_aMainThread.Apply(aSettings, sError, sizeof(sError));
 
 	if(!bResult)
 	{
-		if(error && maxlen)
+		if(error && maxlen)
+		{
+			strncpy(error, sError, maxlen);
+		}
+		else
+		{
+			WarningFormat("%s\n", sError);
+		}
+	}
+
+	if(IsChannelEnabled(LS_DETAILED))
+	{
+		CBufferStringGrowable<256> sMessage;
+
+		DumpMainThread(s_aEmbedConcat, sMessage);
+		Logger::DetailedFormat("Main thread:\n%s", sMessage.Get());
+	}
+
+	return bResult;
+}
+
+void TickratePlugin::RestoreMainThread()
+{
+	char error[256];
+
+	if(!m_aMainThread.Restore(error, sizeof(error)))
+	{
+		WarningFormat("%s\n", error);
+	}
+}
+
+void TickratePlugin::DumpMainThread(const ConcatLineString &aConcat, CBufferString &sOutput)
+{
+	aConcat.AppendToBuffer(sOutput, "Captured", m_aMainThread.IsCaptured());
+
+	if(!m_aMainThread.IsCaptured())
+	{
+		return;
+	}
+
+	std::vector<int> vecCpus;
+
+	char sCpus[256] = "";
+
+	if(m_aMainThread.GetCpus(vecCpus))
+	{
+		Tickrate::ThreadControl::FormatCpus(vecCpus, sCpus, sizeof(sCpus));
+	}
+
+	aConcat.AppendToBuffer(sOutput, "Applied", m_aMainThread.IsApplied());
+	aConcat.AppendToBuffer(sOutput, "CPUs", (const char *)sCpus);
+	aConcat.AppendToBuffer(sOutput, "Policy", Tickrate::ThreadControl::GetPolicyName(m_aMainThread.GetPolicy()));
+	aConcat.AppendToBuffer(sOutput, "Priority", m_aMainThread.GetPriority());
+	aConcat.AppendToBuffer(sOutput, "Nice", m_aMainThread.GetNice());
+
+	if(!m_bHasMainThreadBaseline)
+	{
+		return;
+	}
+
+	aConcat.AppendToBuffer(sOutput, "Tick time before (p95, ms)", Tickrate::Governor::GetPercentile95(m_aMainThreadBaseline) / 1000.0f);
+
+	Tickrate::FrameProfiler::Stats_t aStats;
+
+	if(m_aFrameProfiler.Compute(aStats, GetTickBudget(), m_aOverrunToleranceConVar.GetValue()))
+	{
+		aConcat.AppendToBuffer(sOutput, "Tick time after (p95, ms)", Tickrate::Governor::GetPercentile95(aStats) / 1000.0f);
+	}
+}
+
+void TickratePlugin::DumpWatchdog(const ConcatLineString &aConcat, CBufferString &sOutput)
+{
+	aConcat.AppendToBuffer(sOutput, "Interval (frames)", m_aWatchdogIntervalConVar.GetValue());
+	aConcat.AppendToBuffer(sOutput, "Armed", m_aTickWatchdog.IsArmed());
+	aConcat.AppendToBuffer(sOutput, "Drifts", (int)m_aTickWatchdog.GetDriftCount());
+}
+
+bool TickratePlugin::OpenArbiter(char *error, size_t maxlen)
+{
+	auto aSettings = m_aArbiter.GetSettings();
+
+	aSettings.m_dblCpuBudget = m_aArbiterCpuBudgetConVar.GetValue();
+	m_aArbiter.SetSettings(aSettings);
+
+	return m_aArbiter.Open("/" META_PLUGIN_PREFIX "_arbiter", error, maxlen);
+}
+
+void TickratePlugin::CloseArbiter()
+{
+	m_aArbiter.Close();
+
+	if(!m_nArbiterTickrate)
+	{
+		return;
+	}
+
+	m_nArbiterTickrate = 0;
+
+	if(!m_bHibernating)
+	{
+		ChangeInternal(GetCeiling());
+	}
+}
+
+void TickratePlugin::ThinkArbiter()
+{
+	double dblNow = Plat_FloatTime();
+
+	if(!m_aArbiter.ShouldThink(dblNow))
+	{
+		return;
+	}
+
+	int nCurrent = GetTarget();
+
+	Tickrate::HostArbiter::Instance_t aSelf {0, nCurrent, m_nHumans, 0, Tickrate::HostArbiter::INSTANCE_NONE};
+
+	Tickrate::FrameProfiler::Stats_t aStats;
+
+	// Of the last second.
+	if(m_aEnableProfilerConVar.GetValue() && nCurrent > 0 && m_aFrameProfiler.Compute(aStats, 1.0 / nCurrent, 0.0, nCurrent))
+	{
+		aSelf.m_nTickCost = Tickrate::Governor::GetPercentile95(aStats);
+	}
+
+	// A hibernating one has lowered itself already.
+	if(!m_bHibernating)
+	{
+		if(m_aGovernor.GetLower(nCurrent))
+		{
+			aSelf.m_nFlags |= Tickrate::HostArbiter::INSTANCE_CAN_LOWER;
+		}
+
+		if(m_nArbiterTickrate)
+		{
+			aSelf.m_nFlags |= Tickrate::HostArbiter::INSTANCE_CAN_RAISE;
+		}
+	}
+
+	int nStep = m_aArbiter.Think(dblNow, aSelf);
+
+	if(nStep < 0)
+	{
+		int nLower = m_aGovernor.GetLower(nCurrent);
+
+		Logger::MessageFormat("Arbiter: the host CPU usage is %.0f%% over %.0f%%, stepping from %d to %d\n", m_aArbiter.GetCpuUsage() * 100.0, m_aArbiter.GetSettings().m_dblCpuBudget * 100.0, nCurrent, nLower);
+
+		m_nArbiterTickrate = nLower;
+		m_aGovernor.Reset();
+		ChangeInternal(nLower);
+	}
+	else if(nStep > 0)
+	{
+		int nBaseCeiling = GetBaseCeiling(), 
+		    nHigher = m_aGovernor.GetHigher(nCurrent, nBaseCeiling);
+
+		// Lifted at the base ceiling.
+		m_nArbiterTickrate = nHigher && nHigher < nBaseCeiling ? nHigher : 0;
+
+		if(!nHigher)
+		{
+			return;
+		}
+
+		Logger::MessageFormat("Arbiter: the host CPU usage is %.0f%%, stepping from %d to %d\n", m_aArbiter.GetCpuUsage() * 100.0, nCurrent, nHigher);
+
+		m_aGovernor.Reset();
+		ChangeInternal(nHigher);
+	}
+}
+
+void TickratePlugin::DumpArbiter(const ConcatLineString &aConcat, CBufferString &sOutput)
+{
+	aConcat.AppendToBuffer(sOutput, "Open", m_aArbiter.IsOpen());
+
+	if(!m_aArbiter.IsOpen())
+	{
+		return;
+	}
+
+	double dblUsage = m_aArbiter.GetCpuUsage();
+
+	char sValue[64];
+
+	if(dblUsage < 0.0)
+	{
+		V_strncpy(sValue, "-", sizeof(sValue));
+	}
+	else
+	{
+		V_snprintf(sValue, sizeof(sValue), "%.1f%% / %.1f%%", dblUsage * 100.0, m_aArbiter.GetSettings().m_dblCpuBudget * 100.0);
+	}
+
+	aConcat.AppendToBuffer(sOutput, "Slot", m_aArbiter.GetSlot());
+	aConcat.AppendToBuffer(sOutput, "Host CPU / budget", (const char *)sValue);
+	aConcat.AppendToBuffer(sOutput, "Limit", m_nArbiterTickrate);
+
+	Tickrate::HostArbiter::Instance_t aInstances[TICKRATE_HOST_ARBITER_SLOT_COUNT];
+
+	int nCount = m_aArbiter.Collect(aInstances, TICKRATE_HOST_ARBITER_SLOT_COUNT);
+
+	for(int n = 0; n < nCount; n++)
+	{
+		const auto &aInstance = aInstances[n];
+
+		char sName[40];
+
+		V_snprintf(sName, sizeof(sName), "Instance %016llX", (unsigned long long)aInstance.m_nToken);
+		V_snprintf(sValue, sizeof(sValue), "%d tick, %d humans, %.2f ms%s%s", aInstance.m_nTickrate, aInstance.m_nHumans, aInstance.m_nTickCost / 1000.0, 
+		           aInstance.m_nFlags & Tickrate::HostArbiter::INSTANCE_CAN_LOWER ? ", lowerable" : "", 
+		           aInstance.m_nFlags & Tickrate::HostArbiter::INSTANCE_CAN_RAISE ? ", raisable" : "");
+
+		aConcat.AppendToBuffer(sOutput, sName, (const char *)sValue);
+	}
+}
+
+bool TickratePlugin::RegisterPacer(char *error, size_t maxlen)
+{
+	const auto &aTick = GetGameDataStorage().GetTick();
+
+	void *pSleepAfterMainLoop = aTick.GetSleepAfterMainLoop();
+
+	const auto &aPrologue = aTick.GetSleepAfterMainLoopPrologue();
+
+	if(!pSleepAfterMainLoop || aPrologue.m_vecBytes.empty())
+	{
+		if(error && maxlen)
+		{
+			strncpy(error, "Failed to get \"CEngineServiceMgr::SleepAfterMainLoop\" and its prologue, the pacer is not registered", maxlen);
+		}
+
+		return false;
+	}
+
+	m_aPacer.SetSpinBudget((uint32_t)m_aPacerSpinConVar.GetValue());
+	m_aPacer.Reset();
+
+	if(!m_aSleepHook.Install(pSleepAfterMainLoop, aPrologue.m_vecBytes.data(), aPrologue.m_vecMask.data(), aPrologue.m_vecBytes.size(), &TickratePlugin::OnSleepAfterMainLoop, this))
+	{
+		if(error && maxlen)
+		{
+			strncpy(error, "Failed to hook \"CEngineServiceMgr::SleepAfterMainLoop\" (its prologue doesn't match the gamedata one), the pacer is not registered", maxlen);
+		}
+
+		return false;
+	}
+
+	return true;
+}
+
+void TickratePlugin::UnregisterPacer()
+{
+	m_aSleepHook.Remove();
+}
+
+void TickratePlugin::OnSleepAfterMainLoop(void *pContext)
+{
+	auto *pPlugin = reinterpret_cast<TickratePlugin *>(pContext);
+
+	// The function runs after: its frame time filtering is required, the sleep of it is short or none at the grid deadline.
+	pPlugin->m_aPacer.Wait(pPlugin->GetTickBudget());
+}
+
+void TickratePlugin::DumpPacer(const ConcatLineString &aConcat, CBufferString &sOutput)
+{
+	aConcat.AppendToBuffer(sOutput, "Hooked", m_aSleepHook.IsInstalled());
+
+	Tickrate::Pacer::Stats_t aStats;
+
+	if(!m_aPacer.Compute(aStats))
+	{
+		aConcat.AppendToBuffer(sOutput, "Frames", 0);
+
+		return;
+	}
+
+	char sValue[64];
+
+	V_snprintf(sValue, sizeof(sValue), "%.1f / %.1f / %.1f / %.1f", aStats.m_dblMeanJitter / 1000.0, aStats.m_aJitter.m_nP95 / 1000.0f, aStats.m_aJitter.m_nP99 / 1000.0f, aStats.m_aJitter.m_nMax / 1000.0f);
+
+	aConcat.AppendToBuffer(sOutput, "Frames", aStats.m_nFrames);
+	aConcat.AppendToBuffer(sOutput, "Frame start jitter (mean / p95 / p99 / max, us)", (const char *)sValue);
+	aConcat.AppendToBuffer(sOutput, "Late frames", (int)aStats.m_nLateFrames);
+	aConcat.AppendToBuffer(sOutput, "Sleep overshoot (us)", aStats.m_nOversleep / 1000.0f);
+	aConcat.AppendToBuffer(sOutput, "Spin budget (us)", (int)m_aPacer.GetSpinBudget());
+}
+
+bool TickratePlugin::ParseHandshake(char *error, size_t maxlen)
+{
+	const char *pszHandshakeFiles = TICKRATE_GAME_HANDSHAKE_PATH_FILES;
+
+	m_vecHandshakeReplicates.Purge();
+	m_vecHandshakeQueries.Purge();
+
+	// Required by the plugin itself.
+	m_vecHandshakeQueries.AddToTail(TICKRATE_CLIENT_CVAR_NAME_LANGUAGE);
+
+	InvalidateHandshake();
+
+	// Optional, keep the defaults.
+	if(!LoadConfigFiles(pszHandshakeFiles, &TickratePlugin::ParseHandshake) && IsChannelEnabled(LS_DETAILED))
+	{
+		Logger::DetailedFormat("No found a handshake config by \"%s\" path, using defaults\n", pszHandshakeFiles);
+	}
+
+	return true;
+}
+
+bool TickratePlugin::ParseHandshake(KeyValues3 *pRoot, CUtlVector<CUtlString> &vecMessages)
+{
+	KeyValues3 *pReplicate = pRoot->FindMember("replicate");
+
+	if(pReplicate)
+	{
+		int iMemberCount = pReplicate->GetMemberCount();
+
+		for(KV3MemberId_t n = 0; n < iMemberCount; n++)
+		{
+			const char *pszName = pReplicate->GetMemberName(n);
+
+			if(!V_stricmp(pszName, TICKRATE_CLIENT_CVAR_NAME_CLOCK_CORRECTION))
+			{
+				CUtlString sMessage;
+
+				sMessage.Format("\"%s\" is replicated by \"%s\", skipping", pszName, m_aSVToClientClockCorrection.GetName());
+				vecMessages.AddToTail(sMessage);
+
+				continue;
+			}
+
+			KeyValues3 *pValue = pReplicate->GetMember(n);
+
+			CUtlString sValue;
+
+			// A cvar value is a string on the wire, JSON numbers are not.
+			switch(pValue->GetType())
+			{
+				case KV3_TYPE_BOOL:
+				{
+					sValue = pValue->GetBool() ? "1" : "0";
+
+					break;
+				}
+
+				case KV3_TYPE_INT:
+				{
+					sValue.Format("%lld", (long long)pValue->GetInt64());
+
+					break;
+				}
+
+				case KV3_TYPE_UINT:
+				{
+					sValue.Format("%llu", (unsigned long long)pValue->GetUInt64());
+
+					break;
+				}
+
+				case KV3_TYPE_DOUBLE:
+				{
+					sValue.Format("%g", pValue->GetDouble());
+
+					break;
+				}
+
+				case KV3_TYPE_STRING:
+				{
+					sValue = pValue->GetString();
+
+					break;
+				}
+
+				default:
+				{
+					CUtlString sMessage;
+
+					sMessage.Format("\"%s\" value is not a string, number or bool, skipping", pszName);
+					vecMessages.AddToTail(sMessage);
+
+					continue;
+				}
+			}
+
+			m_vecHandshakeReplicates.AddToTail({pszName, sValue});
+		}
+	}
+
+	KeyValues3 *pQuery = pRoot->FindMember("query");
+
+	if(pQuery)
+	{
+		int iCount = pQuery->GetArrayElementCount();
+
+		for(int i = 0; i < iCount; i++)
+		{
+			const char *pszName = pQuery->GetArrayElement(i)->GetString();
+
+			if(!pszName || !pszName[0])
+			{
+				CUtlString sMessage;
+
+				sMessage.Format("Query #%d is empty", i);
+				vecMessages.AddToTail(sMessage);
+
+				continue;
+			}
+
+			if(m_vecHandshakeQueries.Find(pszName) == m_vecHandshakeQueries.InvalidIndex())
+			{
+				m_vecHandshakeQueries.AddToTail(pszName);
+			}
+		}
+	}
+
+	return !vecMessages.Count();
+}
+
+void TickratePlugin::InvalidateHandshake()
+{
+	m_bHandshakeDirty = true;
+}
+
+bool TickratePlugin::BuildHandshake()
+{
+	if(!m_aSetConVarPool.GetMessage() || !m_aGetCvarValuePool.GetMessage())
+	{
+		return false;
+	}
+
+	ClearHandshakeMessages();
+
+	// Replicates.
+	{
+		auto *pMessage = m_aSetConVarPool.Acquire();
+
+		auto *pConVars = pMessage->mutable_convars();
+
+		{
+			char sClockCorrectionValue[8];
+
+			m_aSVToClientClockCorrection.GetStringValue(sClockCorrectionValue, sizeof(sClockCorrectionValue));
+
+			auto *pConVar = pConVars->add_cvars();
+
+			pConVar->set_name(TICKRATE_CLIENT_CVAR_NAME_CLOCK_CORRECTION);
+			pConVar->set_value(sClockCorrectionValue);
+		}
+
+		// Matched to the tickrate, which a connecting client gets.
+		int nTickrate = GetTarget();
+
+		CUtlString aNetworkValues[TICKRATE_CLIENT_NETWORK_CVARS_COUNT];
+
+		CUtlVector<CVar_t> vecNetworkConVars;
+
+		GetNetworkConVars(nTickrate, vecNetworkConVars, aNetworkValues);
+
+		for(const auto &aCVar : m_vecHandshakeReplicates)
+		{
+			// The network profile covers it, to not send twice.
+			bool bNetwork = false;
+
+			for(const auto &aNetworkCVar : vecNetworkConVars)
+			{
+				if(!V_stricmp(aCVar.m_sName.Get(), aNetworkCVar.m_pszName))
+				{
+					bNetwork = true;
+
+					break;
+				}
+			}
+
+			if(bNetwork)
+			{
+				continue;
+			}
+
+			auto *pConVar = pConVars->add_cvars();
+
+			pConVar->set_name(aCVar.m_sName.Get());
+			pConVar->set_value(aCVar.m_sValue.Get());
+		}
+
+		for(const auto &aCVar : vecNetworkConVars)
+		{
+			auto *pConVar = pConVars->add_cvars();
+
+			pConVar->set_name(aCVar.m_pszName);
+			pConVar->set_value(aCVar.m_pszValue);
+		}
+
+		m_nHandshakeTickrate = nTickrate;
+
+		m_pHandshakeSetConVarMessage = pMessage;
+	}
+
+	// Queries, with a cookie per cvar for all clients.
+	for(const auto &sName : m_vecHandshakeQueries)
+	{
+		const char *pszName = sName.Get();
+
+		auto sConVarSymbol = GetConVarSymbol(pszName);
+
+		int iCookie = m_vecHandshakeQueryMessages.Count();
+
+		auto iFound = m_mapConVarCookies.Find(sConVarSymbol);
+
+		if(m_mapConVarCookies.IsValidIndex(iFound))
+		{
+			m_mapConVarCookies.Element(iFound) = iCookie;
+		}
+		else
+		{
+			m_mapConVarCookies.Insert(sConVarSymbol, iCookie);
+		}
+
+		auto *pMessage = m_aGetCvarValuePool.Acquire();
+
+		pMessage->set_cvar_name(pszName);
+		pMessage->set_cookie(iCookie);
+
+		m_vecHandshakeQueryMessages.AddToTail(pMessage);
+	}
+
+	m_bHandshakeDirty = false;
+
+	if(IsChannelEnabled(LV_DETAILED))
+	{
+		const auto &aConcat = s_aEmbedConcat;
+
+		CBufferStringGrowable<1024> sBuffer;
+
+		sBuffer.Format("Handshake:\n");
+
+		for(const auto &aCVar : m_pHandshakeSetConVarMessage->convars().cvars())
+		{
+			aConcat.AppendStringToBuffer(sBuffer, aCVar.name().c_str(), aCVar.value().c_str());
+		}
+
+		for(const auto *pQuery : m_vecHandshakeQueryMessages)
+		{
+			aConcat.AppendToBuffer(sBuffer, pQuery->cvar_name().c_str(), pQuery->cookie());
+		}
+
+		Logger::Detailed(sBuffer);
+	}
+
+	return true;
+}
+
+void TickratePlugin::ClearHandshakeMessages()
+{
+	if(m_pHandshakeSetConVarMessage)
+	{
+		m_aSetConVarPool.Release(m_pHandshakeSetConVarMessage);
+		m_pHandshakeSetConVarMessage = nullptr;
+	}
+
+	for(auto *pMessage : m_vecHandshakeQueryMessages)
+	{
+		m_aGetCvarValuePool.Release(pMessage);
+	}
+
+	m_vecHandshakeQueryMessages.Purge();
+
+	m_bHandshakeDirty = true;
+}
+
+void TickratePlugin::SendHandshake(IRecipientFilter *pFilter)
+{
+	if((m_bHandshakeDirty || m_nHandshakeTickrate != GetTarget()) && !BuildHandshake())
+	{
+		Logger::Warning("Handshake messages are not ready\n");
+
+		return;
+	}
+
+	g_pGameEventSystem->PostEventAbstract(-1, false, pFilter, m_aSetConVarPool.GetMessage(), m_pHandshakeSetConVarMessage, 0);
+
+	auto *pGetCvarValueMessage = m_aGetCvarValuePool.GetMessage();
+
+	for(const auto *pMessage : m_vecHandshakeQueryMessages)
+	{
+		g_pGameEventSystem->PostEventAbstract(-1, false, pFilter, pGetCvarValueMessage, pMessage, 0);
+	}
+}
+
+bool TickratePlugin::ParseMapProfiles(char *error, size_t maxlen)
+{
+	const char *pszMapsFiles = TICKRATE_GAME_MAPS_PATH_FILES;
+
+	// Optional, "sv_tickrate" for every map.
+	if(!LoadConfigFiles(pszMapsFiles, &TickratePlugin::ParseMapProfiles) && IsChannelEnabled(LS_DETAILED))
+	{
+		Logger::DetailedFormat("No found a maps config by \"%s\" path\n", pszMapsFiles);
+	}
+
+	return true;
+}
+
+bool TickratePlugin::ParseMapProfiles(KeyValues3 *pRoot, CUtlVector<CUtlString> &vecMessages)
+{
+	KeyValues3 *pProfiles = pRoot->FindMember("profiles");
+
+	if(!pProfiles)
+	{
+		vecMessages.AddToTail("No \"profiles\" member");
+
+		return false;
+	}
+
+	std::vector<Tickrate::MapProfiles::Profile_t> vecProfiles;
+
+	for(int i = 0, iCount = pProfiles->GetArrayElementCount(); i < iCount; i++)
+	{
+		const KeyValues3 *pProfile = pProfiles->GetArrayElement(i);
+
+		const KeyValues3 *pMap = pProfile->FindMember("map"), 
+		                 *pWorkshop = pProfile->FindMember("workshop"), 
+		                 *pGameMode = pProfile->FindMember("gamemode"), 
+		                 *pTickrate = pProfile->FindMember("tickrate"), 
+		                 *pNetwork = pProfile->FindMember("network");
+
+		Tickrate::MapProfiles::Profile_t aProfile {};
+
+		aProfile.m_sMap = pMap ? pMap->GetString() : "";
+		aProfile.m_sWorkshop = pWorkshop ? pWorkshop->GetString() : "";
+		aProfile.m_sGameMode = pGameMode ? pGameMode->GetString() : "";
+		aProfile.m_nTickrate = pTickrate ? pTickrate->GetInt() : 0;
+
+		if(aProfile.m_nTickrate <= 0)
+		{
+			CUtlString sMessage;
+
+			sMessage.Format("Profile #%d has invalid \"tickrate\" (%d)", i, aProfile.m_nTickrate);
+			vecMessages.AddToTail(sMessage);
+
+			return false;
+		}
+
+		if(pNetwork)
+		{
+			aProfile.m_bHasNetwork = true;
+
+			if(!ParseNetworkTier(pNetwork, aProfile.m_nTickrate, aProfile.m_aNetwork))
+			{
+				CUtlString sMessage;
+
+				sMessage.Format("Profile #%d has invalid \"network\" (%d rate)", i, aProfile.m_aNetwork.m_nRate);
+				vecMessages.AddToTail(sMessage);
+
+				return false;
+			}
+		}
+
+		vecProfiles.push_back(aProfile);
+	}
+
+	m_aMapProfiles.SetProfiles(vecProfiles);
+
+	return true;
+}
+
+void TickratePlugin::ApplyMapProfile(CNetworkGameServerBase *pNetServer, const GameSessionConfiguration_t &config)
+{
+	const char *pszMap = pNetServer->GetMapName(), 
+	           *pszWorkshop = pNetServer->GetAddonName(), 
+	           *pszGameMode = config.gamemode().c_str();
+
+	// Opt-in, otherwise drops the one of the previous map.
+	const auto *pProfile = m_aEnableMapProfilesConVar.GetValue() ? m_aMapProfiles.Find(pszMap, pszWorkshop, pszGameMode) : nullptr;
+
+	bool bHadMapNetwork = m_bHasMapNetwork;
+
+	m_bHasMapNetwork = pProfile && pProfile->m_bHasNetwork;
+
+	if(m_bHasMapNetwork)
+	{
+		m_aMapNetworkProfile.SetTiers({pProfile->m_aNetwork});
+	}
+
+	if(m_bHasMapNetwork || bHadMapNetwork)
+	{
+		InvalidateHandshake();
+	}
+
+	int nOldProfileTickrate = m_nMapProfileTickrate;
+
+	// Instead of "sv_tickrate", an operator one is kept to return to.
+	m_nMapProfileTickrate = pProfile ? pProfile->m_nTickrate : 0;
+
+	if(pProfile)
+	{
+		Logger::MessageFormat("Map profile of \"%s\" (workshop \"%s\", game mode \"%s\"): %d tickrate\n", pszMap, pszWorkshop, pszGameMode, m_nMapProfileTickrate);
+	}
+	else if(!nOldProfileTickrate)
+	{
+		return;
+	}
+
+	if(m_bHibernating)
+	{
+		return; // Wakes up to the ceiling.
+	}
+
+	int nTickrate = GetCeiling();
+
+	// Staged right now, so the first server info has it.
+	if(nTickrate != GetTarget())
+	{
+		ChangeInternal(nTickrate);
+	}
+}
+
+int TickratePlugin::GetServerTickrate()
+{
+	return m_nMapProfileTickrate ? m_nMapProfileTickrate : m_aSVTickrateConVar.GetValue();
+}
+
+bool TickratePlugin::ParseNetwork(char *error, size_t maxlen)
+{
+	const char *pszNetworkFiles = TICKRATE_GAME_NETWORK_PATH_FILES;
+
+	// Optional, clients keep own network settings.
+	if(!LoadConfigFiles(pszNetworkFiles, &TickratePlugin::ParseNetwork))
+	{
+		if(IsChannelEnabled(LS_DETAILED))
 		{
-			strncpy(error, "Failed to initialize provider. See warnings", maxlen);
+			Logger::DetailedFormat("No found a network config by \"%s\" path\n", pszNetworkFiles);
 		}
+
+		return true;
 	}
 
-	return bResult;
+	InvalidateHandshake();
+
+	return true;
 }
 
-bool TickratePlugin::LoadProvider(char *error, size_t maxlen)
+bool TickratePlugin::ParseNetwork(KeyValues3 *pRoot, CUtlVector<CUtlString> &vecMessages)
+{
+	KeyValues3 *pTiers = pRoot->FindMember("tiers");
+
+	if(!pTiers)
+	{
+		vecMessages.AddToTail("No \"tiers\" member");
+
+		return false;
+	}
+
+	std::vector<Tickrate::NetworkProfile::Tier_t> vecTiers;
+
+	int iCount = pTiers->GetArrayElementCount();
+
+	for(int i = 0; i < iCount; i++)
+	{
+		Tickrate::NetworkProfile::Tier_t aTier;
+
+		if(!ParseNetworkTier(pTiers->GetArrayElement(i), 0, aTier))
+		{
+			CUtlString sMessage;
+
+			sMessage.Format("Tier #%d has invalid \"tickrate\" (%d) or \"rate\" (%d)", i, aTier.m_nTickrate, aTier.m_nRate);
+			vecMessages.AddToTail(sMessage);
+
+			return false;
+		}
+
+		vecTiers.push_back(aTier);
+	}
+
+	m_aNetworkProfile.SetTiers(vecTiers);
+
+	return true;
+}
+
+bool TickratePlugin::ParseNetworkTier(const KeyValues3 *pTier, int nDefaultTickrate, Tickrate::NetworkProfile::Tier_t &aOutput)
+{
+	const KeyValues3 *pTickrate = pTier->FindMember("tickrate"), 
+	                 *pRate = pTier->FindMember("rate"), 
+	                 *pUpdateRate = pTier->FindMember("update_rate"), 
+	                 *pInterpRatio = pTier->FindMember("interp_ratio"), 
+	                 *pInterp = pTier->FindMember("interp");
+
+	aOutput =
+	{
+		pTickrate ? pTickrate->GetInt() : nDefaultTickrate,
+		pRate ? pRate->GetInt() : 0,
+		pUpdateRate ? pUpdateRate->GetInt() : 0,
+		pInterpRatio ? pInterpRatio->GetFloat(1.0f) : 1.0f,
+		pInterp ? pInterp->GetFloat() : 0.0f,
+	};
+
+	return aOutput.m_nTickrate > 0 && aOutput.m_nRate > 0;
+}
+
+bool TickratePlugin::GetNetworkConVars(int nTickrate, CUtlVector<CVar_t> &vecOutput, CUtlString (&aValues)[TICKRATE_CLIENT_NETWORK_CVARS_COUNT])
+{
+	Tickrate::NetworkProfile::Tier_t aTier;
+
+	// A map profile overrides the tiers.
+	const auto &aNetworkProfile = m_bHasMapNetwork ? m_aMapNetworkProfile : m_aNetworkProfile;
+
+	if(!aNetworkProfile.Resolve(nTickrate, aTier))
+	{
+		return false;
+	}
+
+	aValues[0].Format("%d", aTier.m_nRate);
+	aValues[1].Format("%d", aTier.m_nUpdateRate);
+	aValues[2].Format("%g", aTier.m_flInterpRatio);
+	aValues[3].Format("%g", aTier.m_flInterp);
+
+	vecOutput.AddToTail({TICKRATE_CLIENT_CVAR_NAME_RATE, aValues[0].Get()});
+	vecOutput.AddToTail({TICKRATE_CLIENT_CVAR_NAME_UPDATE_RATE, aValues[1].Get()});
+	vecOutput.AddToTail({TICKRATE_CLIENT_CVAR_NAME_INTERP_RATIO, aValues[2].Get()});
+	vecOutput.AddToTail({TICKRATE_CLIENT_CVAR_NAME_INTERP, aValues[3].Get()});
+
+	return true;
+}
+
+int TickratePlugin::LoadConfigFiles(const char *pszPathFiles, ParseConfig_t pfnParse)
+{
+	const char *pszPathID = TICKRATE_BASE_PATHID;
+
+	CUtlVector<CUtlString> vecFiles;
+	CUtlVector<CUtlString> vecSubmessages;
+
+	CUtlString sMessage;
+
+	auto aWarnings = Logger::CreateWarningsScope();
+
+	AnyConfig::LoadFromFile_Generic_t aLoadPresets({{&sMessage, NULL, pszPathID}, g_KV3Format_Generic});
+
+	g_pFullFileSystem->FindFileAbsoluteList(vecFiles, pszPathFiles, pszPathID);
+
+	for(const auto &sFile : vecFiles)
+	{
+		const char *pszFilename = sFile.Get();
+
+		AnyConfig::Anyone aConfig;
+
+		aLoadPresets.m_pszFilename = pszFilename;
+
+		if(!aConfig.Load(aLoadPresets))
+		{
+			aWarnings.PushFormat("\"%s\": %s", pszFilename, sMessage.Get());
+
+			continue;
+		}
+
+		vecSubmessages.Purge();
+
+		if(!(this->*pfnParse)(aConfig.Get(), vecSubmessages))
+		{
+			aWarnings.PushFormat("\"%s\"", pszFilename);
+
+			for(const auto &sSubmessage : vecSubmessages)
+			{
+				aWarnings.PushFormat("\t%s", sSubmessage.Get());
+			}
+
+			continue;
+		}
+	}
+
+	if(aWarnings.Count())
+	{
+		aWarnings.Send([&](const CUtlString &sMessage)
+		{
+			Logger::Warning(sMessage);
+		});
+	}
+
+	return vecFiles.Count();
+}
+
+bool TickratePlugin::InitProvider(char *error, size_t maxlen)
 {
 	GameData::CBufferStringVector vecMessages;
 
-	bool bResult = Provider::Load(TICKRATE_BASE_DIR, TICKRATE_BASE_PATHID, vecMessages);
+	bool bResult = Provider::Init(vecMessages);
 
 	if(vecMessages.Count())
 	{
@@ -950,6 +2903,28 @@ bool TickratePlugin::LoadProvider(char *error, size_t maxlen)
 		}
 	}
 
+	if(!bResult)
+	{
+		if(error && maxlen)
+		{
+			strncpy(error, "Failed to initialize provider. See warnings", maxlen);
+		}
+	}
+
+	return bResult;
+}
+
+bool TickratePlugin::LoadProvider(char *error, size_t maxlen)
+{
+	GameData::CBufferStringVector vecMessages;
+
+	bool bResult = Provider::Load(TICKRATE_BASE_DIR, TICKRATE_BASE_PATHID, vecMessages);
+
+	if(vecMessages.Count())
+	{
+		OnGameDataMessages(vecMessages);
+	}
+
 	if(!bResult)
 	{
 		if(error && maxlen)
@@ -998,6 +2973,34 @@ bool TickratePlugin::UnloadProvider(char *error, size_t maxlen)
 	return bResult;
 }
 
+void TickratePlugin::OnGameDataCacheSaved(const char *pszCacheFile)
+{
+	if(IsChannelEnabled(LS_DETAILED))
+	{
+		Logger::DetailedFormat("Saved the resolved gamedata to \"%s\" file\n", pszCacheFile);
+	}
+}
+
+void TickratePlugin::OnGameDataMessages(const GameData::CBufferStringVector &vecMessages)
+{
+	if(IsChannelEnabled(LS_WARNING))
+	{
+		auto aWarnings = Logger::CreateWarningsScope();
+
+		FOR_EACH_VEC(vecMessages, i)
+		{
+			const auto &aMessage = vecMessages[i];
+
+			aWarnings.Push(aMessage.Get());
+		}
+
+		aWarnings.SendColor([&](Color rgba, const CUtlString &sContext)
+		{
+			Logger::Warning(rgba, sContext);
+		});
+	}
+}
+
 bool TickratePlugin::RegisterGameResource(char *error, size_t maxlen)
 {
 	CGameEntitySystem **pGameEntitySystem = GetGameEntitySystemPointer();
@@ -1062,24 +3065,164 @@ bool TickratePlugin::RegisterGameFactory(char *error, size_t maxlen)
 		return false;
 	}
 
-	m_pFactory = new CGameSystemStaticFactory<TickratePlugin>(GetName(), this);
+	m_pFactory = new CGameSystemStaticFactory<TickratePlugin>(GetName(), this);
+
+	return true;
+}
+
+bool TickratePlugin::UnregisterGameFactory(char *error, size_t maxlen)
+{
+	if(m_pFactory)
+	{
+		m_pFactory->Shutdown();
+		m_pFactory->DestroyGameSystem(this);
+	}
+
+	if(!UnregisterFirstGameSystem())
+	{
+		if(error && maxlen)
+		{
+			strncpy(error, "Failed to unregister a first game factory", maxlen);
+		}
+
+		return false;
+	}
+
+	return true;
+}
+
+bool TickratePlugin::RegisterSource2Server(char *error, size_t maxlen)
+{
+	IGameEventManager2 **ppGameEventManager = GetGameEventManagerPointer();
+
+	if(!ppGameEventManager)
+	{
+		if(error && maxlen)
+		{
+			strncpy(error, "Failed to get a game event manager", maxlen);
+		}
+
+		return false;
+	}
+
+	if(!RegisterGameEventManager(*ppGameEventManager))
+	{
+		if(error && maxlen)
+		{
+			strncpy(error, "Failed to register a game event manager", maxlen);
+		}
+
+		return false;
+	}
+
+	return true;
+}
+
+bool TickratePlugin::UnregisterSource2Server(char *error, size_t maxlen)
+{
+	if(!UnregisterGameEventManager())
+	{
+		if(error && maxlen)
+		{
+			strncpy(error, "Failed to register a game event manager", maxlen);
+		}
+
+		return false;
+	}
+
+	return true;
+}
+
+bool TickratePlugin::RegisterTick(char *error, size_t maxlen)
+{
+	float *pTickInterval = GetTickIntervalPointer(), 
+	      *pTickInterval3Default = GetTickInterval3DefaultPointer(), 
+	      *pTickInterval3 = GetTickInterval3Pointer(), 
+	      *pTicksPerSecond = GetTicksPerSecondPointer();
+
+	double *pTickInterval2 = GetTickInterval2Pointer();
+
+	const struct
+	{
+		const char *pszName;
+		void *pTarget;
+		size_t nSize;
+		bool bPatch;
+	} aTargets[] =
+	{
+		{
+			"a tick interval",
+			pTickInterval,
+			sizeof(*pTickInterval),
+			true
+		},
+		{
+			"a tick interval (#2)",
+			pTickInterval2,
+			sizeof(*pTickInterval2),
+			true
+		},
+		{
+			"a default tick interval (#3)",
+			pTickInterval3Default,
+			sizeof(*pTickInterval3Default),
+			false // Not written.
+		},
+		{
+			"a tick interval (#3)",
+			pTickInterval3,
+			sizeof(*pTickInterval3),
+			true
+		},
+		{
+			"ticks per second",
+			pTicksPerSecond,
+			sizeof(*pTicksPerSecond),
+			true
+		},
+	};
+
+	m_aTickPatches.Clear();
+
+	for(const auto &aTarget : aTargets)
+	{
+		if(!aTarget.pTarget)
+		{
+			if(error && maxlen)
+			{
+				snprintf(error, maxlen, "Failed to get %s", aTarget.pszName);
+			}
+
+			return false;
+		}
+
+		if(aTarget.bPatch && m_aTickPatches.Add(aTarget.pTarget, aTarget.nSize) == -1)
+		{
+			if(error && maxlen)
+			{
+				snprintf(error, maxlen, "Failed to get a page protection of %s", aTarget.pszName);
+			}
 
-	return true;
-}
+			m_aTickPatches.Clear();
 
-bool TickratePlugin::UnregisterGameFactory(char *error, size_t maxlen)
-{
-	if(m_pFactory)
-	{
-		m_pFactory->Shutdown();
-		m_pFactory->DestroyGameSystem(this);
+			return false;
+		}
 	}
 
-	if(!UnregisterFirstGameSystem())
+	RegisterOperandPatches();
+
+	// Not armed until the first change: nothing to keep before.
+	m_aTickWatchdog.Clear();
+	m_aTickWatchdog.Add(pTickInterval, sizeof(*pTickInterval));
+	m_aTickWatchdog.Add(pTickInterval2, sizeof(*pTickInterval2));
+	m_aTickWatchdog.Add(pTickInterval3, sizeof(*pTickInterval3));
+	m_aTickWatchdog.Add(pTicksPerSecond, sizeof(*pTicksPerSecond));
+
+	if(!RegisterHostFrame(GetGameDataStorage().GetHostFrame().GetPointer()))
 	{
 		if(error && maxlen)
 		{
-			strncpy(error, "Failed to unregister a first game factory", maxlen);
+			strncpy(error, "Failed to register a game event manager", maxlen);
 		}
 
 		return false;
@@ -1088,25 +3231,24 @@ bool TickratePlugin::UnregisterGameFactory(char *error, size_t maxlen)
 	return true;
 }
 
-bool TickratePlugin::RegisterSource2Server(char *error, size_t maxlen)
+bool TickratePlugin::UnregisterTick(char *error, size_t maxlen)
 {
-	IGameEventManager2 **ppGameEventManager = GetGameEventManagerPointer();
+	m_aTickWatchdog.Clear();
 
-	if(!ppGameEventManager)
+	// Exactly the bytes before the first change.
+	if(!m_aTickPatches.Restore())
 	{
-		if(error && maxlen)
-		{
-			strncpy(error, "Failed to get a game event manager", maxlen);
-		}
-
-		return false;
+		Logger::Warning("Failed to restore the tick intervals\n");
 	}
 
-	if(!RegisterGameEventManager(*ppGameEventManager))
+	m_vecOperandPatches.clear();
+	m_aTickPatches.Clear(); // With the redirected constants.
+
+	if(!UnregisterHostFrame())
 	{
 		if(error && maxlen)
 		{
-			strncpy(error, "Failed to register a game event manager", maxlen);
+			strncpy(error, "Failed to unregister a host frame", maxlen);
 		}
 
 		return false;
@@ -1115,199 +3257,163 @@ bool TickratePlugin::RegisterSource2Server(char *error, size_t maxlen)
 	return true;
 }
 
-bool TickratePlugin::UnregisterSource2Server(char *error, size_t maxlen)
+int TickratePlugin::RegisterOperandPatches()
 {
-	if(!UnregisterGameEventManager())
+	m_vecOperandPatches.clear();
+
+	for(const auto &aOperand : GetGameDataStorage().GetPatches().GetOperands())
 	{
-		if(error && maxlen)
+		const char *pszName = aOperand.m_sName.Get();
+
+		if(!aOperand.m_pInstruction)
 		{
-			strncpy(error, "Failed to register a game event manager", maxlen);
+			WarningFormat("Skip the \"%s\" operand patch: %s\n", pszName, "the instruction is not found");
+
+			continue;
 		}
 
-		return false;
-	}
+		size_t nSize = CPatches::GetTypeSize(aOperand.m_eType);
 
-	return true;
-}
+		uint8_t *pOperand = aOperand.m_pInstruction + aOperand.m_iOffset, 
+		        *pNext = aOperand.m_pInstruction + aOperand.m_iInstructionSize, 
+		        *pValue = pOperand;
 
-bool TickratePlugin::RegisterTick(char *error, size_t maxlen)
-{
-	// A tick interval.
-	{
-		float *pTickInterval = GetTickIntervalPointer();
+		// Of a repaired signature, the offset could be out of the code.
+		const auto *pSegment = FindLibrarySegment(pOperand, aOperand.m_eKind == CPatches::KIND_RIP_RELATIVE ? sizeof(int32_t) : nSize);
 
-		if(!pTickInterval)
+		if(!pSegment || !pSegment->m_bExecutable)
 		{
-			if(error && maxlen)
-			{
-				strncpy(error, "Failed to get a tick interval", maxlen);
-			}
+			WarningFormat("Skip the \"%s\" operand patch: %s\n", pszName, "the operand is out of the code");
 
-			return false;
+			continue;
 		}
 
-		if(SourceHook::GetPageBits(pTickInterval, &m_iTickIntervalPageBits))
+		if(aOperand.m_eKind == CPatches::KIND_RIP_RELATIVE)
 		{
-			SourceHook::SetMemAccess(pTickInterval, sizeof(pTickInterval), m_iTickIntervalPageBits | SH_MEM_WRITE);
-		}
-	}
+			int32_t iDisplacement;
 
-	// A double tick interval.
-	{
-		double *pTickInterval2 = GetTickInterval2Pointer();
+			memcpy(&iDisplacement, pOperand, sizeof(iDisplacement));
+			pValue = pNext + iDisplacement;
 
-		if(!pTickInterval2)
-		{
-			if(error && maxlen)
+			if(!FindLibrarySegment(pValue, nSize))
 			{
-				strncpy(error, "Failed to get a tick interval (#2)", maxlen);
-			}
+				WarningFormat("Skip the \"%s\" operand patch: %s\n", pszName, "the value is out of the libraries");
 
-			return false;
+				continue;
+			}
 		}
 
-		if(SourceHook::GetPageBits(pTickInterval2, &m_iTickInterval2PageBits))
+		OperandPatch_t aPatch {aOperand, pValue, {}};
+
+		// Never write over an unknown value: the gamedata could be stale.
+		EncodeOperandValue(aPatch.m_aLast, aOperand.m_eType, aOperand.m_dblExpected);
+
+		if(memcmp(pValue, aPatch.m_aLast, nSize))
 		{
-			SourceHook::SetMemAccess(pTickInterval2, sizeof(pTickInterval2), m_iTickInterval2PageBits | SH_MEM_WRITE);
-		}
-	}
+			WarningFormat("Skip the \"%s\" operand patch: %s\n", pszName, "the value is not expected");
 
-	// A default triple tick interval.
-	{
-		float *pTickInterval3Default = GetTickInterval3DefaultPointer();
+			continue;
+		}
 
-		if(!pTickInterval3Default)
+		if(aOperand.m_eKind == CPatches::KIND_IMMEDIATE)
 		{
-			if(error && maxlen)
+			if(m_aTickPatches.Add(pOperand, nSize) == -1)
 			{
-				strncpy(error, "Failed to get a tick interval (#2)", maxlen);
+				WarningFormat("Skip the \"%s\" operand patch: %s\n", pszName, "failed to get a page protection");
+
+				continue;
 			}
 
-			return false;
-		}
+			m_vecOperandPatches.push_back(aPatch);
 
-		if(SourceHook::GetPageBits(pTickInterval3Default, &m_iTickInterval3DefaultPageBits))
-		{
-			SourceHook::SetMemAccess(pTickInterval3Default, sizeof(pTickInterval3Default), m_iTickInterval3DefaultPageBits | SH_MEM_WRITE);
+			continue;
 		}
-	}
 
-	// A triple tick interval.
-	{
-		float *pTickInterval3 = GetTickInterval3Pointer();
+		// The constant may be shared with other instructions, so redirect this one to an own.
+		auto *pConstant = reinterpret_cast<uint8_t *>(m_aTickPatches.AllocateNear(pNext, nSize));
 
-		if(!pTickInterval3)
+		if(!pConstant)
 		{
-			if(error && maxlen)
-			{
-				strncpy(error, "Failed to get a tick interval (#2)", maxlen);
-			}
+			WarningFormat("Skip the \"%s\" operand patch: %s\n", pszName, "failed to allocate a constant near the instruction");
 
-			return false;
+			continue;
 		}
 
-		if(SourceHook::GetPageBits(pTickInterval3, &m_iTickInterval3PageBits))
-		{
-			SourceHook::SetMemAccess(pTickInterval3, sizeof(pTickInterval3), m_iTickInterval3PageBits | SH_MEM_WRITE);
-		}
-	}
+		memcpy(pConstant, pValue, nSize);
 
-	// Ticks per second.
-	{
-		float *pTicksPerSecond = GetTicksPerSecondPointer();
+		int32_t iDisplacement = (int32_t)(pConstant - pNext);
 
-		if(!pTicksPerSecond)
+		if(m_aTickPatches.Add(pOperand, sizeof(iDisplacement)) == -1 || !m_aTickPatches.Open())
 		{
-			if(error && maxlen)
-			{
-				strncpy(error, "Failed to get ticks per second", maxlen);
-			}
+			WarningFormat("Skip the \"%s\" operand patch: %s\n", pszName, "failed to get a page protection");
 
-			return false;
+			continue;
 		}
 
-		if(SourceHook::GetPageBits(pTicksPerSecond, &m_iTicksPerSecondPageBits))
-		{
-			SourceHook::SetMemAccess(pTicksPerSecond, sizeof(pTicksPerSecond), m_iTicksPerSecondPageBits | SH_MEM_WRITE);
-		}
+		memcpy(pOperand, &iDisplacement, sizeof(iDisplacement));
+		m_aTickPatches.Close();
+
+		aPatch.m_pValue = pConstant;
+		m_vecOperandPatches.push_back(aPatch);
 	}
 
-	if(!RegisterHostFrame(GetGameDataStorage().GetHostFrame().GetPointer()))
+	if(IsChannelEnabled(LS_DETAILED))
 	{
-		if(error && maxlen)
-		{
-			strncpy(error, "Failed to register a game event manager", maxlen);
-		}
-
-		return false;
+		Logger::DetailedFormat("Registered %d of %d operand patches\n", (int)m_vecOperandPatches.size(), GetGameDataStorage().GetPatches().GetOperands().Count());
 	}
 
-	return true;
+	return (int)m_vecOperandPatches.size();
 }
 
-bool TickratePlugin::UnregisterTick(char *error, size_t maxlen)
+void TickratePlugin::ChangeOperandPatches(const CChangedData &aData)
 {
-	// A tick interval.
+	for(auto &aPatch : m_vecOperandPatches)
 	{
-		float *pTickInterval = GetTickIntervalPointer();
-
-		if(pTickInterval)
-		{
-			SourceHook::SetMemAccess(pTickInterval, sizeof(pTickInterval), m_iTickIntervalPageBits);
-		}
-	}
+		const auto *pOperand = &aPatch.m_aOperand;
 
-	// A double tick interval.
-	{
-		double *pTickInterval2 = GetTickInterval2Pointer();
+		size_t nSize = CPatches::GetTypeSize(pOperand->m_eType);
 
-		if(pTickInterval2)
+		if(memcmp(aPatch.m_pValue, aPatch.m_aLast, nSize))
 		{
-			SourceHook::SetMemAccess(pTickInterval2, sizeof(pTickInterval2), m_iTickInterval2PageBits);
+			WarningFormat("Skip the \"%s\" operand patch: %s\n", pOperand->m_sName.Get(), "the value has been changed outside");
+
+			continue;
 		}
+
+		EncodeOperandValue(aPatch.m_aLast, pOperand->m_eType, pOperand->m_eValue == CPatches::VALUE_TICKS_PER_SECOND ? (double)aData.GetNewTicksPerSecond() : (double)aData.GetNewInterval());
+		memcpy(aPatch.m_pValue, aPatch.m_aLast, nSize);
 	}
+}
 
-	// A default triple tick interval.
+void TickratePlugin::EncodeOperandValue(uint8_t *pOutput, CPatches::Type_t eType, double dblValue)
+{
+	switch(eType)
 	{
-		float *pTickInterval3Default = GetTickInterval3Pointer();
-
-		if(pTickInterval3Default)
+		case CPatches::TYPE_FLOAT:
 		{
-			SourceHook::SetMemAccess(pTickInterval3Default, sizeof(pTickInterval3Default), m_iTickInterval3DefaultPageBits);
-		}
-	}
+			float flValue = (float)dblValue;
 
-	// A triple tick interval.
-	{
-		float *pTickInterval3 = GetTickInterval3Pointer();
+			memcpy(pOutput, &flValue, sizeof(flValue));
 
-		if(pTickInterval3)
-		{
-			SourceHook::SetMemAccess(pTickInterval3, sizeof(pTickInterval3), m_iTickInterval3PageBits);
+			break;
 		}
-	}
-
-	// Ticks per second.
-	{
-		float *pTicksPerSecond = GetTicksPerSecondPointer();
 
-		if(pTicksPerSecond)
+		case CPatches::TYPE_DOUBLE:
 		{
-			SourceHook::SetMemAccess(pTicksPerSecond, sizeof(pTicksPerSecond), m_iTicksPerSecondPageBits);
+			memcpy(pOutput, &dblValue, sizeof(dblValue));
+
+			break;
 		}
-	}
 
-	if(!UnregisterHostFrame())
-	{
-		if(error && maxlen)
+		case CPatches::TYPE_INT32:
 		{
-			strncpy(error, "Failed to unregister a host frame", maxlen);
-		}
+			int32_t iValue = (int32_t)(dblValue + (dblValue < 0.0 ? -0.5 : 0.5));
 
-		return false;
-	}
+			memcpy(pOutput, &iValue, sizeof(iValue));
 
-	return true;
+			break;
+		}
+	}
 }
 
 bool TickratePlugin::RegisterNetMessages(char *error, size_t maxlen)
@@ -1355,11 +3461,25 @@ bool TickratePlugin::RegisterNetMessages(char *error, size_t maxlen)
 		*aMessageInitializer.ppInternal = pMessage;
 	}
 
+	m_aSetConVarPool.Init(m_pSetConVarMessage);
+	m_aGetCvarValuePool.Init(m_pGetCvarValueMessage);
+	m_aSayText2Pool.Init(m_pSayText2Message);
+	m_aTextMsgPool.Init(m_pTextMsgMessage);
+
+	InvalidateHandshake();
+
 	return true;
 }
 
 bool TickratePlugin::UnregisterNetMessages(char *error, size_t maxlen)
 {
+	ClearHandshakeMessages();
+
+	m_aSetConVarPool.Destroy();
+	m_aGetCvarValuePool.Destroy();
+	m_aSayText2Pool.Destroy();
+	m_aTextMsgPool.Destroy();
+
 	m_pSayText2Message = NULL;
 
 	return true;
@@ -1547,10 +3667,71 @@ void TickratePlugin::OnReloadGameDataCommand(const CCommandContext &context, con
 {
 	char error[256];
 
+	// The hooked prologue doesn't match the signature.
+	bool bPacer = m_aSleepHook.IsInstalled();
+
+	UnregisterPacer();
+
 	if(!LoadProvider(error, sizeof(error)))
 	{
 		META_LOG(this, "%s", error);
 	}
+
+	if(bPacer && !RegisterPacer(error, sizeof(error)))
+	{
+		META_LOG(this, "%s", error);
+	}
+}
+
+void TickratePlugin::OnStatsCommand(const CCommandContext &context, const CCommand &args)
+{
+	const auto &aConcat = s_aEmbedConcat;
+
+	CBufferStringGrowable<1024> sMessage;
+
+	sMessage.Format("Tickrate %d stats:\n", Get());
+	DumpFrameStats(aConcat, sMessage);
+	sMessage.AppendFormat("Phases:\n");
+	DumpPhases(aConcat, sMessage);
+	sMessage.AppendFormat("Game systems:\n");
+	DumpSystemProfiler(aConcat, sMessage);
+	sMessage.AppendFormat("Governor:\n");
+	DumpGovernor(aConcat, sMessage);
+	sMessage.AppendFormat("Tiers:\n");
+	DumpTiers(aConcat, sMessage);
+	sMessage.AppendFormat("Hibernation:\n");
+	DumpHibernation(aConcat, sMessage);
+	sMessage.AppendFormat("Watchdog:\n");
+	DumpWatchdog(aConcat, sMessage);
+	sMessage.AppendFormat("Pacer:\n");
+	DumpPacer(aConcat, sMessage);
+	sMessage.AppendFormat("Main thread:\n");
+	DumpMainThread(aConcat, sMessage);
+	sMessage.AppendFormat("Host arbiter:\n");
+	DumpArbiter(aConcat, sMessage);
+
+	Logger::Message(sMessage);
+}
+
+void TickratePlugin::OnWritePhasesCommand(const CCommandContext &context, const CCommand &args)
+{
+	if(args.ArgC() < 2)
+	{
+		Logger::MessageFormat("Usage: %s <filename>\n", args.Arg(0));
+
+		return;
+	}
+
+	char error[256];
+
+	if(!WritePhases(args.Arg(1), error, sizeof(error)))
+	{
+		Logger::WarningFormat("%s\n", error);
+
+		return;
+	}
+
+	Logger::MessageFormat("Written %u phase records to \"%s\"\n", std::min<uint32_t>(m_aPhaseRecorder.GetRecordCount(), TICKRATE_PHASE_RECORDER_RECORD_COUNT), args.Arg(1));
 }
 
 void TickratePlugin::OnDispatchConCommandHook(ConCommandHandle hCommand, const CCommandContext &aContext, const CCommand &aArgs)
@@ -1692,6 +3873,62 @@ void TickratePlugin::OnDisconectClientHook(ENetworkDisconnectionReason eReason)
 	RETURN_META(MRES_IGNORED);
 }
 
+void TickratePlugin::OnServerPreEntityThinkPreHook(const EventServerPreEntityThink_t &msg)
+{
+	BeginSystemEvent(META_IFACEPTR(IGameSystem));
+
+	RETURN_META(MRES_IGNORED);
+}
+
+void TickratePlugin::OnServerPreEntityThinkPostHook(const EventServerPreEntityThink_t &msg)
+{
+	EndSystemEvent(META_IFACEPTR(IGameSystem));
+
+	RETURN_META(MRES_IGNORED);
+}
+
+void TickratePlugin::OnServerPostEntityThinkPreHook(const EventServerPostEntityThink_t &msg)
+{
+	BeginSystemEvent(META_IFACEPTR(IGameSystem));
+
+	RETURN_META(MRES_IGNORED);
+}
+
+void TickratePlugin::OnServerPostEntityThinkPostHook(const EventServerPostEntityThink_t &msg)
+{
+	EndSystemEvent(META_IFACEPTR(IGameSystem));
+
+	RETURN_META(MRES_IGNORED);
+}
+
+void TickratePlugin::OnServerGamePostSimulatePreHook(const EventServerGamePostSimulate_t &msg)
+{
+	BeginSystemEvent(META_IFACEPTR(IGameSystem));
+
+	RETURN_META(MRES_IGNORED);
+}
+
+void TickratePlugin::OnServerGamePostSimulatePostHook(const EventServerGamePostSimulate_t &msg)
+{
+	EndSystemEvent(META_IFACEPTR(IGameSystem));
+
+	RETURN_META(MRES_IGNORED);
+}
+
+void TickratePlugin::OnServerPreClientUpdatePreHook(const EventServerPreClientUpdate_t &msg)
+{
+	BeginSystemEvent(META_IFACEPTR(IGameSystem));
+
+	RETURN_META(MRES_IGNORED);
+}
+
+void TickratePlugin::OnServerPreClientUpdatePostHook(const EventServerPreClientUpdate_t &msg)
+{
+	EndSystemEvent(META_IFACEPTR(IGameSystem));
+
+	RETURN_META(MRES_IGNORED);
+}
+
 void TickratePlugin::DumpProtobufMessage(const ConcatLineString &aConcat, CBufferString &sOutput, const google::protobuf::Message &aMessage)
 {
 	CBufferStringGrowable<1024> sProtoOutput;
@@ -1802,7 +4039,14 @@ void TickratePlugin::DumpDisconnectReason(const ConcatLineString &aConcat, CBuff
 
 void TickratePlugin::SendSetConVar(IRecipientFilter *pFilter, const CUtlVector<CVar_t> &vecCVars)
 {
-	auto *pSetConVarMessage = m_pSetConVarMessage;
+	auto &aSetConVarPool = m_aSetConVarPool;
+
+	auto *pSetConVarMessage = aSetConVarPool.GetMessage();
+
+	if(!pSetConVarMessage)
+	{
+		return; // Not registered yet.
+	}
 
 	if(IsChannelEnabled(LV_DETAILED))
 	{
@@ -1820,7 +4064,7 @@ void TickratePlugin::SendSetConVar(IRecipientFilter *pFilter, const CUtlVector<C
 		Logger::Detailed(sBuffer);
 	}
 
-	auto *pMessage = pSetConVarMessage->AllocateMessage()->ToPB<CNETMsg_SetConVar>();
+	auto *pMessage = aSetConVarPool.Acquire();
 
 	for(const auto &aCVar : vecCVars)
 	{
@@ -1832,12 +4076,19 @@ void TickratePlugin::SendSetConVar(IRecipientFilter *pFilter, const CUtlVector<C
 
 	g_pGameEventSystem->PostEventAbstract(-1, false, pFilter, pSetConVarMessage, pMessage, 0);
 
-	delete pMessage;
+	aSetConVarPool.Release(pMessage);
 }
 
 void TickratePlugin::SendCvarValueQuery(IRecipientFilter *pFilter, const char *pszName, int iCookie)
 {
-	auto *pGetCvarValueMessage = m_pGetCvarValueMessage;
+	auto &aGetCvarValuePool = m_aGetCvarValuePool;
+
+	auto *pGetCvarValueMessage = aGetCvarValuePool.GetMessage();
+
+	if(!pGetCvarValueMessage)
+	{
+		return; // Not registered yet.
+	}
 
 	if(IsChannelEnabled(LV_DETAILED))
 	{
@@ -1852,19 +4103,26 @@ void TickratePlugin::SendCvarValueQuery(IRecipientFilter *pFilter, const char *p
 		Logger::Detailed(sBuffer);
 	}
 
-	auto *pMessage = pGetCvarValueMessage->AllocateMessage()->ToPB<CSVCMsg_GetCvarValue>();
+	auto *pMessage = aGetCvarValuePool.Acquire();
 
 	pMessage->set_cvar_name(pszName);
 	pMessage->set_cookie(iCookie);
 
 	g_pGameEventSystem->PostEventAbstract(-1, false, pFilter, pGetCvarValueMessage, pMessage, 0);
 
-	delete pMessage;
+	aGetCvarValuePool.Release(pMessage);
 }
 
 void TickratePlugin::SendChatMessage(IRecipientFilter *pFilter, int iEntityIndex, bool bIsChat, const char *pszChatMessageFormat, const char *pszParam1, const char *pszParam2, const char *pszParam3, const char *pszParam4)
 {
-	auto *pSayText2Message = m_pSayText2Message;
+	auto &aSayText2Pool = m_aSayText2Pool;
+
+	auto *pSayText2Message = aSayText2Pool.GetMessage();
+
+	if(!pSayText2Message)
+	{
+		return; // Not registered yet.
+	}
 
 	if(IsChannelEnabled(LV_DETAILED))
 	{
@@ -1900,7 +4158,7 @@ void TickratePlugin::SendChatMessage(IRecipientFilter *pFilter, int iEntityIndex
 		Logger::Detailed(sBuffer);
 	}
 
-	auto *pMessage = pSayText2Message->AllocateMessage()->ToPB<CUserMessageSayText2>();
+	auto *pMessage = aSayText2Pool.Acquire();
 
 	pMessage->set_entityindex(iEntityIndex);
 	pMessage->set_chat(bIsChat);
@@ -1912,12 +4170,19 @@ void TickratePlugin::SendChatMessage(IRecipientFilter *pFilter, int iEntityIndex
 
 	g_pGameEventSystem->PostEventAbstract(-1, false, pFilter, pSayText2Message, pMessage, 0);
 
-	delete pMessage;
+	aSayText2Pool.Release(pMessage);
 }
 
 void TickratePlugin::SendTextMessage(IRecipientFilter *pFilter, int iDestination, size_t nParamCount, const char *pszParam, ...)
 {
-	auto *pTextMsg = m_pTextMsgMessage;
+	auto &aTextMsgPool = m_aTextMsgPool;
+
+	auto *pTextMsg = aTextMsgPool.GetMessage();
+
+	if(!pTextMsg)
+	{
+		return; // Not registered yet.
+	}
 
 	if(IsChannelEnabled(LV_DETAILED))
 	{
@@ -1931,7 +4196,7 @@ void TickratePlugin::SendTextMessage(IRecipientFilter *pFilter, int iDestination
 		Logger::Detailed(sBuffer);
 	}
 
-	auto *pMessage = pTextMsg->AllocateMessage()->ToPB<CUserMessageTextMsg>();
+	auto *pMessage = aTextMsgPool.Acquire();
 
 	pMessage->set_dest(iDestination);
 	pMessage->add_param(pszParam);
@@ -1954,11 +4219,13 @@ void TickratePlugin::SendTextMessage(IRecipientFilter *pFilter, int iDestination
 
 	g_pGameEventSystem->PostEventAbstract(-1, false, pFilter, pTextMsg, pMessage, 0);
 
-	delete pMessage;
+	aTextMsgPool.Release(pMessage);
 }
 
 void TickratePlugin::OnStartupServer(CNetworkGameServerBase *pNetServer, const GameSessionConfiguration_t &config, ISource2WorldSession *pWorldSession)
 {
+	m_nHumans = CountHumans(pNetServer); // Of the ones kept through a map change.
+
 	SH_ADD_HOOK_MEMFUNC(CNetworkGameServerBase, FillServerInfo, pNetServer, this, &TickratePlugin::OnFillServerInfoHook, true);
 	SH_ADD_HOOK_MEMFUNC(CNetworkGameServerBase, ConnectClient, pNetServer, this, &TickratePlugin::OnConnectClientHook, true);
 
@@ -1978,6 +4245,9 @@ void TickratePlugin::OnStartupServer(CNetworkGameServerBase *pNetServer, const G
 		}
 	}
 
+	// Before the first server info, after the messages to notify the humans of a late load.
+	ApplyMapProfile(pNetServer, config);
+
 	auto *pGlobals = pNetServer->GetGlobals();
 
 	if(IsChannelEnabled(LS_DETAILED))
@@ -2038,7 +4308,7 @@ void TickratePlugin::OnFillServerInfo(CNetworkGameServerBase *pNetServer, CSVCMs
 		Logger::Detailed(sMessage);
 	}
 
-	pMessage->set_tick_interval(1.0f / (float)Get());
+	pMessage->set_tick_interval(1.0f / (float)GetTarget());
 }
 
 void TickratePlugin::OnConnectClient(CNetworkGameServerBase *pNetServer, CServerSideClientBase *pClient, const char *pszName, ns_address *pAddr, int socket, CCLCMsg_SplitPlayerConnect_t *pSplitPlayer, const char *pszChallenge, const byte *pAuthTicket, int nAuthTicketLength, bool bIsLowViolence)
@@ -2080,51 +4350,22 @@ void TickratePlugin::OnConnectClient(CNetworkGameServerBase *pNetServer, CServer
 		return;
 	}
 
-	auto aPlayerSlot = pClient->GetPlayerSlot();
-
-	CSingleRecipientFilter aFilter(aPlayerSlot);
-
-	// Replicate "sv_to_cl_clock_correction" to client's "cl_clock_correction"
+	// Staged before the server info is filled, so the client gets the restored tick interval.
+	if(!pClient->IsFakeClient())
 	{
-		char sClockCorrectionValue[8];
-
-		CUtlVector<CVar_t> vecConVars;
-
-		m_aSVToClientClockCorrection.GetStringValue(sClockCorrectionValue, sizeof(sClockCorrectionValue));
-		vecConVars.AddToTail({TICKRATE_CLIENT_CVAR_NAME_CLOCK_CORRECTION, sClockCorrectionValue});
-		SendSetConVar(&aFilter, vecConVars);
+		m_nHumans++;
+		m_dblNoHumansSince = 0.0;
+		WakeUp();
 	}
 
-	pClient->SetUpdateRate((float)(Get()));
-
-	// Get "cl_language" cvar value from a client.
-	{
-
-		const char *pszCvarName = TICKRATE_CLIENT_CVAR_NAME_LANGUAGE;
-
-		int iCookie {};
-
-		{
-			auto sConVarSymbol = GetConVarSymbol(pszCvarName);
-
-			auto iFound = m_mapConVarCookies.Find(sConVarSymbol);
+	auto aPlayerSlot = pClient->GetPlayerSlot();
 
-			if(m_mapConVarCookies.IsValidIndex(iFound))
-			{
-				auto &iFoundCookie = m_mapConVarCookies.Element(iFound);
+	CSingleRecipientFilter aFilter(aPlayerSlot);
 
-				iFoundCookie++;
-				iCookie = iFoundCookie;
-			}
-			else
-			{
-				iCookie = 0;
-				m_mapConVarCookies.Insert(sConVarSymbol, iCookie);
-			}
-		}
+	// Replicate cvars to the client and query its ones (at least "cl_language").
+	SendHandshake(&aFilter);
 
-		SendCvarValueQuery(&aFilter, pszCvarName, iCookie);
-	}
+	pClient->SetUpdateRate((float)GetTarget());
 }
 
 bool TickratePlugin::OnProcessRespondCvarValue(CServerSideClientBase *pClient, const CCLCMsg_RespondCvarValue_t &aMessage)
@@ -2150,6 +4391,16 @@ bool TickratePlugin::OnProcessRespondCvarValue(CServerSideClientBase *pClient, c
 		return false;
 	}
 
+	if(sFoundSymbol != FindConVarSymbol(TICKRATE_CLIENT_CVAR_NAME_LANGUAGE))
+	{
+		if(IsChannelEnabled(LS_DETAILED))
+		{
+			Logger::DetailedFormat("Received \"%s\" cvar value: \"%s\"\n", aMessage.name().c_str(), aMessage.value().c_str());
+		}
+
+		return true;
+	}
+
 	auto iLanguageFound = m_mapLanguages.Find(FindLanguageSymbol(aMessage.value().c_str()));
 
 	if(!m_mapLanguages.IsValidIndex(iLanguageFound))
@@ -2195,6 +4446,11 @@ void TickratePlugin::OnDisconectClient(CServerSideClientBase *pClient, ENetworkD
 	SH_REMOVE_HOOK_MEMFUNC(CServerSideClientBase, ProcessRespondCvarValue, pClient, this, &TickratePlugin::OnProcessRespondCvarValueHook, false);
 	SH_REMOVE_HOOK_MEMFUNC(CServerSideClientBase, PerformDisconnection, pClient, this, &TickratePlugin::OnDisconectClientHook, false);
 
+	if(!pClient->IsFakeClient() && m_nHumans > 0)
+	{
+		m_nHumans--;
+	}
+
 	if(IsChannelEnabled(LS_DETAILED))
 	{
 		CBufferStringGrowable<1024> sMessage;
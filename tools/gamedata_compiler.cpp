@@ -0,0 +1,747 @@
+/**
+ * vim: set ts=4 sw=4 tw=99 noet :
+ * ======================================================
+ * Metamod:Source Tickrate
+ * Written by Wend4r (Vladimir Ezhikov).
+ * ======================================================
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Compiles "*.games.json" of a platform into a gamedata blob.
+// Usage: tickrate_gamedata_compiler <gamedata dir> <platform, e.g. linuxsteamrt64> <output, e.g. gamedata.linuxsteamrt64.bin>
+
+#include <tickrate/gamedata_blob.hpp>
+#include <tickrate/signature_scanner.hpp>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+	using Blob = Tickrate::GameDataBlob;
+
+	const char *s_pszPlatforms[] =
+	{
+		"win64",
+		"linuxsteamrt64",
+	};
+
+	struct Value_t
+	{
+		uint32_t m_nType = Blob::NODE_NULL;
+
+		bool m_bBool = false;
+		int64_t m_nInt = 0;
+		double m_dblDouble = 0.0;
+		std::string m_sString;
+
+		std::vector<std::pair<std::string, Value_t>> m_vecChildren; // Names are empty for array elements.
+	};
+
+	class Parser
+	{
+	public:
+		Parser(const std::string &sText)
+		 :  m_sText(sText),
+		    m_nPosition(0)
+		{
+		}
+
+		bool Parse(Value_t &aOutput, std::string &sError)
+		{
+			if(!ParseValue(aOutput) || (SkipSpaces(), m_nPosition != m_sText.size()))
+			{
+				sError = "Syntax error at " + std::to_string(m_nPosition);
+
+				return false;
+			}
+
+			return true;
+		}
+
+	protected:
+		void SkipSpaces()
+		{
+			while(m_nPosition < m_sText.size())
+			{
+				char c = m_sText[m_nPosition];
+
+				if(c == ' ' || c == '\t' || c == '\r' || c == '\n')
+				{
+					m_nPosition++;
+				}
+				else if(!m_sText.compare(m_nPosition, 2, "//"))
+				{
+					m_nPosition = std::min(m_sText.find('\n', m_nPosition), m_sText.size());
+				}
+				else
+				{
+					break;
+				}
+			}
+		}
+
+		bool Expect(char c)
+		{
+			SkipSpaces();
+
+			if(m_nPosition < m_sText.size() && m_sText[m_nPosition] == c)
+			{
+				m_nPosition++;
+
+				return true;
+			}
+
+			return false;
+		}
+
+		bool ParseString(std::string &sOutput)
+		{
+			if(!Expect('"'))
+			{
+				return false;
+			}
+
+			while(m_nPosition < m_sText.size())
+			{
+				char c = m_sText[m_nPosition++];
+
+				if(c == '"')
+				{
+					return true;
+				}
+
+				if(c != '\\')
+				{
+					sOutput += c;
+
+					continue;
+				}
+
+				if(m_nPosition >= m_sText.size())
+				{
+					return false;
+				}
+
+				switch(c = m_sText[m_nPosition++])
+				{
+					case 'n': sOutput += '\n'; break;
+					case 't': sOutput += '\t'; break;
+					case 'r': sOutput += '\r'; break;
+					case 'b': sOutput += '\b'; break;
+					case 'f': sOutput += '\f'; break;
+					case 'u':
+					{
+						if(m_nPosition + 4 > m_sText.size())
+						{
+							return false;
+						}
+
+						unsigned long nCode = strtoul(m_sText.substr(m_nPosition, 4).c_str(), nullptr, 16);
+
+						m_nPosition += 4;
+
+						// No surrogates in gamedata, encode a BMP code point.
+						if(nCode < 0x80)
+						{
+							sOutput += (char)nCode;
+						}
+						else if(nCode < 0x800)
+						{
+							sOutput += (char)(0xC0 | (nCode >> 6));
+							sOutput += (char)(0x80 | (nCode & 0x3F));
+						}
+						else
+						{
+							sOutput += (char)(0xE0 | (nCode >> 12));
+							sOutput += (char)(0x80 | ((nCode >> 6) & 0x3F));
+							sOutput += (char)(0x80 | (nCode & 0x3F));
+						}
+
+						break;
+					}
+
+					default: sOutput += c; break;
+				}
+			}
+
+			return false;
+		}
+
+		bool ParseValue(Value_t &aOutput)
+		{
+			SkipSpaces();
+
+			if(m_nPosition >= m_sText.size())
+			{
+				return false;
+			}
+
+			char c = m_sText[m_nPosition];
+
+			if(c == '{' || c == '[')
+			{
+				bool bTable = c == '{';
+
+				char cClose = bTable ? '}' : ']';
+
+				m_nPosition++;
+				aOutput.m_nType = bTable ? Blob::NODE_TABLE : Blob::NODE_ARRAY;
+
+				if(Expect(cClose))
+				{
+					return true;
+				}
+
+				do
+				{
+					std::pair<std::string, Value_t> aChild;
+
+					if(bTable && (!ParseString(aChild.first) || !Expect(':')))
+					{
+						return false;
+					}
+
+					if(!ParseValue(aChild.second))
+					{
+						return false;
+					}
+
+					aOutput.m_vecChildren.push_back(std::move(aChild));
+				}
+				while(Expect(','));
+
+				return Expect(cClose);
+			}
+
+			if(c == '"')
+			{
+				aOutput.m_nType = Blob::NODE_STRING;
+
+				return ParseString(aOutput.m_sString);
+			}
+
+			const struct
+			{
+				const char *pszWord;
+				uint32_t nType;
+				bool bValue;
+			} aWords[] =
+			{
+				{"true", Blob::NODE_BOOL, true},
+				{"false", Blob::NODE_BOOL, false},
+				{"null", Blob::NODE_NULL, false},
+			};
+
+			for(const auto &aWord : aWords)
+			{
+				size_t nLength = strlen(aWord.pszWord);
+
+				if(!m_sText.compare(m_nPosition, nLength, aWord.pszWord))
+				{
+					m_nPosition += nLength;
+					aOutput.m_nType = aWord.nType;
+					aOutput.m_bBool = aWord.bValue;
+
+					return true;
+				}
+			}
+
+			const char *pszStart = m_sText.c_str() + m_nPosition;
+
+			char *pszEnd = nullptr;
+
+			if(strcspn(pszStart, ".eE,}] \t\r\n") < strcspn(pszStart, ".eE"))
+			{
+				aOutput.m_nType = Blob::NODE_INT;
+				aOutput.m_nInt = strtoll(pszStart, &pszEnd, 10);
+			}
+			else
+			{
+				aOutput.m_nType = Blob::NODE_DOUBLE;
+				aOutput.m_dblDouble = strtod(pszStart, &pszEnd);
+			}
+
+			if(pszEnd == pszStart)
+			{
+				return false;
+			}
+
+			m_nPosition += pszEnd - pszStart;
+
+			return true;
+		}
+
+	private:
+		const std::string &m_sText;
+		size_t m_nPosition;
+	}; // Parser
+
+	class Writer
+	{
+	public:
+		Writer()
+		{
+			Intern(""); // The empty string is at zero.
+		}
+
+		uint32_t Intern(const std::string &sText)
+		{
+			auto it = m_mapStrings.find(sText);
+
+			if(it != m_mapStrings.end())
+			{
+				return it->second;
+			}
+
+			uint32_t nOffset = (uint32_t)m_vecStrings.size();
+
+			m_vecStrings.insert(m_vecStrings.end(), sText.begin(), sText.end());
+			m_vecStrings.push_back('\0');
+			m_mapStrings.emplace(sText, nOffset);
+
+			return nOffset;
+		}
+
+		// Strips the schema and keys of other platforms.
+		static void Strip(Value_t &aValue, const char *pszPlatform)
+		{
+			auto &vecChildren = aValue.m_vecChildren;
+
+			if(aValue.m_nType == Blob::NODE_TABLE)
+			{
+				vecChildren.erase(std::remove_if(vecChildren.begin(), vecChildren.end(), [pszPlatform](const auto &aChild)
+				{
+					if(aChild.first == "$schema")
+					{
+						return true;
+					}
+
+					for(const char *pszOther : s_pszPlatforms)
+					{
+						if(aChild.first == pszOther && strcmp(pszOther, pszPlatform))
+						{
+							return true;
+						}
+					}
+
+					return false;
+				}), vecChildren.end());
+			}
+
+			for(auto &aChild : vecChildren)
+			{
+				Strip(aChild.second, pszPlatform);
+			}
+		}
+
+		// Breadth-first, so the children of a node are contiguous.
+		uint32_t AddTree(const Value_t &aRoot)
+		{
+			uint32_t nRoot = (uint32_t)m_vecNodes.size();
+
+			std::vector<std::pair<const Value_t *, uint32_t>> vecQueue = {{&aRoot, nRoot}};
+
+			m_vecNodes.push_back(MakeNode(aRoot, TICKRATE_GAMEDATA_BLOB_INVALID_INDEX));
+
+			for(size_t n = 0; n < vecQueue.size(); n++)
+			{
+				const Value_t *pValue = vecQueue[n].first;
+
+				uint32_t nIndex = vecQueue[n].second;
+
+				if(pValue->m_nType != Blob::NODE_TABLE && pValue->m_nType != Blob::NODE_ARRAY)
+				{
+					continue;
+				}
+
+				m_vecNodes[nIndex].m_nFirst = (uint32_t)m_vecNodes.size();
+				m_vecNodes[nIndex].m_nCount = (uint32_t)pValue->m_vecChildren.size();
+
+				for(const auto &aChild : pValue->m_vecChildren)
+				{
+					uint32_t nName = pValue->m_nType == Blob::NODE_TABLE ? Intern(aChild.first) : TICKRATE_GAMEDATA_BLOB_INVALID_INDEX;
+
+					vecQueue.push_back({&aChild.second, (uint32_t)m_vecNodes.size()});
+					m_vecNodes.push_back(MakeNode(aChild.second, nName));
+				}
+			}
+
+			return nRoot;
+		}
+
+		// Indexes the members of a stripped tree, a source with others (unknown sections, chains of actions) is left to the tree.
+		bool AddIndex(const Value_t &aRoot, const char *pszPlatform, Blob::Source_t &aSource)
+		{
+			std::vector<Blob::Signature_t> vecSignatures;
+			std::vector<Blob::Address_t> vecAddresses;
+			std::vector<Blob::Offset_t> vecOffsets;
+			std::vector<Blob::Prologue_t> vecPrologues;
+			std::vector<uint8_t> vecBytes;
+
+			auto funcFind = [](const Value_t &aValue, const char *pszName) -> const Value_t *
+			{
+				for(const auto &aChild : aValue.m_vecChildren)
+				{
+					if(aChild.first == pszName)
+					{
+						return &aChild.second;
+					}
+				}
+
+				return nullptr;
+			};
+
+			// Appends the bytes, then the mask.
+			auto funcAddPattern = [this, &vecBytes](const Value_t &aValue, uint32_t &nLength) -> bool
+			{
+				Tickrate::SignatureScanner::Pattern_t aPattern;
+
+				if(aValue.m_nType != Blob::NODE_STRING || !Tickrate::SignatureScanner::Parse(aValue.m_sString.c_str(), aPattern))
+				{
+					return false;
+				}
+
+				nLength = (uint32_t)aPattern.m_vecBytes.size();
+				vecBytes.insert(vecBytes.end(), aPattern.m_vecBytes.begin(), aPattern.m_vecBytes.end());
+				vecBytes.insert(vecBytes.end(), aPattern.m_vecMask.begin(), aPattern.m_vecMask.end());
+
+				return true;
+			};
+
+			uint32_t nBytesBase = (uint32_t)m_vecBytes.size();
+
+			for(const auto &aGame : aRoot.m_vecChildren)
+			{
+				if(aGame.second.m_nType != Blob::NODE_TABLE)
+				{
+					return false;
+				}
+
+				for(const auto &aSection : aGame.second.m_vecChildren)
+				{
+					const std::string &sSection = aSection.first;
+
+					if(sSection != "Signatures" && sSection != "Addresses" && sSection != "Offsets" && sSection != "Prologues")
+					{
+						return false;
+					}
+
+					for(const auto &aMember : aSection.second.m_vecChildren)
+					{
+						const Value_t *pPlatform = funcFind(aMember.second, pszPlatform);
+
+						if(!pPlatform)
+						{
+							continue; // Of another platform.
+						}
+
+						uint32_t nName = Intern(aMember.first);
+
+						if(sSection == "Signatures")
+						{
+							const Value_t *pLibrary = funcFind(aMember.second, "library");
+
+							uint32_t nBytes = nBytesBase + (uint32_t)vecBytes.size(), nLength;
+
+							if(!pLibrary || pLibrary->m_nType != Blob::NODE_STRING || !funcAddPattern(*pPlatform, nLength))
+							{
+								return false;
+							}
+
+							vecSignatures.push_back({nName, Intern(pLibrary->m_sString), nBytes, nLength});
+						}
+						else if(sSection == "Addresses")
+						{
+							const Value_t *pSignature = funcFind(aMember.second, "signature");
+
+							if(!pSignature || pSignature->m_nType != Blob::NODE_STRING || pPlatform->m_nType != Blob::NODE_TABLE || pPlatform->m_vecChildren.size() != 1)
+							{
+								return false;
+							}
+
+							const auto &aAction = pPlatform->m_vecChildren[0];
+
+							uint32_t nAction;
+
+							if(aAction.first == "offset")
+							{
+								nAction = Blob::ADDRESS_OFFSET;
+							}
+							else if(aAction.first == "read_offs32")
+							{
+								nAction = Blob::ADDRESS_READ_OFFS32;
+							}
+							else
+							{
+								return false;
+							}
+
+							if(aAction.second.m_nType != Blob::NODE_INT || aAction.second.m_nInt != (int32_t)aAction.second.m_nInt)
+							{
+								return false;
+							}
+
+							vecAddresses.push_back({nName, Intern(pSignature->m_sString), nAction, (int32_t)aAction.second.m_nInt});
+						}
+						else if(sSection == "Offsets")
+						{
+							if(pPlatform->m_nType != Blob::NODE_INT || pPlatform->m_nInt != (int32_t)pPlatform->m_nInt)
+							{
+								return false;
+							}
+
+							vecOffsets.push_back({nName, (int32_t)pPlatform->m_nInt});
+						}
+						else // Prologues.
+						{
+							uint32_t nBytes = nBytesBase + (uint32_t)vecBytes.size(), nLength;
+
+							if(!funcAddPattern(*pPlatform, nLength))
+							{
+								return false;
+							}
+
+							vecPrologues.push_back({nName, nBytes, nLength});
+						}
+					}
+				}
+			}
+
+			aSource.m_nFlags |= Blob::SOURCE_INDEXED;
+			aSource.m_aSignatures = {(uint32_t)m_vecSignatures.size(), (uint32_t)vecSignatures.size()};
+			aSource.m_aAddresses = {(uint32_t)m_vecAddresses.size(), (uint32_t)vecAddresses.size()};
+			aSource.m_aOffsets = {(uint32_t)m_vecOffsets.size(), (uint32_t)vecOffsets.size()};
+			aSource.m_aPrologues = {(uint32_t)m_vecPrologues.size(), (uint32_t)vecPrologues.size()};
+
+			m_vecSignatures.insert(m_vecSignatures.end(), vecSignatures.begin(), vecSignatures.end());
+			m_vecAddresses.insert(m_vecAddresses.end(), vecAddresses.begin(), vecAddresses.end());
+			m_vecOffsets.insert(m_vecOffsets.end(), vecOffsets.begin(), vecOffsets.end());
+			m_vecPrologues.insert(m_vecPrologues.end(), vecPrologues.begin(), vecPrologues.end());
+			m_vecBytes.insert(m_vecBytes.end(), vecBytes.begin(), vecBytes.end());
+
+			return true;
+		}
+
+		void AddSource(const Blob::Source_t &aSource)
+		{
+			m_vecSources.push_back(aSource);
+		}
+
+		bool Write(const char *pszFilename, const char *pszPlatform) const
+		{
+			Blob::Header_t aHeader {};
+
+			aHeader.m_nMagic = TICKRATE_GAMEDATA_BLOB_MAGIC;
+			aHeader.m_nVersion = TICKRATE_GAMEDATA_BLOB_VERSION;
+			strncpy(aHeader.m_sPlatform, pszPlatform, sizeof(aHeader.m_sPlatform) - 1);
+
+			aHeader.m_nSourceCount = (uint32_t)m_vecSources.size();
+			aHeader.m_nSourcesOffset = (uint32_t)sizeof(aHeader);
+			aHeader.m_nNodeCount = (uint32_t)m_vecNodes.size();
+			aHeader.m_nNodesOffset = aHeader.m_nSourcesOffset + aHeader.m_nSourceCount * (uint32_t)sizeof(Blob::Source_t);
+			aHeader.m_nSignatureCount = (uint32_t)m_vecSignatures.size();
+			aHeader.m_nSignaturesOffset = aHeader.m_nNodesOffset + aHeader.m_nNodeCount * (uint32_t)sizeof(Blob::Node_t);
+			aHeader.m_nAddressCount = (uint32_t)m_vecAddresses.size();
+			aHeader.m_nAddressesOffset = aHeader.m_nSignaturesOffset + aHeader.m_nSignatureCount * (uint32_t)sizeof(Blob::Signature_t);
+			aHeader.m_nOffsetCount = (uint32_t)m_vecOffsets.size();
+			aHeader.m_nOffsetsOffset = aHeader.m_nAddressesOffset + aHeader.m_nAddressCount * (uint32_t)sizeof(Blob::Address_t);
+			aHeader.m_nPrologueCount = (uint32_t)m_vecPrologues.size();
+			aHeader.m_nProloguesOffset = aHeader.m_nOffsetsOffset + aHeader.m_nOffsetCount * (uint32_t)sizeof(Blob::Offset_t);
+			aHeader.m_nBytesOffset = aHeader.m_nProloguesOffset + aHeader.m_nPrologueCount * (uint32_t)sizeof(Blob::Prologue_t);
+			aHeader.m_nBytesSize = (uint32_t)m_vecBytes.size();
+			aHeader.m_nStringsOffset = aHeader.m_nBytesOffset + aHeader.m_nBytesSize;
+			aHeader.m_nStringsSize = (uint32_t)m_vecStrings.size();
+
+			FILE *pFile = fopen(pszFilename, "wb");
+
+			if(!pFile)
+			{
+				return false;
+			}
+
+			bool bResult = fwrite(&aHeader, sizeof(aHeader), 1, pFile) == 1 && 
+			               fwrite(m_vecSources.data(), sizeof(Blob::Source_t), m_vecSources.size(), pFile) == m_vecSources.size() && 
+			               fwrite(m_vecNodes.data(), sizeof(Blob::Node_t), m_vecNodes.size(), pFile) == m_vecNodes.size() && 
+			               fwrite(m_vecSignatures.data(), sizeof(Blob::Signature_t), m_vecSignatures.size(), pFile) == m_vecSignatures.size() && 
+			               fwrite(m_vecAddresses.data(), sizeof(Blob::Address_t), m_vecAddresses.size(), pFile) == m_vecAddresses.size() && 
+			               fwrite(m_vecOffsets.data(), sizeof(Blob::Offset_t), m_vecOffsets.size(), pFile) == m_vecOffsets.size() && 
+			               fwrite(m_vecPrologues.data(), sizeof(Blob::Prologue_t), m_vecPrologues.size(), pFile) == m_vecPrologues.size() && 
+			               fwrite(m_vecBytes.data(), 1, m_vecBytes.size(), pFile) == m_vecBytes.size() && 
+			               fwrite(m_vecStrings.data(), 1, m_vecStrings.size(), pFile) == m_vecStrings.size();
+
+			return !fclose(pFile) && bResult;
+		}
+
+	protected:
+		Blob::Node_t MakeNode(const Value_t &aValue, uint32_t nName)
+		{
+			Blob::Node_t aNode {};
+
+			aNode.m_nType = aValue.m_nType;
+			aNode.m_nName = nName;
+			aNode.m_nFirst = TICKRATE_GAMEDATA_BLOB_INVALID_INDEX;
+
+			switch(aValue.m_nType)
+			{
+				case Blob::NODE_BOOL: aNode.m_nInt = aValue.m_bBool; break;
+				case Blob::NODE_INT: aNode.m_nInt = aValue.m_nInt; break;
+				case Blob::NODE_DOUBLE: aNode.m_dblDouble = aValue.m_dblDouble; break;
+				case Blob::NODE_STRING: aNode.m_nFirst = Intern(aValue.m_sString); break;
+			}
+
+			return aNode;
+		}
+
+	private:
+		std::vector<Blob::Source_t> m_vecSources;
+		std::vector<Blob::Node_t> m_vecNodes;
+		std::vector<Blob::Signature_t> m_vecSignatures;
+		std::vector<Blob::Address_t> m_vecAddresses;
+		std::vector<Blob::Offset_t> m_vecOffsets;
+		std::vector<Blob::Prologue_t> m_vecPrologues;
+		std::vector<uint8_t> m_vecBytes;
+		std::vector<char> m_vecStrings;
+		std::unordered_map<std::string, uint32_t> m_mapStrings;
+	}; // Writer
+
+	bool ReadFile(const std::filesystem::path &aPath, std::string &sOutput)
+	{
+		FILE *pFile = fopen(aPath.string().c_str(), "rb");
+
+		if(!pFile)
+		{
+			return false;
+		}
+
+		char sBuffer[4096];
+
+		size_t nRead;
+
+		while((nRead = fread(sBuffer, 1, sizeof(sBuffer), pFile)) > 0)
+		{
+			sOutput.append(sBuffer, nRead);
+		}
+
+		bool bResult = !ferror(pFile);
+
+		fclose(pFile);
+
+		return bResult;
+	}
+}; // anonymous
+
+int main(int argc, char *argv[])
+{
+	if(argc != 4)
+	{
+		fprintf(stderr, "Usage: %s <gamedata dir> <platform> <output>\n", argv[0]);
+
+		return EXIT_FAILURE;
+	}
+
+	const char *pszPlatform = argv[2];
+
+	if(strlen(pszPlatform) >= TICKRATE_GAMEDATA_BLOB_PLATFORM_LENGTH)
+	{
+		fprintf(stderr, "Too long platform \"%s\"\n", pszPlatform);
+
+		return EXIT_FAILURE;
+	}
+
+	std::vector<std::filesystem::path> vecSources;
+
+	std::error_code aError;
+
+	for(const auto &aEntry : std::filesystem::directory_iterator(argv[1], aError))
+	{
+		const std::string sName = aEntry.path().filename().string();
+
+		if(aEntry.is_regular_file() && sName.size() > 11 && !sName.compare(sName.size() - 11, 11, ".games.json"))
+		{
+			vecSources.push_back(aEntry.path());
+		}
+	}
+
+	if(aError)
+	{
+		fprintf(stderr, "Failed to list \"%s\": %s\n", argv[1], aError.message().c_str());
+
+		return EXIT_FAILURE;
+	}
+
+	std::sort(vecSources.begin(), vecSources.end()); // Reproducible output.
+
+	Writer aWriter;
+
+	for(const auto &aPath : vecSources)
+	{
+		std::string sText, sError;
+
+		Value_t aRoot;
+
+		if(!ReadFile(aPath, sText) || !Parser(sText).Parse(aRoot, sError))
+		{
+			fprintf(stderr, "Failed to parse \"%s\": %s\n", aPath.string().c_str(), sError.empty() ? "read error" : sError.c_str());
+
+			return EXIT_FAILURE;
+		}
+
+		struct stat aStat;
+
+		if(stat(aPath.string().c_str(), &aStat))
+		{
+			fprintf(stderr, "Failed to stat \"%s\"\n", aPath.string().c_str());
+
+			return EXIT_FAILURE;
+		}
+
+		Writer::Strip(aRoot, pszPlatform);
+
+		Blob::Source_t aSource {};
+
+		aSource.m_nName = aWriter.Intern(aPath.filename().string());
+		aSource.m_nRoot = aWriter.AddTree(aRoot);
+
+		if(!aWriter.AddIndex(aRoot, pszPlatform, aSource))
+		{
+			printf("\"%s\" is out of the index, loaded by the tree\n", aPath.filename().string().c_str());
+		}
+		aSource.m_nSize = (uint64_t)sText.size();
+		aSource.m_nModificationTime = (int64_t)aStat.st_mtime;
+		aSource.m_nHash = Blob::Hash(sText.data(), sText.size());
+
+		aWriter.AddSource(aSource);
+	}
+
+	if(!aWriter.Write(argv[3], pszPlatform))
+	{
+		fprintf(stderr, "Failed to write \"%s\"\n", argv[3]);
+
+		return EXIT_FAILURE;
+	}
+
+	printf("Compiled %zu files to \"%s\"\n", vecSources.size(), argv[3]);
+
+	return EXIT_SUCCESS;
+}